@@ -13,37 +13,6 @@ void displayData(const std::vector <unsigned char> &data){
     std::cout << std::endl;
 }
 
-void crc16(DataFrame &frame, void *ptr) {
-    /* Get SynapSock object form function param */
-    SynapSock *tmp = (SynapSock *) ptr;
-    /* Initialize crc16 param */
-    unsigned short crc = 0x0000;
-    unsigned short poly = 0x1021;
-    /* Get data from Start Bytes until Data */
-    std::vector <unsigned char> data = tmp->getSpecificBufferAsVector(DataFrame::FRAME_TYPE_START_BYTES, DataFrame::FRAME_TYPE_DATA);
-    std::cout << "Data from which the CRC value will be calculated:" << std::endl;
-    displayData(data);
-    /* Calculate crc16 */
-    for (const auto &byte : data) {
-        crc ^= (static_cast<unsigned short>(byte) << 8);
-        for (int i = 0; i < 8; ++i) {
-            if (crc & 0x8000) {
-                crc = (crc << 1) ^ poly;
-            } else {
-                crc <<= 1;
-            }
-        }
-    }
-    /* Compare received CRC with calculated CRC */
-    unsigned short rcvCRC = 0;
-    frame.getData((unsigned char *) &rcvCRC, 2);
-    if (rcvCRC != crc){
-        /* invalid crc -> trigger stop flag to __readFramedData__ method */
-        tmp->trigInvDataIndicator();
-        std::cout << "CRC16 Invalid (0x" << std::hex << rcvCRC << " != 0x" << std::hex << crc << ")" << std::endl;
-    }
-}
-
 void crc16ForClientSide(DataFrame &frame, void *ptr){
 
 }
@@ -111,11 +80,11 @@ void socketSetupDataFrameProtocol(SynapSock &obj){
     cmdBytes.setPostExecuteFunction((const void *) &setupLengthByCommand, (void *) &obj);
     DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
     DataFrame crcValidatorBytes(DataFrame::FRAME_TYPE_VALIDATOR, 2);
-    /* Setup the handler function to validate Data by using crc16 validation.
-     * This function is called after all data from DataFrame::FRAME_TYPE_VALIDATOR is received.
-     */
-    crcValidatorBytes.setPostExecuteFunction((const void *) &crc16, (void *) &obj);
     DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
     /* Setup Frame Format to SynapSock com */
     obj = startBytes + cmdBytes + dataBytes + crcValidatorBytes + stopBytes;
+    /* Validate the frame with the built-in CRC16 (XMODEM, stored little-endian) from Start Bytes until Data.
+     * The CRC is computed while the fields are received, an invalid frame is rejected by __readFramedData__.
+     */
+    obj.setValidator(3, 0, 2, Checksum::CHECKSUM_CRC16_XMODEM, false);
 }
\ No newline at end of file
@@ -0,0 +1,96 @@
+/*
+ * $Id: buffer-pool.hpp,v 1.0.0 2026/10/18 09:12:40 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file
+ * @brief Pool of reusable output buffers.
+ *
+ * This file contains `BufferPool`, a thread-safe list of byte buffers that keep their capacity. A buffer is acquired as a
+ * `std::shared_ptr` and goes back to the pool when its last reference is released, so it can be handed to
+ * `Socket::sendData(std::shared_ptr <const std::vector <unsigned char>>)`, which keeps the buffer while the kernel still
+ * references it in zero-copy send mode.
+ *
+ * @version 1.0.0
+ * @date 2026-10-18
+ * @author Jaya Wikrama
+ */
+
+#ifndef __BUFFER_POOL_HPP__
+#define __BUFFER_POOL_HPP__
+
+#include <stddef.h>
+#include <memory>
+#include <vector>
+#include <pthread.h>
+
+class BufferPool {
+  public:
+    typedef std::shared_ptr <std::vector <unsigned char>> BUFFER_t;   /*!< buffer acquired from the pool */
+
+  private:
+    class Storage {
+      public:
+        pthread_mutex_t mtx;                                  /*!< protects the list of free buffers */
+        std::vector <std::vector <unsigned char> *> buffers;  /*!< free buffers */
+        size_t maxBuffers;                                    /*!< maximum number of free buffers kept by the pool */
+
+        Storage(size_t maxBuffers);
+        ~Storage();
+        Storage(const Storage &obj) = delete;
+        Storage& operator=(const Storage &obj) = delete;
+    };
+
+    std::shared_ptr <Storage> storage;    /*!< free buffers, shared with the buffers that are in use */
+
+  public:
+    /**
+     * @brief Default constructor, keeps up to 16 free buffers.
+     */
+    BufferPool();
+
+    /**
+     * @brief Custom constructor.
+     *
+     * @param[in] maxBuffers The maximum number of free buffers kept by the pool, the other released buffers are freed.
+     */
+    BufferPool(size_t maxBuffers);
+
+    /**
+     * @brief Acquires an empty buffer.
+     *
+     * The buffer keeps the capacity it had when it was released. It goes back to the pool when the last reference is released (from any thread),
+     * the pool may be destroyed before.
+     *
+     * @return the buffer.
+     */
+    BUFFER_t acquire();
+
+    /**
+     * @brief Gets the number of free buffers of the pool.
+     *
+     * @return the number of free buffers.
+     */
+    size_t getFreeCount();
+};
+
+#endif
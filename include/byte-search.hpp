@@ -0,0 +1,129 @@
+/*
+ * $Id: byte-search.hpp,v 1.0.0 2026/10/18 09:12:40 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file
+ * @brief Delimiter (byte pattern) search helpers.
+ *
+ * This file contains the byte pattern search used to detect start bytes and stop bytes in the
+ * received socket data. The search filters candidate positions by comparing the first and the last
+ * byte of the pattern over a whole vector register, and only verifies the remaining bytes on the
+ * candidates. The kernel (SSE2/AVX2 on x86, NEON on ARM or a portable scalar fallback) is selected
+ * once at runtime based on the CPU features. `ByteMatcher` wraps the search in a KMP automaton so a
+ * pattern that spans two reads is detected without re-scanning the data that has been received.
+ *
+ * @version 1.0.0
+ * @date 2026-10-18
+ * @author Jaya Wikrama
+ */
+
+#ifndef __BYTE_SEARCH_HPP__
+#define __BYTE_SEARCH_HPP__
+
+#include <stddef.h>
+#include <vector>
+
+class ByteSearch {
+  public:
+    static const size_t NOT_FOUND = static_cast<size_t>(-1);   /*!< value returned by `find` when the pattern is not found */
+
+    /**
+     * @brief Finds the first occurrence of a byte pattern in a buffer.
+     *
+     * This method searches the buffer for the first position where the whole pattern matches.
+     * An empty pattern always matches at offset 0.
+     *
+     * @param[in] buffer The buffer to be searched.
+     * @param[in] sz The size of the buffer.
+     * @param[in] pattern The byte pattern (delimiter) to be detected.
+     * @param[in] patternSz The size of the byte pattern.
+     * @return offset of the first match in the buffer.
+     * @return `ByteSearch::NOT_FOUND` if the pattern is not found.
+     */
+    static size_t find(const unsigned char *buffer, size_t sz, const unsigned char *pattern, size_t patternSz);
+
+    /**
+     * @brief Gets the name of the search kernel selected for the running CPU.
+     *
+     * @return `"avx2"`, `"sse2"`, `"neon"` or `"scalar"`.
+     */
+    static const char *getKernelName();
+};
+
+class ByteMatcher {
+  private:
+    std::vector <unsigned char> pattern;  /*!< byte pattern (delimiter) to be detected */
+    std::vector <size_t> failure;         /*!< KMP failure table of the pattern */
+    size_t state;                         /*!< number of pattern bytes matched by the tail of the data fed so far */
+
+    void step(unsigned char byte);
+
+  public:
+    /**
+     * @brief Default constructor.
+     *
+     * This constructor initializes the matcher with an empty pattern and zero partial-match state.
+     */
+    ByteMatcher();
+
+    /**
+     * @brief Sets the byte pattern to be detected.
+     *
+     * The partial-match state is only reset if the pattern differs from the current one, so the same
+     * pattern can be set before every receive operation without losing a match that spans two calls.
+     *
+     * @param[in] pattern The byte pattern (delimiter) to be detected.
+     * @param[in] sz The size of the byte pattern.
+     * @return `true` if the pattern has been changed (and the state reset).
+     * @return `false` if the pattern is the same as the current one.
+     */
+    bool setPattern(const unsigned char *pattern, size_t sz);
+
+    /**
+     * @brief Resets the partial-match state.
+     */
+    void reset();
+
+    /**
+     * @brief Gets the partial-match state.
+     *
+     * @return number of pattern bytes matched by the tail of the data fed so far.
+     */
+    size_t getState();
+
+    /**
+     * @brief Feeds a chunk of data into the matcher.
+     *
+     * The data is scanned starting from the partial-match state left by the previous chunk, so a pattern
+     * that spans two chunks is detected without re-scanning the previous chunk. The state is reset after
+     * a full match.
+     *
+     * @param[in] buffer The chunk of data.
+     * @param[in] sz The size of the chunk of data.
+     * @return number of bytes of the chunk consumed up to and including the end of the pattern.
+     * @return `ByteSearch::NOT_FOUND` if the pattern end is not in this chunk.
+     */
+    size_t feed(const unsigned char *buffer, size_t sz);
+};
+
+#endif
@@ -0,0 +1,172 @@
+/*
+ * $Id: checksum.hpp,v 1.0.0 2026/10/18 09:12:40 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file
+ * @brief Frame validation (checksum and CRC) kernels.
+ *
+ * This file contains the checksum algorithms used by the built-in frame validators. Every algorithm is
+ * incremental: the value returned for a chunk is passed back to process the next chunk, so a frame can be
+ * validated field by field while it is parsed. CRC16-CCITT and CRC32 use slice-by-8 tables, CRC32 and
+ * CRC32C use the carry-less multiply / SSE4.2 instructions on x86 or the ARMv8 CRC instructions when the
+ * CPU supports them. The kernel is selected once at runtime based on the CPU features.
+ *
+ * @version 1.0.0
+ * @date 2026-10-18
+ * @author Jaya Wikrama
+ */
+
+#ifndef __CHECKSUM_HPP__
+#define __CHECKSUM_HPP__
+
+#include <stddef.h>
+#include <stdint.h>
+
+class Checksum {
+  public:
+    typedef enum _ALGORITHM_t {             /*!< list of validation algorithms */
+      CHECKSUM_CRC16_CCITT_FALSE = 0,       /*!< CRC16, poly 0x1021, init 0xFFFF, not reflected (stored big-endian by default) */
+      CHECKSUM_CRC16_XMODEM,                /*!< CRC16, poly 0x1021, init 0x0000, not reflected (stored big-endian by default) */
+      CHECKSUM_CRC32,                       /*!< CRC32 (ISO-HDLC, as zlib/Ethernet), reflected poly 0xEDB88320 (stored little-endian by default) */
+      CHECKSUM_CRC32C,                      /*!< CRC32C (Castagnoli), reflected poly 0x82F63B78 (stored little-endian by default) */
+      CHECKSUM_SUM8,                        /*!< 8 bits sum of all bytes (modulo 256) */
+      CHECKSUM_XOR8                         /*!< 8 bits XOR of all bytes */
+    } ALGORITHM_t;
+
+    /**
+     * @brief Gets the initial value of an algorithm.
+     *
+     * @param[in] algorithm The validation algorithm.
+     * @return the value to be passed to the first `update` of a frame.
+     */
+    static uint32_t init(ALGORITHM_t algorithm);
+
+    /**
+     * @brief Updates a checksum with a chunk of data.
+     *
+     * @param[in] algorithm The validation algorithm.
+     * @param[in] value The value returned by `init` or by the previous `update`.
+     * @param[in] buffer The chunk of data.
+     * @param[in] sz The size of the chunk of data.
+     * @return the checksum of all the data processed so far.
+     */
+    static uint32_t update(ALGORITHM_t algorithm, uint32_t value, const unsigned char *buffer, size_t sz);
+
+    /**
+     * @brief Computes the checksum of a buffer.
+     *
+     * @param[in] algorithm The validation algorithm.
+     * @param[in] buffer The buffer.
+     * @param[in] sz The size of the buffer.
+     * @return the checksum of the buffer.
+     */
+    static uint32_t compute(ALGORITHM_t algorithm, const unsigned char *buffer, size_t sz);
+
+    /**
+     * @brief Gets the number of bytes of the checksum of an algorithm.
+     *
+     * @param[in] algorithm The validation algorithm.
+     * @return `1`, `2` or `4`.
+     */
+    static constexpr size_t getSize(ALGORITHM_t algorithm){
+        if (algorithm == Checksum::CHECKSUM_CRC16_CCITT_FALSE || algorithm == Checksum::CHECKSUM_CRC16_XMODEM) return 2;
+        if (algorithm == Checksum::CHECKSUM_CRC32 || algorithm == Checksum::CHECKSUM_CRC32C) return 4;
+        return 1;
+    }
+
+    /**
+     * @brief Gets the default byte order of the checksum of an algorithm in a frame.
+     *
+     * @param[in] algorithm The validation algorithm.
+     * @return `true` if the checksum is stored big-endian (CRC16), `false` if it is stored little-endian (CRC32, CRC32C).
+     */
+    static constexpr bool isBigEndian(ALGORITHM_t algorithm){
+        return (algorithm == Checksum::CHECKSUM_CRC16_CCITT_FALSE || algorithm == Checksum::CHECKSUM_CRC16_XMODEM);
+    }
+
+    /**
+     * @brief Updates a CRC16-CCITT (poly 0x1021, not reflected) with a chunk of data.
+     *
+     * @param[in] crc The initial value (`0xFFFF` for CCITT-FALSE, `0x0000` for XMODEM) or the value returned for the previous chunk.
+     * @param[in] buffer The chunk of data.
+     * @param[in] sz The size of the chunk of data.
+     * @return the CRC of all the data processed so far.
+     */
+    static uint16_t crc16Ccitt(uint16_t crc, const unsigned char *buffer, size_t sz);
+
+    /**
+     * @brief Updates a CRC32 (ISO-HDLC) with a chunk of data.
+     *
+     * @param[in] crc `0` for the first chunk, or the value returned for the previous chunk.
+     * @param[in] buffer The chunk of data.
+     * @param[in] sz The size of the chunk of data.
+     * @return the CRC of all the data processed so far.
+     */
+    static uint32_t crc32(uint32_t crc, const unsigned char *buffer, size_t sz);
+
+    /**
+     * @brief Updates a CRC32C (Castagnoli) with a chunk of data.
+     *
+     * @param[in] crc `0` for the first chunk, or the value returned for the previous chunk.
+     * @param[in] buffer The chunk of data.
+     * @param[in] sz The size of the chunk of data.
+     * @return the CRC of all the data processed so far.
+     */
+    static uint32_t crc32c(uint32_t crc, const unsigned char *buffer, size_t sz);
+
+    /**
+     * @brief Updates an 8 bits sum with a chunk of data.
+     *
+     * @param[in] sum `0` for the first chunk, or the value returned for the previous chunk.
+     * @param[in] buffer The chunk of data.
+     * @param[in] sz The size of the chunk of data.
+     * @return the sum (modulo 256) of all the data processed so far.
+     */
+    static uint8_t sum8(uint8_t sum, const unsigned char *buffer, size_t sz);
+
+    /**
+     * @brief Updates an 8 bits XOR with a chunk of data.
+     *
+     * @param[in] value `0` for the first chunk, or the value returned for the previous chunk.
+     * @param[in] buffer The chunk of data.
+     * @param[in] sz The size of the chunk of data.
+     * @return the XOR of all the data processed so far.
+     */
+    static uint8_t xor8(uint8_t value, const unsigned char *buffer, size_t sz);
+
+    /**
+     * @brief Gets the name of the CRC32 kernel selected for the running CPU.
+     *
+     * @return `"pclmul"`, `"armv8-crc"` or `"slice-by-8"`.
+     */
+    static const char *getCrc32KernelName();
+
+    /**
+     * @brief Gets the name of the CRC32C kernel selected for the running CPU.
+     *
+     * @return `"sse4.2"`, `"armv8-crc"` or `"slice-by-8"`.
+     */
+    static const char *getCrc32cKernelName();
+};
+
+#endif
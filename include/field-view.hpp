@@ -0,0 +1,214 @@
+/*
+ * $Id: field-view.hpp,v 1.0.0 2026/10/18 09:12:40 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file
+ * @brief Read-only view of a field of a received frame.
+ *
+ * This file contains `FieldView`, a pointer and a size into the receive buffer of a connection. It gives access to the
+ * bytes of a field without copying them, and reads integers with an explicit byte order (`u16be`, `u32le`, ...) without
+ * allocating. The accessors are defined in this header so they are inlined into the caller.
+ *
+ * @version 1.0.0
+ * @date 2026-10-18
+ * @author Jaya Wikrama
+ */
+
+#ifndef __FIELD_VIEW_HPP__
+#define __FIELD_VIEW_HPP__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <string_view>
+#include <vector>
+
+class FieldView {
+  private:
+    const unsigned char *data;            /*!< pointer to the first byte of the field */
+    size_t size;                          /*!< size of the field */
+
+    template <typename T>
+    T read(size_t offset, bool isBigEndian) const {
+        T value = 0;
+        if (offset > this->size || this->size - offset < sizeof(T)) return 0;
+        memcpy(&value, this->data + offset, sizeof(T));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        if (isBigEndian) value = FieldView::swap(value);
+#else
+        if (!isBigEndian) value = FieldView::swap(value);
+#endif
+        return value;
+    }
+
+    static uint16_t swap(uint16_t value){
+        return __builtin_bswap16(value);
+    }
+
+    static uint32_t swap(uint32_t value){
+        return __builtin_bswap32(value);
+    }
+
+    static uint64_t swap(uint64_t value){
+        return __builtin_bswap64(value);
+    }
+
+  public:
+    /**
+     * @brief Default constructor, creates an empty view.
+     */
+    FieldView() : data(nullptr), size(0) {}
+
+    /**
+     * @brief Creates a view of a buffer.
+     *
+     * @param[in] data Pointer to the first byte of the field.
+     * @param[in] size Size of the field.
+     */
+    FieldView(const unsigned char *data, size_t size) : data(data), size(size) {}
+
+    /**
+     * @brief Gets the pointer to the first byte of the field.
+     *
+     * @return pointer to the field (`nullptr` for an empty view).
+     */
+    const unsigned char *getData() const {
+        return this->data;
+    }
+
+    /**
+     * @brief Gets the size of the field.
+     *
+     * @return size of the field.
+     */
+    size_t getSize() const {
+        return this->size;
+    }
+
+    /**
+     * @brief Checks if the view is empty.
+     *
+     * @return `true` if the field has no bytes.
+     */
+    bool isEmpty() const {
+        return (this->size == 0);
+    }
+
+    /**
+     * @brief Gets a byte of the field. The offset must be lower than `getSize()`.
+     */
+    unsigned char operator[](size_t offset) const {
+        return this->data[offset];
+    }
+
+    /**
+     * @brief Gets a part of the field.
+     *
+     * @param[in] offset The offset of the part in the field.
+     * @param[in] sz The size of the part (it is truncated to the end of the field).
+     * @return view of the part.
+     */
+    FieldView sub(size_t offset, size_t sz) const {
+        if (offset > this->size) return FieldView();
+        return FieldView(this->data + offset, (sz < this->size - offset ? sz : this->size - offset));
+    }
+
+    /**
+     * @brief Gets the field as a string view (no copy).
+     */
+    std::string_view toStringView() const {
+        return std::string_view(reinterpret_cast<const char *>(this->data), this->size);
+    }
+
+    /**
+     * @brief Copies the field into a vector.
+     */
+    std::vector <unsigned char> toVector() const {
+        return std::vector <unsigned char>(this->data, this->data + this->size);
+    }
+
+    /**
+     * @brief Reads an unsigned 8 bits integer at an offset of the field.
+     *
+     * @return the value, or `0` if the field does not hold the integer at this offset.
+     */
+    uint8_t u8(size_t offset) const {
+        return (offset < this->size ? this->data[offset] : 0);
+    }
+
+    /**
+     * @brief Reads a big-endian unsigned 16 bits integer at an offset of the field.
+     *
+     * @return the value, or `0` if the field does not hold the integer at this offset.
+     */
+    uint16_t u16be(size_t offset) const {
+        return this->read <uint16_t>(offset, true);
+    }
+
+    /**
+     * @brief Reads a little-endian unsigned 16 bits integer at an offset of the field.
+     *
+     * @return the value, or `0` if the field does not hold the integer at this offset.
+     */
+    uint16_t u16le(size_t offset) const {
+        return this->read <uint16_t>(offset, false);
+    }
+
+    /**
+     * @brief Reads a big-endian unsigned 32 bits integer at an offset of the field.
+     *
+     * @return the value, or `0` if the field does not hold the integer at this offset.
+     */
+    uint32_t u32be(size_t offset) const {
+        return this->read <uint32_t>(offset, true);
+    }
+
+    /**
+     * @brief Reads a little-endian unsigned 32 bits integer at an offset of the field.
+     *
+     * @return the value, or `0` if the field does not hold the integer at this offset.
+     */
+    uint32_t u32le(size_t offset) const {
+        return this->read <uint32_t>(offset, false);
+    }
+
+    /**
+     * @brief Reads a big-endian unsigned 64 bits integer at an offset of the field.
+     *
+     * @return the value, or `0` if the field does not hold the integer at this offset.
+     */
+    uint64_t u64be(size_t offset) const {
+        return this->read <uint64_t>(offset, true);
+    }
+
+    /**
+     * @brief Reads a little-endian unsigned 64 bits integer at an offset of the field.
+     *
+     * @return the value, or `0` if the field does not hold the integer at this offset.
+     */
+    uint64_t u64le(size_t offset) const {
+        return this->read <uint64_t>(offset, false);
+    }
+};
+
+#endif
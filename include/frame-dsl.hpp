@@ -0,0 +1,479 @@
+/*
+ * $Id: frame-dsl.hpp,v 1.0.0 2026/10/18 09:12:40 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file
+ * @brief Compile-time frame format.
+ *
+ * This file contains a frame format that is declared as a type, for protocols that are fixed at build time:
+ *
+ * @code
+ * typedef FrameDsl::Frame <FrameDsl::StartBytes <'1', '2', '3', '4'>,
+ *                          FrameDsl::Length <SynapSock::LENGTH_ENCODING_UINT8>,
+ *                          FrameDsl::Data <FrameDsl::LenFrom <1>>,
+ *                          FrameDsl::Validator <Checksum::CHECKSUM_CRC16_XMODEM, 1, 2>,
+ *                          FrameDsl::StopBytes <'9', '0', '-', '='>> Packet;
+ * @endcode
+ *
+ * The delimiters and the field sizes are constants, and the parser and the encoder are generated for the format by the
+ * compiler: every field is parsed by its own inlined code, without walking a list of fields or checking the field type.
+ * `Frame::parse` has the signature of `SynapSock::FRAME_PARSER_t`, so the frames can be received with
+ * `receiveFramedDataBatch(frames, &Packet::parse)`. The fields are returned as views into the parsed buffer.
+ *
+ * @version 1.0.0
+ * @date 2026-10-18
+ * @author Jaya Wikrama
+ */
+
+#ifndef __FRAME_DSL_HPP__
+#define __FRAME_DSL_HPP__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "byte-search.hpp"
+#include "checksum.hpp"
+#include "synapsock.hpp"
+
+namespace FrameDsl {
+  static constexpr size_t VARIABLE = static_cast<size_t>(-1);  /*!< size of a field that is known only when the frame is parsed */
+
+  template <size_t N>
+  struct ParseContext {                   /*!< state of the frame that is being parsed */
+    const unsigned char *buffer;          /*!< the buffer that holds the frame */
+    size_t sz;                            /*!< the size of the buffer */
+    size_t pos;                           /*!< offset of the field to be parsed */
+    SynapSock::FRAME_VIEW_t field[N];     /*!< views of the parsed fields */
+    uint64_t length[N];                   /*!< decoded values of the parsed length fields */
+  };
+
+  template <size_t N>
+  struct EncodeContext {                  /*!< state of the frame that is being encoded */
+    std::vector <unsigned char> *buffer;  /*!< the buffer that holds the encoded frame */
+    const SynapSock::FRAME_VIEW_t *input; /*!< data of the fields */
+    size_t offset[N];                     /*!< offsets of the encoded fields in the buffer */
+  };
+
+  struct End {                            /*!< marks the end of the list of fields */
+    static constexpr bool IS_DELIMITER = false;
+  };
+
+  /**
+   * @brief Start or stop bytes.
+   */
+  template <char... C>
+  struct Delimiter {
+    static constexpr size_t SIZE = sizeof...(C);
+    static constexpr size_t MIN_SIZE = sizeof...(C);
+    static constexpr size_t LENGTH_SOURCE = VARIABLE;
+    static constexpr long ADJUSTMENT = 0;
+    static constexpr bool IS_DELIMITER = true;
+    static constexpr bool IS_LENGTH = false;
+    static constexpr unsigned char BYTES[sizeof...(C)] = {static_cast<unsigned char>(C)...};
+    static_assert(sizeof...(C) > 0, "a delimiter must have at least one byte");
+
+    template <size_t I, typename Next, typename Format, size_t N>
+    static int parse(ParseContext <N> &ctx){
+      if (ctx.sz - ctx.pos < SIZE) return 2;
+      if (memcmp(ctx.buffer + ctx.pos, BYTES, SIZE) != 0) return 4;
+      ctx.field[I] = {ctx.buffer + ctx.pos, SIZE};
+      ctx.pos += SIZE;
+      return 0;
+    }
+
+    template <size_t I, typename Format, size_t N>
+    static int encode(EncodeContext <N> &ctx){
+      ctx.offset[I] = ctx.buffer->size();
+      ctx.buffer->insert(ctx.buffer->end(), BYTES, BYTES + SIZE);
+      return 0;
+    }
+  };
+
+  template <char... C>
+  struct StartBytes : Delimiter <C...> {
+    static constexpr bool IS_START = true;
+  };
+
+  template <char... C>
+  struct StopBytes : Delimiter <C...> {
+    static constexpr bool IS_START = false;
+  };
+
+  /**
+   * @brief Field of a constant size.
+   */
+  template <size_t S>
+  struct FixedField {
+    static constexpr size_t SIZE = S;
+    static constexpr size_t MIN_SIZE = S;
+    static constexpr size_t LENGTH_SOURCE = VARIABLE;
+    static constexpr long ADJUSTMENT = 0;
+    static constexpr bool IS_DELIMITER = false;
+    static constexpr bool IS_LENGTH = false;
+    static constexpr bool IS_START = false;
+
+    template <size_t I, typename Next, typename Format, size_t N>
+    static int parse(ParseContext <N> &ctx){
+      if (ctx.sz - ctx.pos < S) return 2;
+      ctx.field[I] = {ctx.buffer + ctx.pos, S};
+      ctx.pos += S;
+      return 0;
+    }
+
+    template <size_t I, typename Format, size_t N>
+    static int encode(EncodeContext <N> &ctx){
+      if (ctx.input[I].size != S) return 1;
+      ctx.offset[I] = ctx.buffer->size();
+      ctx.buffer->insert(ctx.buffer->end(), ctx.input[I].data, ctx.input[I].data + S);
+      return 0;
+    }
+  };
+
+  template <size_t S>
+  struct Command : FixedField <S> {};
+
+  template <size_t S>
+  struct Fixed {};                        /*!< size of a data field: `S` bytes */
+
+  template <size_t L, long A = 0, size_t M = 0>
+  struct LenFrom {};                      /*!< size of a data field: the value of the length field `L` plus `A`, up to `M` bytes (`0` for no limit) */
+
+  struct UntilStop {};                    /*!< size of a data field: up to the stop bytes that follow it */
+
+  template <typename Spec>
+  struct Data;
+
+  template <size_t S>
+  struct Data <Fixed <S>> : FixedField <S> {};
+
+  template <size_t L, long A, size_t M>
+  struct Data <LenFrom <L, A, M>> {
+    static constexpr size_t SIZE = VARIABLE;
+    static constexpr size_t MIN_SIZE = 0;
+    static constexpr size_t LENGTH_SOURCE = L;
+    static constexpr long ADJUSTMENT = A;
+    static constexpr bool IS_DELIMITER = false;
+    static constexpr bool IS_LENGTH = false;
+    static constexpr bool IS_START = false;
+
+    template <size_t I, typename Next, typename Format, size_t N>
+    static int parse(ParseContext <N> &ctx){
+      static_assert(L < I, "the length field must come before the data field");
+      static_assert(Format::template isLength <L>(), "the size of the data field must come from a Length field");
+      long long size = static_cast<long long>(ctx.length[L]) + A;
+      if (size < 0 || (M > 0 && static_cast<unsigned long long>(size) > M)) return 4;
+      if (ctx.sz - ctx.pos < static_cast<size_t>(size)) return 2;
+      ctx.field[I] = {ctx.buffer + ctx.pos, static_cast<size_t>(size)};
+      ctx.pos += static_cast<size_t>(size);
+      return 0;
+    }
+
+    template <size_t I, typename Format, size_t N>
+    static int encode(EncodeContext <N> &ctx){
+      static_assert(Format::template isLength <L>(), "the size of the data field must come from a Length field");
+      if (M > 0 && ctx.input[I].size > M) return 1;
+      ctx.offset[I] = ctx.buffer->size();
+      ctx.buffer->insert(ctx.buffer->end(), ctx.input[I].data, ctx.input[I].data + ctx.input[I].size);
+      return 0;
+    }
+  };
+
+  template <>
+  struct Data <UntilStop> {
+    static constexpr size_t SIZE = VARIABLE;
+    static constexpr size_t MIN_SIZE = 0;
+    static constexpr size_t LENGTH_SOURCE = VARIABLE;
+    static constexpr long ADJUSTMENT = 0;
+    static constexpr bool IS_DELIMITER = false;
+    static constexpr bool IS_LENGTH = false;
+    static constexpr bool IS_START = false;
+
+    template <size_t I, typename Next, typename Format, size_t N>
+    static int parse(ParseContext <N> &ctx){
+      static_assert(Next::IS_DELIMITER, "a data field without size must be followed by stop bytes");
+      size_t idx = ByteSearch::find(ctx.buffer + ctx.pos, ctx.sz - ctx.pos, Next::BYTES, Next::SIZE);
+      if (idx == ByteSearch::NOT_FOUND) return 2;
+      ctx.field[I] = {ctx.buffer + ctx.pos, idx};
+      ctx.pos += idx;
+      return 0;
+    }
+
+    template <size_t I, typename Format, size_t N>
+    static int encode(EncodeContext <N> &ctx){
+      ctx.offset[I] = ctx.buffer->size();
+      ctx.buffer->insert(ctx.buffer->end(), ctx.input[I].data, ctx.input[I].data + ctx.input[I].size);
+      return 0;
+    }
+  };
+
+  /**
+   * @brief Length field that sets the size of a `Data <LenFrom <...>>` field.
+   */
+  template <SynapSock::LENGTH_ENCODING_t E>
+  struct Length {
+    static constexpr size_t WIDTH = (E == SynapSock::LENGTH_ENCODING_UINT8 ? 1 :
+                                     E <= SynapSock::LENGTH_ENCODING_UINT16_LE ? 2 :
+                                     E <= SynapSock::LENGTH_ENCODING_UINT32_LE ? 4 :
+                                     E <= SynapSock::LENGTH_ENCODING_UINT64_LE ? 8 : 0);
+    static constexpr bool IS_BIG_ENDIAN = (E == SynapSock::LENGTH_ENCODING_UINT16_BE || E == SynapSock::LENGTH_ENCODING_UINT32_BE ||
+                                           E == SynapSock::LENGTH_ENCODING_UINT64_BE);
+    static constexpr size_t SIZE = (WIDTH > 0 ? WIDTH : VARIABLE);
+    static constexpr size_t MIN_SIZE = (WIDTH > 0 ? WIDTH : 1);
+    static constexpr size_t LENGTH_SOURCE = VARIABLE;
+    static constexpr long ADJUSTMENT = 0;
+    static constexpr bool IS_DELIMITER = false;
+    static constexpr bool IS_LENGTH = true;
+    static constexpr bool IS_START = false;
+
+    template <size_t I, typename Next, typename Format, size_t N>
+    static int parse(ParseContext <N> &ctx){
+      const unsigned char *buffer = ctx.buffer + ctx.pos;
+      size_t avail = ctx.sz - ctx.pos;
+      uint64_t value = 0;
+      size_t width = WIDTH;
+      if constexpr (WIDTH > 0){
+        if (avail < WIDTH) return 2;
+        for (size_t i = 0; i < WIDTH; i++){
+          value = (value << 8) | buffer[IS_BIG_ENDIAN ? i : WIDTH - 1 - i];
+        }
+      }
+      else {
+        for (width = 0; ; width++){
+          if (width >= avail) return 2;
+          /* the 10th byte may only hold the most significant bit of a 64 bits value */
+          if (width == 9 && buffer[width] > 0x01) return 4;
+          value |= static_cast<uint64_t>(buffer[width] & 0x7F) << (7 * width);
+          if ((buffer[width] & 0x80) == 0) break;
+        }
+        width++;
+      }
+      ctx.length[I] = value;
+      ctx.field[I] = {buffer, width};
+      ctx.pos += width;
+      return 0;
+    }
+
+    template <size_t I, typename Format, size_t N>
+    static int encode(EncodeContext <N> &ctx){
+      constexpr size_t target = Format::template lengthTarget <I>();
+      static_assert(target != VARIABLE, "the length field is not used by a data field");
+      long long size = static_cast<long long>(ctx.input[target].size) - Format::template adjustment <target>();
+      if (size < 0) return 1;
+      uint64_t value = static_cast<uint64_t>(size);
+      ctx.offset[I] = ctx.buffer->size();
+      if constexpr (WIDTH > 0){
+        if (WIDTH < 8 && (value >> (8 * WIDTH)) != 0) return 1;
+        for (size_t i = 0; i < WIDTH; i++){
+          ctx.buffer->push_back(static_cast<unsigned char>(value >> (8 * (IS_BIG_ENDIAN ? WIDTH - 1 - i : i))));
+        }
+      }
+      else {
+        do {
+          ctx.buffer->push_back(static_cast<unsigned char>((value & 0x7F) | (value > 0x7F ? 0x80 : 0x00)));
+          value >>= 7;
+        } while (value > 0);
+      }
+      return 0;
+    }
+  };
+
+  /**
+   * @brief Checksum field over the fields `B` to `E`.
+   */
+  template <Checksum::ALGORITHM_t A, size_t B, size_t E>
+  struct Validator {
+    static constexpr size_t SIZE = Checksum::getSize(A);
+    static constexpr bool IS_BIG_ENDIAN = Checksum::isBigEndian(A);
+    static constexpr size_t MIN_SIZE = SIZE;
+    static constexpr size_t LENGTH_SOURCE = VARIABLE;
+    static constexpr long ADJUSTMENT = 0;
+    static constexpr bool IS_DELIMITER = false;
+    static constexpr bool IS_LENGTH = false;
+    static constexpr bool IS_START = false;
+
+    template <size_t I, typename Next, typename Format, size_t N>
+    static int parse(ParseContext <N> &ctx){
+      static_assert(B <= E && E < I, "the checksum field must come after the fields it covers");
+      if (ctx.sz - ctx.pos < SIZE) return 2;
+      const unsigned char *begin = ctx.field[B].data;
+      uint32_t crc = Checksum::compute(A, begin, static_cast<size_t>(ctx.field[E].data + ctx.field[E].size - begin));
+      uint32_t value = 0;
+      for (size_t i = 0; i < SIZE; i++){
+        value = (value << 8) | ctx.buffer[ctx.pos + (IS_BIG_ENDIAN ? i : SIZE - 1 - i)];
+      }
+      if (value != crc) return 4;
+      ctx.field[I] = {ctx.buffer + ctx.pos, SIZE};
+      ctx.pos += SIZE;
+      return 0;
+    }
+
+    template <size_t I, typename Format, size_t N>
+    static int encode(EncodeContext <N> &ctx){
+      size_t begin = ctx.offset[B];
+      size_t end = (E + 1 < I ? ctx.offset[E + 1] : ctx.buffer->size());
+      uint32_t crc = Checksum::compute(A, ctx.buffer->data() + begin, end - begin);
+      ctx.offset[I] = ctx.buffer->size();
+      for (size_t i = 0; i < SIZE; i++){
+        ctx.buffer->push_back(static_cast<unsigned char>(crc >> (8 * (IS_BIG_ENDIAN ? SIZE - 1 - i : i))));
+      }
+      return 0;
+    }
+  };
+
+  /**
+   * @brief Frame format declared as a list of fields.
+   */
+  template <typename... Fields>
+  class Frame {
+    public:
+      static constexpr size_t FIELD_COUNT = sizeof...(Fields);   /*!< number of fields of the frame */
+      static constexpr size_t MIN_SIZE = (Fields::MIN_SIZE + ... + 0);   /*!< minimum size of a frame */
+      static constexpr bool IS_FIXED_SIZE = ((Fields::SIZE != VARIABLE) && ...);   /*!< `true` if every field has a constant size */
+
+    private:
+      typedef std::tuple <Fields..., End> FIELDS_t;
+
+      template <size_t I>
+      using FieldAt = typename std::tuple_element <I, FIELDS_t>::type;
+
+      template <size_t... I>
+      static int parseFields(ParseContext <FIELD_COUNT> &ctx, std::index_sequence <I...>){
+        int ret = 0;
+        (((ret = FieldAt <I>::template parse <I, FieldAt <I + 1>, Frame>(ctx)) == 0) && ...);
+        return ret;
+      }
+
+      template <size_t... I>
+      static int encodeFields(EncodeContext <FIELD_COUNT> &ctx, std::index_sequence <I...>){
+        int ret = 0;
+        (((ret = FieldAt <I>::template encode <I, Frame>(ctx)) == 0) && ...);
+        return ret;
+      }
+
+    public:
+      static_assert(sizeof...(Fields) > 0, "a frame must have at least one field");
+
+      /**
+       * @brief Gets the index of the data field sized by a length field.
+       *
+       * @return the index of the data field, or `FrameDsl::VARIABLE` if no data field uses the length field.
+       */
+      template <size_t L>
+      static constexpr size_t lengthTarget(){
+        constexpr size_t sources[] = {Fields::LENGTH_SOURCE...};
+        for (size_t i = 0; i < FIELD_COUNT; i++){
+          if (sources[i] == L) return i;
+        }
+        return VARIABLE;
+      }
+
+      /**
+       * @brief Checks if a field is a length field.
+       */
+      template <size_t I>
+      static constexpr bool isLength(){
+        return FieldAt <I>::IS_LENGTH;
+      }
+
+      /**
+       * @brief Gets the adjustment of the size of a data field sized by a length field.
+       */
+      template <size_t I>
+      static constexpr long adjustment(){
+        return FieldAt <I>::ADJUSTMENT;
+      }
+
+      /**
+       * @brief Parses the first frame of a buffer.
+       *
+       * @param[in] buffer The buffer that holds the received data.
+       * @param[in] sz The size of the buffer.
+       * @param[out] begin The offset of the frame (the data before it can be discarded, also when `2` is returned).
+       * @param[out] size The size of the frame.
+       * @param[out] fields The views of the fields of the frame (into `buffer`).
+       * @return `0` if a complete frame has been parsed.
+       * @return `2` if the buffer does not hold a complete frame yet.
+       * @return `4` if the frame at `begin` is invalid.
+       */
+      static int parse(const unsigned char *buffer, size_t sz, size_t *begin, size_t *size, SynapSock::FRAME_VIEW_t (&fields)[FIELD_COUNT]){
+        typedef FieldAt <0> First;
+        ParseContext <FIELD_COUNT> ctx;
+        int ret = 0;
+        ctx.buffer = buffer;
+        ctx.sz = sz;
+        ctx.pos = 0;
+        if constexpr (First::IS_START){
+          size_t idx = ByteSearch::find(buffer, sz, First::BYTES, First::SIZE);
+          if (idx == ByteSearch::NOT_FOUND){
+            /* only the tail may hold the beginning of the start bytes */
+            *begin = (sz >= First::SIZE ? sz - (First::SIZE - 1) : 0);
+            return 2;
+          }
+          ctx.pos = idx;
+        }
+        *begin = ctx.pos;
+        if (sz - ctx.pos < MIN_SIZE) return 2;
+        ret = parseFields(ctx, std::make_index_sequence <FIELD_COUNT>());
+        if (ret != 0) return ret;
+        *size = ctx.pos - *begin;
+        for (size_t i = 0; i < FIELD_COUNT; i++) fields[i] = ctx.field[i];
+        return 0;
+      }
+
+      /**
+       * @brief Overloaded method of `parse` without the views of the fields (`SynapSock::FRAME_PARSER_t`).
+       */
+      static int parse(const unsigned char *buffer, size_t sz, size_t *begin, size_t *size){
+        SynapSock::FRAME_VIEW_t fields[FIELD_COUNT];
+        return parse(buffer, sz, begin, size, fields);
+      }
+
+      /**
+       * @brief Encodes a frame.
+       *
+       * The delimiters, length fields and checksum fields are generated, their entries in `fields` are ignored.
+       *
+       * @param[out] buffer A variable that holds the encoded frame.
+       * @param[in] fields The data of the fields.
+       * @return `0` on success.
+       * @return `1` if the size of a field does not match the frame format.
+       */
+      static int encode(std::vector <unsigned char> &buffer, const SynapSock::FRAME_VIEW_t (&fields)[FIELD_COUNT]){
+        EncodeContext <FIELD_COUNT> ctx;
+        int ret = 0;
+        buffer.clear();
+        if constexpr (IS_FIXED_SIZE) buffer.reserve(MIN_SIZE);
+        ctx.buffer = &buffer;
+        ctx.input = fields;
+        ret = encodeFields(ctx, std::make_index_sequence <FIELD_COUNT>());
+        if (ret != 0) buffer.clear();
+        return ret;
+      }
+  };
+}
+
+#endif
@@ -0,0 +1,173 @@
+/*
+ * $Id: inplace-function.hpp,v 1.0.0 2026/10/18 09:12:40 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/**
+ * @file
+ * @brief Non-allocating callable wrapper for handlers and hooks.
+ *
+ * This file contains `InplaceFunction`, a type-erased callable with a fixed inline storage. It accepts function
+ * pointers, lambdas (with captures), `std::function` and any other copyable callable that fits the storage, and
+ * never allocates: a callable that is too large is rejected at compile time. Calling it costs one indirect call
+ * to a small invoker that is instantiated for the stored callable type, so the body of the callable can be
+ * inlined into the invoker by the compiler.
+ *
+ * @version 1.0.0
+ * @date 2026-10-18
+ * @author Jaya Wikrama
+ */
+
+#ifndef __INPLACE_FUNCTION_HPP__
+#define __INPLACE_FUNCTION_HPP__
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename Signature, size_t Capacity = 48>
+class InplaceFunction;
+
+template <typename R, typename... Args, size_t Capacity>
+class InplaceFunction <R(Args...), Capacity> {
+  private:
+    typedef enum _MANAGE_OP_t {             /*!< list of storage operations of the stored callable */
+      MANAGE_OP_COPY = 0,                   /*!< copy construct the callable of `src` into `dst` */
+      MANAGE_OP_DESTROY                     /*!< destroy the callable of `dst` */
+    } MANAGE_OP_t;
+
+    typedef R (*INVOKE_t)(void *, Args...);
+    typedef void (*MANAGE_t)(void *, const void *, MANAGE_OP_t);
+
+    alignas(alignof(std::max_align_t)) unsigned char storage[Capacity];   /*!< inline storage of the callable */
+    INVOKE_t invoker;                       /*!< calls the stored callable (`nullptr` if empty) */
+    MANAGE_t manager;                       /*!< copies or destroys the stored callable */
+
+    template <typename Callable>
+    static R invoke(void *obj, Args... args){
+        return (*static_cast<Callable *>(obj))(std::forward<Args>(args)...);
+    }
+
+    template <typename Callable>
+    static void manage(void *dst, const void *src, MANAGE_OP_t op){
+        if (op == MANAGE_OP_COPY){
+            ::new (dst) Callable(*static_cast<const Callable *>(src));
+        }
+        else {
+            static_cast<Callable *>(dst)->~Callable();
+        }
+    }
+
+    void copyFrom(const InplaceFunction &obj){
+        this->invoker = obj.invoker;
+        this->manager = obj.manager;
+        if (this->manager != nullptr) this->manager(this->storage, obj.storage, MANAGE_OP_COPY);
+    }
+
+  public:
+    /**
+     * @brief Default constructor, creates an empty callable.
+     */
+    InplaceFunction() : invoker(nullptr), manager(nullptr) {}
+
+    /**
+     * @brief Creates an empty callable.
+     */
+    InplaceFunction(std::nullptr_t) : invoker(nullptr), manager(nullptr) {}
+
+    /**
+     * @brief Stores a callable.
+     *
+     * Only callables that can be called with `Args...` and return a value convertible to `R` are accepted. An empty
+     * function pointer gives an empty callable.
+     *
+     * @param[in] func The callable (function pointer, lambda, `std::function` or function object).
+     */
+    template <typename Callable, typename Type = typename std::decay<Callable>::type,
+              typename = typename std::enable_if<!std::is_same<Type, InplaceFunction>::value &&
+                                                 std::is_invocable_r<R, Type &, Args...>::value>::type>
+    InplaceFunction(Callable &&func) : invoker(nullptr), manager(nullptr) {
+        static_assert(sizeof(Type) <= Capacity, "the callable does not fit the inline storage of InplaceFunction");
+        static_assert(alignof(Type) <= alignof(std::max_align_t), "the callable is over-aligned for InplaceFunction");
+        static_assert(std::is_copy_constructible<Type>::value, "the callable must be copy constructible");
+        if constexpr (std::is_pointer<Type>::value || std::is_member_pointer<Type>::value){
+            if (func == nullptr) return;
+        }
+        ::new (this->storage) Type(std::forward<Callable>(func));
+        this->invoker = &InplaceFunction::invoke<Type>;
+        this->manager = &InplaceFunction::manage<Type>;
+    }
+
+    /**
+     * @brief Copy constructor.
+     */
+    InplaceFunction(const InplaceFunction &obj){
+        this->copyFrom(obj);
+    }
+
+    /**
+     * @brief Destructor, destroys the stored callable.
+     */
+    ~InplaceFunction(){
+        this->reset();
+    }
+
+    InplaceFunction& operator=(const InplaceFunction &obj){
+        if (this != &obj){
+            this->reset();
+            this->copyFrom(obj);
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(std::nullptr_t){
+        this->reset();
+        return *this;
+    }
+
+    /**
+     * @brief Destroys the stored callable, the callable becomes empty.
+     */
+    void reset(){
+        if (this->manager != nullptr) this->manager(this->storage, nullptr, MANAGE_OP_DESTROY);
+        this->invoker = nullptr;
+        this->manager = nullptr;
+    }
+
+    /**
+     * @brief Checks if a callable is stored.
+     *
+     * @return `true` if a callable is stored.
+     */
+    explicit operator bool() const {
+        return (this->invoker != nullptr);
+    }
+
+    /**
+     * @brief Calls the stored callable. The callable must not be empty.
+     */
+    R operator()(Args... args) const {
+        return this->invoker(const_cast<unsigned char *>(this->storage), std::forward<Args>(args)...);
+    }
+};
+
+#endif
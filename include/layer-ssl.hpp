@@ -85,7 +85,7 @@ class SSLWarper {
      * @param cert A string containing the server's certificate in PEM format.
      * @param key A string containing the server's private key in PEM format.
      */
-    void loadCertificates(const std::string cert, const std::string key);
+    void loadCertificates(const std::string &cert, const std::string &key);
 
   public:
     typedef enum _CONTEXT_TYPE_t {
@@ -103,7 +103,7 @@ class SSLWarper {
      * @param cert Optional string containing the server's certificate in PEM format. Only used for server.
      * @param key Optional string containing the server's private key in PEM format. Only used for server.
      */
-    SSLWarper(SSLWarper::CONTEXT_TYPE_t type, const std::string cert, const std::string key);
+    SSLWarper(SSLWarper::CONTEXT_TYPE_t type, const std::string &cert, const std::string &key);
 
     /**
      * @brief Destructor for SSLWrapper.
@@ -47,19 +47,30 @@
 #ifndef __SOCKET_BASIC_HPP__
 #define __SOCKET_BASIC_HPP__
 
+#include <stdint.h>
 #include <string>
+#include <string_view>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
 #include <vector>
+#include <deque>
+#include <memory>
+#include <atomic>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <sys/time.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <sys/select.h>
+#include <sys/uio.h>
 #include <sys/ioctl.h>
 #include <fcntl.h>
 #include <errno.h>
 #include <arpa/inet.h>
 #include <pthread.h>
+#include "byte-search.hpp"
 #ifdef __STCP_SSL__
 #include "layer-ssl.hpp"
 #endif
@@ -80,6 +91,237 @@ class Socket {
     pthread_mutex_t wmtx;                 /*!< locking mechanism for write method */
     std::vector <unsigned char> data;           /*!< variable that store received data */
     std::vector <unsigned char> remainingData;  /*!< variable that store remaining data */
+    size_t remainingOffset;                     /*!< number of bytes at the beginning of the remaining buffer that have already been delivered */
+    std::vector <unsigned char> stopBytesPending; /*!< data received by `receiveUntillStopBytes` while the stop bytes have not been found */
+    ByteMatcher stopBytesMatcher;               /*!< stop bytes matcher that keeps the partial-match state between reads and calls */
+    std::vector <unsigned char> lineBuffer;     /*!< buffer referenced by the lines returned by `receiveLines` */
+    size_t lineMaxLength;                       /*!< maximum length of a line received by `receiveLines` (`0` means unlimited) */
+    bool isLineDiscarding;                      /*!< indicator that the rest of an over-long line is being discarded */
+    size_t maxFrameSize;                        /*!< maximum size of the data accumulated while searching the stop bytes (`0` means unlimited) */
+    size_t receiveBufferLimit;                  /*!< maximum number of bytes held in the receive buffers of this connection (`0` means unlimited) */
+    size_t receiveUsage;                        /*!< number of buffered bytes of this connection accounted in the global receive usage */
+    static std::atomic <size_t> globalReceiveBudget;  /*!< maximum number of bytes buffered by all connections (`0` means unlimited) */
+    static std::atomic <size_t> globalReceiveUsage;   /*!< number of bytes buffered by all connections */
+    std::deque <std::vector <unsigned char>> outputQueue;  /*!< data waiting for the socket to become writable */
+    size_t outputQueueOffset;                   /*!< number of bytes of the first queued chunk that have been sent */
+    size_t outputQueueSize;                     /*!< number of queued bytes that have not been sent */
+    bool isNonBlockingSend;                     /*!< `true` if the output queue is flushed by an event loop instead of waiting inside `sendData` */
+    bool isNoDelay;                             /*!< `true` if the Nagle algorithm is disabled (`TCP_NODELAY`) */
+    bool isCorked;                              /*!< `true` if sent data is coalesced in the cork buffer until it is flushed */
+    size_t corkMaxSize;                         /*!< size of the cork buffer that triggers an automatic flush */
+    unsigned int corkDeadlineMs;                /*!< maximum time the data stays in the cork buffer (`0` means no deadline) */
+    struct timeval corkSince;                   /*!< time when the first byte was put into the empty cork buffer */
+    std::vector <unsigned char> corkBuffer;     /*!< data coalesced by the corked send mode */
+    bool isZeroCopy;                            /*!< `true` if large buffers are sent with `MSG_ZEROCOPY` */
+    size_t zeroCopyThreshold;                   /*!< minimum buffer size that is sent with `MSG_ZEROCOPY` */
+    uint32_t zeroCopySeq;                       /*!< sequence number the kernel assigns to the next `MSG_ZEROCOPY` send call */
+    size_t zeroCopyPendingSize;                 /*!< number of bytes of the buffers that are still referenced by the kernel */
+    size_t writeHighWatermark;                  /*!< size of the output queue that triggers the write blocked handler (`0` means disabled) */
+    size_t writeLowWatermark;                   /*!< size of the output queue that triggers the write drained handler after a write blocked event */
+    bool isWriteBlocked;                        /*!< `true` between a write blocked event and the next write drained event */
+    std::deque <unsigned char> pendingWriteEvents;  /*!< write events waiting to be dispatched after `wmtx` is released, in order (`1` blocked, `2` drained, `3` queued) */
+    const void *writeBlockedCallbackFunction;   /*!< callback function that is called when the output queue reaches the high watermark */
+    void *writeBlockedCallbackParam;            /*!< parameters of the write blocked callback function */
+    const void *writeDrainedCallbackFunction;   /*!< callback function that is called when the output queue drops to the low watermark */
+    void *writeDrainedCallbackParam;            /*!< parameters of the write drained callback function */
+    const void *outputQueuedCallbackFunction;   /*!< callback function that is called when data is queued in the empty output queue */
+    void *outputQueuedCallbackParam;            /*!< parameters of the output queued callback function */
+    std::deque <std::pair <uint32_t, std::shared_ptr <const std::vector <unsigned char>>>> zeroCopyPending;  /*!< buffers referenced by the kernel, with the sequence number of their last send call */
+
+    /**
+     * @brief Updates the global receive usage with the buffered data of this connection.
+     *
+     * The buffered data is the data that has been read from the socket but not delivered yet (the remaining data and the pending stop bytes search data),
+     * and the line buffer that holds the lines returned by `receiveLines` until the next receive operation.
+     */
+    void updateReceiveUsage();
+
+    /**
+     * @brief Drops the data at the beginning of the remaining buffer that has already been delivered.
+     *
+     * A receive method may deliver the remaining data in place by advancing `remainingOffset` instead of erasing it. The delivered data is removed
+     * once, before the remaining buffer is used by another receive operation.
+     */
+    void compactRemainingData();
+
+    /**
+     * @brief Gets the number of bytes that may still be read from the socket.
+     *
+     * The allowance is limited by the per-connection receive buffer limit and by the global receive budget. When it reaches zero the reading is paused,
+     * the data stays in the kernel socket buffer and TCP flow control pushes back on the peer.
+     *
+     * @param[in] held The number of bytes currently held by this connection.
+     * @return The number of bytes that may be read (`SIZE_MAX` if unlimited).
+     */
+    size_t getReceiveAllowance(size_t held);
+
+    /**
+     * @brief Reads all the Socket data that is currently available.
+     *
+     * This method waits (up to the timeout) until the socket is readable and appends all the available data to the buffer with a single read operation.
+     *
+     * @param[out] buffer A variable to which the received data is appended.
+     * @return `0` if the operation is successful.
+     * @return `1` if the port is not open.
+     * @return `2` if a timeout occurs.
+     */
+    int readAvailableData(std::vector <unsigned char> &buffer);
+
+    /**
+     * @brief Overloaded method of `readAvailableData` that can return immediately.
+     *
+     * @param[out] buffer A variable to which the received data is appended.
+     * @param[in] isWait `true` to wait (up to the timeout) until the socket is readable, `false` to only read the data that has already arrived.
+     * @return `0` if the operation is successful.
+     * @return `1` if the port is not open.
+     * @return `2` if a timeout occurs or no data is available.
+     */
+    int readAvailableData(std::vector <unsigned char> &buffer, bool isWait);
+
+    /**
+     * @brief Stores partially received data as the received data buffer.
+     *
+     * @param[in] buffer The partially received data (it may point to the received data buffer itself).
+     * @param[in] sz The size of the partially received data.
+     */
+    void setPartialData(const unsigned char *buffer, size_t sz);
+
+    /**
+     * @brief Writes the queued output data without blocking (the caller must hold `wmtx`).
+     *
+     * @return `0` if the output queue is empty.
+     * @return `2` if the data write operation fails.
+     * @return `3` if data is still queued because the socket send buffer is full.
+     */
+    int writeOutputQueue();
+
+    /**
+     * @brief Queues data behind the output queue, or writes it directly if the queue is empty (the caller must hold `wmtx`).
+     *
+     * @param[in] buffer Data to be written.
+     * @param[in] sz Size of the data to be written.
+     * @return `0` if the data has been written.
+     * @return `2` if the data write operation fails.
+     * @return `3` if (a part of) the data has been queued.
+     */
+    int writeOrQueue(const unsigned char *buffer, size_t sz);
+
+    /**
+     * @brief Overloaded method of `writeOrQueue` with input as a list of buffers (the caller must hold `wmtx`).
+     *
+     * The buffers are written with a single `sendmsg` call (per batch of buffers) and the part that cannot be written is queued as one chunk.
+     *
+     * @param[in] iov List of buffers to be written in order.
+     * @param[in] iovcnt Number of buffers in the list.
+     * @return `0` if the data has been written.
+     * @return `2` if the data write operation fails.
+     * @return `3` if (a part of) the data has been queued.
+     */
+    int writeOrQueue(const struct iovec *iov, int iovcnt);
+
+    /**
+     * @brief Overloaded method of `writeOrQueue` that takes the ownership of the data (the caller must hold `wmtx`).
+     *
+     * The part that cannot be written is queued by moving the vector into the output queue, so the data is not copied.
+     *
+     * @param[in] buffer Data to be written.
+     * @return `0` if the data has been written.
+     * @return `2` if the data write operation fails.
+     * @return `3` if (a part of) the data has been queued.
+     */
+    int writeOrQueue(std::vector <unsigned char> &&buffer);
+
+#ifdef __STCP_SSL__
+    /**
+     * @brief Writes data to the SSL connection, blocking until all data has been written (the caller must hold `wmtx`).
+     *
+     * @param[in] buffer Data to be written.
+     * @param[in] sz Size of the data to be written.
+     * @return `0` if the operation is successful.
+     * @return `2` if the data write operation fails.
+     */
+    int writeSSL(const unsigned char *buffer, size_t sz);
+#endif
+
+    /**
+     * @brief Waits (up to the timeout) until the output queue has been written (the caller must hold `wmtx`).
+     *
+     * @return `0` if the output queue is empty.
+     * @return `2` if the data write operation fails or a timeout occurs (the data that has not been written stays queued).
+     */
+    int waitOutputQueue();
+
+    /**
+     * @brief Checks the output queue size against the watermarks and queues the event to be dispatched (the caller must hold `wmtx`).
+     */
+    void updateWriteWatermark();
+
+    /**
+     * @brief Calls the write blocked, write drained or output queued handler for every queued write event, in the order of the events (the caller must not hold `wmtx`).
+     */
+    void dispatchWriteWatermark();
+
+    /**
+     * @brief Writes the data coalesced in the cork buffer (the caller must hold `wmtx`).
+     *
+     * The data is written the same way as `sendData` does (including waiting for the output queue in the default send mode).
+     *
+     * @return `0` if the operation is successful.
+     * @return `2` if the data write operation fails, or if it has to be tried again (the data that has not been written or queued stays in the
+     * cork buffer and is written by the next flush).
+     */
+    int writeCorkBuffer();
+
+    /**
+     * @brief Overloaded method of `sendData` with input as a list of buffers that reports whether the connection still holds the data.
+     *
+     * When the write operation fails, the data of this call may already be held by the output queue or the cork buffer (it is written later)
+     * or it may have been discarded. `isQueued` tells the two cases apart, the size of the output queue does not (it may only hold older data).
+     *
+     * @param[in] iov List of buffers to be written in order.
+     * @param[in] iovcnt Number of buffers in the list.
+     * @param[out] isQueued A variable that is set to `true` if (a part of) the data is held by the output queue or the cork buffer (may be `nullptr`).
+     * @return `0` if the operation is successful.
+     * @return `1` if the port is not open.
+     * @return `2` if the data write operation fails.
+     */
+    int sendData(const struct iovec *iov, int iovcnt, bool *isQueued);
+
+    /**
+     * @brief Flushes the cork buffer before a receive operation waits for the peer (the caller must not hold `mtx` or `wmtx`).
+     *
+     * The peer usually waits for the corked data (for example a request) before it answers, so the data is not left in the cork buffer until the deadline.
+     */
+    void flushCorkBeforeWait();
+
+    /**
+     * @brief Applies the `TCP_NODELAY` and `SO_ZEROCOPY` options to the socket (the caller must hold `wmtx`).
+     */
+    void applySocketOptions();
+
+    /**
+     * @brief Waits (up to the given time) until the socket is readable (the caller must hold `mtx`).
+     *
+     * A zero-copy completion on the socket error queue also wakes up `select`. Those wake-ups are consumed here and the wait goes on with the
+     * remaining time.
+     *
+     * @param[out] readfds The set of file descriptors filled by `select`.
+     * @param[in,out] tvTmout The maximum waiting time, updated to the remaining time.
+     * @return The return value of `select`.
+     */
+    int waitReadable(fd_set *readfds, struct timeval *tvTmout);
+
+    /**
+     * @brief Reads the `MSG_ZEROCOPY` completion notifications from the socket error queue and releases the completed buffers (the caller must hold `wmtx`).
+     *
+     * @return The number of completion notifications that have been read.
+     */
+    int readZeroCopyCompletions();
+
+    /**
+     * @brief Moves the data kept pending by `receiveUntillStopBytes` into the buffer and resets the partial-match state.
+     */
+    void takeStopBytesPending();
 
   public:
     /**
@@ -128,7 +370,7 @@ class Socket {
      * - Initializes the mutex for thread safety.
      * @param[in] address The address is in the form of an IP address with a size of 4 bytes.
      */
-    Socket(const std::vector <unsigned char> address);
+    Socket(const std::vector <unsigned char> &address);
 
     /**
      * @brief Overloading of Custom constructor.
@@ -140,7 +382,7 @@ class Socket {
      * @param[in] address The address is in the form of an IP address with a size of 4 bytes.
      * @param[in] port The port of Socket interface.
      */
-    Socket(const std::vector <unsigned char> address, int port);
+    Socket(const std::vector <unsigned char> &address, int port);
 
     /**
      * @brief Overloading of Custom constructor.
@@ -176,7 +418,7 @@ class Socket {
      * - Initializes the mutex for thread safety.
      * @param[in] address The address in the form of an IP address or domain (string).
      */
-    Socket(const std::string address);
+    Socket(const std::string &address);
 
     /**
      * @brief Overloading of Custom constructor.
@@ -188,7 +430,7 @@ class Socket {
      * @param[in] address The address in the form of an IP address or domain (string).
      * @param[in] port The port of Socket interface.
      */
-    Socket(const std::string address, int port);
+    Socket(const std::string &address, int port);
 
     /**
      * @brief Destructor.
@@ -218,7 +460,7 @@ class Socket {
      * @return `true` when the IP Address is valid
      * @return `false` when the IP Address is invalid
      */
-    bool isValidIPAddress(const std::vector <unsigned char> address);
+    bool isValidIPAddress(const std::vector <unsigned char> &address);
 
     /**
      * @brief Overloaded method for `isValidIPAddress` to check is IP Address valid or not.
@@ -240,7 +482,7 @@ class Socket {
      * @return `true` when the IP Address is valid
      * @return `false` when the IP Address is invalid
      */
-    bool isValidIPAddress(const std::string address);
+    bool isValidIPAddress(const std::string &address);
 
     /**
      * @brief Set Address of Socket Interface.
@@ -262,7 +504,7 @@ class Socket {
      * @return `true` when the IP Address is valid
      * @return `false` when the IP Address is invalid
      */
-    bool setAddress(const std::vector <unsigned char> address);
+    bool setAddress(const std::vector <unsigned char> &address);
 
     /**
      * @brief Overloaded method for `setAddress` to set Address of Socket Interface.
@@ -273,7 +515,7 @@ class Socket {
      * @return `true` when the Address is valid (base on its pattern)
      * @return `false` when the Address is invalid
      */
-    bool setAddress(const std::string address);
+    bool setAddress(const std::string &address);
 
     /**
      * @brief Overloaded method for `setAddress` to set Address of Socket Interface.
@@ -329,6 +571,16 @@ class Socket {
      */
     bool setKeepAlive(int keepAliveMs);
 
+    /**
+     * @brief Sets the maximum line length for the line reader.
+     *
+     * This setter function configures the maximum length (excluding the line terminator) of a line received by `receiveLines`. Longer lines are discarded.
+     *
+     * @param[in] lineMaxLength The maximum line length in bytes, `0` means unlimited.
+     * @return `true` when success.
+     */
+    bool setLineMaxLength(size_t lineMaxLength);
+
     /**
      * @brief Sets the SSL protection mode (is activated or not).
      *
@@ -411,6 +663,86 @@ class Socket {
      */
     int getKeepAlive();
 
+    /**
+     * @brief Gets the maximum line length for the line reader.
+     *
+     * @return The maximum line length in bytes (`0` means unlimited).
+     */
+    size_t getLineMaxLength();
+
+    /**
+     * @brief Sets the maximum frame size.
+     *
+     * This setter function configures the maximum size of the data that may be accumulated by `receiveUntillStopBytes` while the stop bytes have not been found.
+     *
+     * @param[in] maxFrameSize The maximum frame size in bytes, `0` means unlimited.
+     * @return `true` when success.
+     */
+    bool setMaxFrameSize(size_t maxFrameSize);
+
+    /**
+     * @brief Gets the maximum frame size.
+     *
+     * @return The maximum frame size in bytes (`0` means unlimited).
+     */
+    size_t getMaxFrameSize();
+
+    /**
+     * @brief Sets the receive buffer limit of this connection.
+     *
+     * This setter function configures the maximum number of bytes held in the receive buffers of this connection. When the limit is reached, no more data is read from the socket until the buffered data is consumed.
+     *
+     * @param[in] receiveBufferLimit The receive buffer limit in bytes, `0` means unlimited.
+     * @return `true` when success.
+     */
+    bool setReceiveBufferLimit(size_t receiveBufferLimit);
+
+    /**
+     * @brief Gets the receive buffer limit of this connection.
+     *
+     * @return The receive buffer limit in bytes (`0` means unlimited).
+     */
+    size_t getReceiveBufferLimit();
+
+    /**
+     * @brief Gets the number of buffered bytes of this connection accounted in the global receive usage.
+     *
+     * @return The number of buffered bytes.
+     */
+    size_t getReceiveUsage();
+
+    /**
+     * @brief Sets the process-wide receive budget.
+     *
+     * This setter function configures the maximum number of bytes buffered by all connections. When the budget is exhausted, the connections stop reading from their sockets until buffered data is consumed.
+     *
+     * @param[in] budget The receive budget in bytes, `0` means unlimited.
+     * @return `true` when success.
+     */
+    static bool setGlobalReceiveBudget(size_t budget);
+
+    /**
+     * @brief Gets the process-wide receive budget.
+     *
+     * @return The receive budget in bytes (`0` means unlimited).
+     */
+    static size_t getGlobalReceiveBudget();
+
+    /**
+     * @brief Gets the number of bytes buffered by all connections.
+     *
+     * @return The number of buffered bytes.
+     */
+    static size_t getGlobalReceiveUsage();
+
+    /**
+     * @brief Checks whether the process-wide receive budget has been exhausted.
+     *
+     * @return `true` if the budget is set and exhausted.
+     * @return `false` otherwise.
+     */
+    static bool isGlobalReceiveBudgetExhausted();
+
     /**
      * @brief Gets is the SSL handshake active or not.
      *
@@ -473,6 +805,17 @@ class Socket {
      * @return `false` if there are no bytes available in the socket buffer.
      */
     bool isInputBytesAvailable();
+
+    /**
+     * @brief Checks whether the peer has closed the connection.
+     *
+     * The peer has closed the connection when the socket is readable but the end of the stream is the next thing to read (the check does not
+     * consume any data). The check does not wait, the data that has already been received is read first.
+     *
+     * @return `true` if the peer has closed the connection (or the connection has been reset).
+     * @return `false` if the connection is open or the port is not open.
+     */
+    bool isPeerClosed();
     /**
      * @brief Performs a Socket data receive operation.
      *
@@ -532,7 +875,7 @@ class Socket {
      * @return `1` if the port is not open.
      * @return `2` if a timeout occurs.
      */
-    int receiveStartBytes(const std::vector <unsigned char> startBytes);
+    int receiveStartBytes(const std::vector <unsigned char> &startBytes);
 
     /**
      * @brief Overloaded method for `receiveStartBytes` with `const char*` input.
@@ -547,7 +890,7 @@ class Socket {
     int receiveStartBytes(const char *startBytes);
 
     /**
-     * @brief Overloaded method for `receiveStartBytes` with `std::string` input.
+     * @brief Overloaded method for `receiveStartBytes` with `std::string_view` input.
      *
      * This overloaded function performs a Socket data reception operation until the specified start bytes are detected. Any Socket data received before the start bytes are found is automatically discarded. The received Socket data can be accessed using the `Socket::getBuffer` method.
      *
@@ -556,18 +899,20 @@ class Socket {
      * @return `1` if the port is not open.
      * @return `2` if a timeout occurs.
      */
-    int receiveStartBytes(const std::string startBytes);
+    int receiveStartBytes(std::string_view startBytes);
 
     /**
      * @brief Performs a Socket data receiving operation until the specified stop bytes are detected.
      *
      * This function receives Socket data until the specified stop bytes are detected. Any Socket data received up to and including the stop bytes is automatically stored in the buffer. The received Socket data can be accessed using the `Socket::getBuffer` method.
+     * If the stop bytes are not found, the data received so far and the partial-match state are kept pending, so the next call with the same stop bytes resumes the search (including stop bytes that span two reads) instead of starting from scratch and returns the whole data at once. Use `Socket::resetStopBytesMatcher` to discard them.
      *
      * @param[in] stopBytes The data representing the stop bytes to be detected.
      * @param[in] sz The size of the stop bytes data to be detected.
      * @return `0` if the operation is successful.
      * @return `1` if the port is not open.
-     * @return `2` if a timeout occurs.
+     * @return `2` if a timeout occurs (the buffer holds the data received so far, it is also kept pending for the next call).
+     * @return `3` if the stop bytes are not found within the maximum frame size (the received data is discarded).
      */
     int receiveUntillStopBytes(const unsigned char *stopBytes, size_t sz);
 
@@ -581,7 +926,7 @@ class Socket {
      * @return `1` if the port is not open.
      * @return `2` if a timeout occurs.
      */
-    int receiveUntillStopBytes(const std::vector <unsigned char> stopBytes);
+    int receiveUntillStopBytes(const std::vector <unsigned char> &stopBytes);
     
     /**
      * @brief Overloaded function for `receiveUntillStopBytes` with input as `const char*`.
@@ -596,7 +941,7 @@ class Socket {
     int receiveUntillStopBytes(const char *stopBytes);
 
     /**
-     * @brief Overloaded function for `receiveUntillStopBytes` with input as `std::string`.
+     * @brief Overloaded function for `receiveUntillStopBytes` with input as `std::string_view`.
      *
      * This function receives Socket data until the specified stop bytes are detected. Any Socket data received up to and including the stop bytes is automatically stored in the buffer. The received Socket data can be accessed using the `Socket::getBuffer` method.
      *
@@ -605,7 +950,14 @@ class Socket {
      * @return `1` if the port is not open.
      * @return `2` if a timeout occurs.
      */
-    int receiveUntillStopBytes(const std::string stopBytes);
+    int receiveUntillStopBytes(std::string_view stopBytes);
+
+    /**
+     * @brief Discards the pending state of `receiveUntillStopBytes`.
+     *
+     * This method discards the data received while the stop bytes have not been found and resets the partial-match state, so the next `receiveUntillStopBytes` call starts from scratch.
+     */
+    void resetStopBytesMatcher();
 
     /**
      * @brief Receive Socket data and checks if the data matches the specified stop bytes.
@@ -632,7 +984,7 @@ class Socket {
      * @return `2` if a timeout occurs.
      * @return `3` if data is received but does not match the specified stop bytes.
      */
-    int receiveStopBytes(const std::vector <unsigned char> stopBytes);
+    int receiveStopBytes(const std::vector <unsigned char> &stopBytes);
 
     /**
      * @brief Function overloading for `receiveStopBytes` with input using `char *`.
@@ -648,17 +1000,17 @@ class Socket {
     int receiveStopBytes(const char *stopBytes);
 
     /**
-     * @brief Function overloading for `receiveStopBytes` with input using `std::string`.
+     * @brief Function overloading for `receiveStopBytes` with input using `std::string_view`.
      *
      * This method performs Socket data reception while simultaneously checking if the data matches the desired stop bytes. The received Socket data can be accessed using the `Socket::getBuffer` method.
      *
-     * @param[in] stopBytes A `std::string` object representing the stop bytes to be detected.
+     * @param[in] stopBytes A `std::string_view` representing the stop bytes to be detected (a `std::string` is passed without copying).
      * @return `0` if the operation is successful and the data is valid.
      * @return `1` if the port is not open.
      * @return `2` if a timeout occurs.
      * @return `3` if data is received but does not match the specified stop bytes.
      */
-    int receiveStopBytes(const std::string stopBytes);
+    int receiveStopBytes(std::string_view stopBytes);
 
     /**
      * @brief Performs Socket data reception until the desired amount of data is received.
@@ -672,6 +1024,36 @@ class Socket {
      */
     int receiveNBytes(size_t sz);
 
+    /**
+     * @brief Performs an exact-length Socket data reception straight into the destination buffer.
+     *
+     * This is the fast path for fixed-length fields. The buffered data is used first, then the kernel is asked to wake up the reception only once all the
+     * missing bytes are available (`SO_RCVLOWAT`) and they are read with a single `MSG_WAITALL` read operation. No data beyond the requested size is read.
+     * On timeout, the partially received data can be accessed using the `Socket::getBuffer` method.
+     *
+     * @param[out] buffer The destination buffer (at least `sz` bytes).
+     * @param[in] sz The size of the Socket data to be received.
+     * @return `0` if successful.
+     * @return `1` if the port is not open.
+     * @return `2` if a timeout occurs.
+     */
+    int receiveNBytes(unsigned char *buffer, size_t sz);
+
+    /**
+     * @brief Performs a line oriented Socket data reception.
+     *
+     * This method receives Socket data until at least one complete line (terminated by LF or CRLF) is available and returns all the complete lines at once, so a burst of lines costs a single read operation.
+     * The lines are returned without the line terminator as views into the connection buffer, they are only valid until the next receive operation on this connection.
+     * An incomplete line is kept in the remaining buffer and completed by the next call. Lines longer than `Socket::getLineMaxLength` are discarded.
+     *
+     * @param[out] lines A variable that holds the received lines.
+     * @return `0` if the operation is successful.
+     * @return `1` if the port is not open.
+     * @return `2` if a timeout occurs.
+     * @return `3` if a line exceeding the maximum line length has been discarded (the valid lines are still returned).
+     */
+    int receiveLines(std::vector <std::string_view> &lines);
+
     /**
      * @brief Retrieves the amount of successfully received data.
      *
@@ -755,7 +1137,9 @@ class Socket {
     /**
      * @brief Performs the operation of sending Socket data.
      *
-     * This method sends the specified data to the Socket port.
+     * This method writes as much data as the socket accepts without blocking and queues the rest. In the default (blocking) send mode the method then waits
+     * (up to the timeout) until the queued data has been written. In non-blocking send mode the method returns immediately and the queued data is written
+     * by `Socket::flushOutputQueue` when the socket becomes writable (the `TCPServer` event loop does this for its clients).
      *
      * @param[in] buffer Data to be written.
      * @param[in] sz Size of the data to be written.
@@ -765,6 +1149,268 @@ class Socket {
      */
     int sendData(const unsigned char *buffer, size_t sz);
 
+    /**
+     * @brief Method overloading of `sendData` with input as a list of buffers (scatter-gather).
+     *
+     * This method sends the buffers in order as one continuous byte stream without concatenating them first. Plain sockets write the list with `sendmsg`
+     * (the same send mode and output queue rules as `sendData` apply). SSL connections pack small buffers into records of up to 16 KB and write large
+     * buffers directly.
+     *
+     * @param[in] iov List of buffers to be written in order.
+     * @param[in] iovcnt Number of buffers in the list.
+     * @return `0` if the operation is successful.
+     * @return `1` if the port is not open.
+     * @return `2` if the data write operation fails.
+     */
+    int sendData(const struct iovec *iov, int iovcnt);
+
+    /**
+     * @brief Method overloading of `sendData` with input as a shared buffer.
+     *
+     * In zero-copy send mode, a buffer of at least the zero-copy threshold is sent with `MSG_ZEROCOPY` and the connection keeps a reference to it
+     * until the kernel has released it, so the buffer must not be modified after the call. Otherwise the data is sent the same way as
+     * `sendData(const unsigned char *, size_t)` does.
+     *
+     * @param[in] buffer Data to be written.
+     * @return `0` if the operation is successful.
+     * @return `1` if the port is not open.
+     * @return `2` if the data write operation fails.
+     */
+    int sendData(std::shared_ptr <const std::vector <unsigned char>> buffer);
+
+    /**
+     * @brief Writes the queued output data without blocking.
+     *
+     * This method should be called when the socket becomes writable (for example, when `select` reports the socket in its write set).
+     *
+     * @return `0` if the output queue is empty.
+     * @return `1` if the port is not open.
+     * @return `2` if the data write operation fails.
+     * @return `3` if data is still queued because the socket send buffer is full.
+     */
+    int flushOutputQueue();
+
+    /**
+     * @brief Gets the number of queued bytes that have not been sent.
+     *
+     * @return The size of the output queue in bytes.
+     */
+    size_t getOutputQueueSize();
+
+    /**
+     * @brief Sets the send mode.
+     *
+     * In non-blocking send mode, `sendData` never waits for the socket to become writable. The data that cannot be written immediately is queued and must be
+     * written by calling `Socket::flushOutputQueue` on write-readiness. The clients of `TCPServer` use this mode.
+     *
+     * @param[in] isNonBlockingSend `true` to enable the non-blocking send mode.
+     * @return `true` when success.
+     */
+    bool setNonBlockingSend(bool isNonBlockingSend);
+
+    /**
+     * @brief Sets the output queue watermarks.
+     *
+     * When the output queue grows to `high` bytes the write blocked handler is called, so the producer can stop sending to this connection. When
+     * the queue has been written down to `low` bytes afterwards the write drained handler is called, so the producer can resume. The output queue
+     * itself is not bounded, data sent while blocked is still queued. The clients accepted by `TCPServer` inherit the watermarks and the handlers
+     * of the server.
+     *
+     * @param[in] low The low watermark in bytes.
+     * @param[in] high The high watermark in bytes (`0` disables the watermark handlers).
+     * @return `true` when success.
+     * @return `false` if `high` is not `0` and not greater than `low`.
+     */
+    bool setWriteWatermarks(size_t low, size_t high);
+
+    /**
+     * @brief Gets the low watermark of the output queue.
+     *
+     * @return The low watermark in bytes.
+     */
+    size_t getWriteLowWatermark();
+
+    /**
+     * @brief Gets the high watermark of the output queue.
+     *
+     * @return The high watermark in bytes (`0` means disabled).
+     */
+    size_t getWriteHighWatermark();
+
+    /**
+     * @brief Checks whether the output queue has reached the high watermark and has not been drained to the low watermark yet.
+     *
+     * @return `true` if the connection is write blocked.
+     */
+    bool getIsWriteBlocked();
+
+    /**
+     * @brief Sets the handler that is called when the output queue reaches the high watermark.
+     *
+     * The handler is called without holding any lock of the connection, from the thread that performs the send. It may call `sendData`.
+     *
+     * @param[in] func callback function that has 2 parameters. `Socket &` is the connection. `void *` is a pointer that will connect directly to `void *param`.
+     * @param[in] param callback function parameter.
+     */
+    void setWriteBlockedHandler(void (*func)(Socket &, void *), void *param);
+
+    /**
+     * @brief Sets the handler that is called when the output queue has been written down to the low watermark after a write blocked event.
+     *
+     * The handler is called without holding any lock of the connection, from the thread that writes the queue (for `TCPServer` clients this is the
+     * thread that calls `TCPServer::eventCheck`, so the handler must not call methods of the server). It may call `sendData`.
+     *
+     * @param[in] func callback function that has 2 parameters. `Socket &` is the connection. `void *` is a pointer that will connect directly to `void *param`.
+     * @param[in] param callback function parameter.
+     */
+    void setWriteDrainedHandler(void (*func)(Socket &, void *), void *param);
+
+    /**
+     * @brief Sets the handler that is called when data is queued in the empty output queue.
+     *
+     * In non-blocking send mode `sendData` returns `0` as soon as the data is queued, the queue is written later by `Socket::flushOutputQueue`.
+     * The handler lets the event loop that flushes the queue wake up (`TCPServer` sets it for its clients, so `TCPServer::eventCheck` does not
+     * wait for its timeout). The handler is called without holding any lock of the connection, from the thread that performs the send.
+     *
+     * @param[in] func callback function that has 2 parameters. `Socket &` is the connection. `void *` is a pointer that will connect directly to `void *param`.
+     * @param[in] param callback function parameter.
+     */
+    void setOutputQueuedHandler(void (*func)(Socket &, void *), void *param);
+
+    /**
+     * @brief Sets the `TCP_NODELAY` option.
+     *
+     * Disabling the Nagle algorithm sends small segments immediately, which lowers the latency of request/response traffic. Keep it enabled (the
+     * default) for throughput oriented connections. The option is applied immediately if the socket is open, and otherwise when it is opened. The clients
+     * accepted by `TCPServer` inherit the option of the server.
+     *
+     * @param[in] isNoDelay `true` to disable the Nagle algorithm.
+     * @return `true` when success.
+     * @return `false` if the option can not be applied to the open socket.
+     */
+    bool setNoDelay(bool isNoDelay);
+
+    /**
+     * @brief Gets the `TCP_NODELAY` option.
+     *
+     * @return `true` if the Nagle algorithm is disabled.
+     */
+    bool getNoDelay();
+
+    /**
+     * @brief Sets the corked send mode.
+     *
+     * In corked send mode, `sendData` appends the data to a userspace cork buffer instead of writing it, so many small writes of one logical message
+     * leave the process as a single write. The cork buffer is flushed by `Socket::flush`, automatically when it reaches `maxSize` bytes, and when
+     * its oldest byte has waited `deadlineMs` (checked on every send, and on every `TCPServer::eventCheck` for the clients of the server). Disabling
+     * the corked send mode flushes the cork buffer. A receive operation that waits for the peer flushes the cork buffer first, as the peer usually
+     * waits for that data (for example a request) before it answers.
+     *
+     * @param[in] isCorked `true` to enable the corked send mode.
+     * @param[in] maxSize The size of the cork buffer that triggers an automatic flush.
+     * @param[in] deadlineMs The maximum time in milliseconds the data stays in the cork buffer (`0` means no deadline).
+     * @return `true` when success.
+     * @return `false` if `maxSize` is `0` or flushing the cork buffer fails.
+     */
+    bool setCork(bool isCorked, size_t maxSize, unsigned int deadlineMs);
+
+    /**
+     * @brief Method overloading of `setCork` that keeps the current flush size and deadline (`16384` bytes and `200` ms by default).
+     *
+     * @param[in] isCorked `true` to enable the corked send mode.
+     * @return `true` when success.
+     * @return `false` if flushing the cork buffer fails.
+     */
+    bool setCork(bool isCorked);
+
+    /**
+     * @brief Gets the corked send mode.
+     *
+     * @return `true` if the corked send mode is enabled.
+     */
+    bool getCork();
+
+    /**
+     * @brief Writes the data coalesced in the cork buffer.
+     *
+     * In the default (blocking) send mode the method also waits (up to the timeout) until the output queue has been written.
+     *
+     * @return `0` if the operation is successful.
+     * @return `1` if the port is not open.
+     * @return `2` if the data write operation fails.
+     */
+    int flush();
+
+    /**
+     * @brief Flushes the cork buffer if the data in it has reached the flush deadline.
+     *
+     * This method is called by `TCPServer::eventCheck` for its clients. Applications that drive a corked connection from their own loop can call it
+     * periodically.
+     *
+     * @return `0` if nothing has to be flushed or the operation is successful.
+     * @return `2` if the data write operation fails.
+     */
+    int flushIfDeadlineExpired();
+
+    /**
+     * @brief Gets the time left before the data in the cork buffer reaches the flush deadline.
+     *
+     * `TCPServer::eventCheck` waits at most this time, so the cork buffers of its clients are flushed on time. Applications that drive a corked
+     * connection from their own loop can use it as the timeout of their wait.
+     *
+     * @return the time left in milliseconds (`0` if the deadline has been reached).
+     * @return `-1` if the cork buffer is empty or there is no deadline.
+     */
+    long getCorkTimeLeft();
+
+    /**
+     * @brief Sets the zero-copy send mode.
+     *
+     * In zero-copy send mode, buffers passed to `sendData(std::shared_ptr <const std::vector <unsigned char>>)` of at least `threshold` bytes are sent
+     * with `MSG_ZEROCOPY`: the kernel transmits directly from the buffer instead of copying it. The connection keeps a reference to the buffer until the
+     * kernel reports the completion on the socket error queue. Smaller buffers, SSL connections, the corked send mode and the other `sendData`
+     * overloads keep the copy path. Zero-copy pays off for buffers of about 16 KB and more.
+     *
+     * @param[in] isZeroCopy `true` to enable the zero-copy send mode.
+     * @param[in] threshold The minimum buffer size that is sent with `MSG_ZEROCOPY`.
+     * @return `true` when success.
+     * @return `false` if the kernel does not support `SO_ZEROCOPY`.
+     */
+    bool setZeroCopy(bool isZeroCopy, size_t threshold);
+
+    /**
+     * @brief Method overloading of `setZeroCopy` that keeps the current threshold (`16384` bytes by default).
+     *
+     * @param[in] isZeroCopy `true` to enable the zero-copy send mode.
+     * @return `true` when success.
+     * @return `false` if the kernel does not support `SO_ZEROCOPY`.
+     */
+    bool setZeroCopy(bool isZeroCopy);
+
+    /**
+     * @brief Gets the zero-copy send mode.
+     *
+     * @return `true` if the zero-copy send mode is enabled.
+     */
+    bool getZeroCopy();
+
+    /**
+     * @brief Reads the zero-copy completion notifications and releases the buffers the kernel no longer references.
+     *
+     * This method is called by every send and by `TCPServer::eventCheck` for its clients. Applications that drive a connection from their own loop
+     * can call it when the socket reports an error condition (`POLLERR`). The error queue is drained even if no buffer is pending, so late completions are consumed.
+     *
+     * @return The number of completion notifications that have been read.
+     */
+    int processZeroCopyCompletions();
+
+    /**
+     * @brief Gets the number of bytes of the buffers that are still referenced by the kernel.
+     *
+     * @return The size of the buffers waiting for a zero-copy completion in bytes.
+     */
+    size_t getZeroCopyPendingSize();
+
     /**
      * @brief Method overloading of `sendData` with input as `const std::vector`.
      *
@@ -775,7 +1421,20 @@ class Socket {
      * @return `1` if the port is not open.
      * @return `2` if the data write operation fails.
      */
-    int sendData(const std::vector <unsigned char> buffer);
+    int sendData(const std::vector <unsigned char> &buffer);
+
+    /**
+     * @brief Method overloading of `sendData` that takes the ownership of a `std::vector`.
+     *
+     * This method sends the specified data to the Socket port. In non-blocking send mode the part of the data that cannot be written immediately
+     * is moved into the output queue instead of being copied. The corked send mode and SSL connections copy the data like `sendData(const std::vector &)`.
+     *
+     * @param[in] buffer Data to be written (moved from).
+     * @return `0` if the operation is successful.
+     * @return `1` if the port is not open.
+     * @return `2` if the data write operation fails.
+     */
+    int sendData(std::vector <unsigned char> &&buffer);
 
     /**
      * @brief Method overloading of `sendData` with input as `const char*`.
@@ -790,16 +1449,102 @@ class Socket {
     int sendData(const char *buffer);
 
     /**
-     * @brief Method overloading of `sendData` with input as `const std::string`.
+     * @brief Method overloading of `sendData` with input as `std::string_view`.
      *
-     * This method sends the specified data to the Socket port. This overload allows the data to be passed as a `const std::string`.
+     * This method sends the specified data to the Socket port. This overload allows the data to be passed as a `std::string_view` (a `std::string` is passed without copying).
      *
      * @param[in] buffer Data to be written.
      * @return `0` if the operation is successful.
      * @return `1` if the port is not open.
      * @return `2` if the data write operation fails.
      */
-    int sendData(const std::string buffer);
+    int sendData(std::string_view buffer);
+
+#if __cplusplus >= 202002L
+    /**
+     * @brief Method overloading of `sendData` with input as `std::span`.
+     *
+     * Defined in the header, so it is available to C++20 code whatever standard the library has been built with.
+     *
+     * @param[in] buffer Data to be written.
+     * @return `0` if the operation is successful.
+     * @return `1` if the port is not open.
+     * @return `2` if the data write operation fails.
+     */
+    int sendData(std::span <const unsigned char> buffer){
+        return this->sendData(buffer.data(), buffer.size());
+    }
+#endif
+
+    /**
+     * @brief Sends the content of a file.
+     *
+     * This method sends `length` bytes of the file starting at `offset` (a `length` of `0` sends the file up to its end). Plain sockets use `sendfile`,
+     * so the file data is never copied into userspace. SSL connections fall back to reading the file in 64 KB chunks and writing them with `SSL_write`.
+     * The transfer is performed in chunks and `wmtx` is only held while a chunk is written, so other threads are not blocked for the whole transfer
+     * (their data is written between two chunks). Data queued by the corked send mode or the output queue is written before the file. The method
+     * waits (up to the timeout) for the socket to become writable before each chunk, regardless of the send mode.
+     *
+     * @param[in] fd The file descriptor of the file (the file offset of the descriptor is not changed).
+     * @param[in] offset The offset of the first byte in the file.
+     * @param[in] length The number of bytes to send.
+     * @return `0` if the operation is successful.
+     * @return `1` if the port is not open.
+     * @return `2` if the data write operation fails or a timeout occurs.
+     * @return `3` if the file can not be read or the requested range is beyond the end of the file.
+     */
+    int sendFile(int fd, off_t offset, size_t length);
+
+    /**
+     * @brief Method overloading of `sendFile` with a progress handler.
+     *
+     * This method sends `length` bytes of the file starting at `offset` (a `length` of `0` sends the file up to its end). Plain sockets use `sendfile`,
+     * so the file data is never copied into userspace. SSL connections fall back to reading the file in 64 KB chunks and writing them with `SSL_write`.
+     * The transfer is performed in chunks and `wmtx` is only held while a chunk is written, so other threads are not blocked for the whole transfer
+     * (their data is written between two chunks). Data queued by the corked send mode or the output queue is written before the file. The method
+     * waits (up to the timeout) for the socket to become writable before each chunk, regardless of the send mode.
+     *
+     * @param[in] fd The file descriptor of the file (the file offset of the descriptor is not changed).
+     * @param[in] offset The offset of the first byte in the file.
+     * @param[in] length The number of bytes to send.
+     * @param[in] func callback function that is called after every chunk (without holding any lock). `Socket &` is the connection, followed by the
+     *                 number of bytes that have been sent and the total number of bytes to send. `void *` is a pointer that will connect directly
+     *                 to `void *param`.
+     * @param[in] param callback function parameter.
+     * @return `0` if the operation is successful.
+     * @return `1` if the port is not open.
+     * @return `2` if the data write operation fails or a timeout occurs.
+     * @return `3` if the file can not be read or the requested range is beyond the end of the file.
+     */
+    int sendFile(int fd, off_t offset, size_t length, void (*func)(Socket &, size_t, size_t, void *), void *param);
+
+    /**
+     * @brief Method overloading of `sendFile` with input as a file path.
+     *
+     * @param[in] path The path of the file.
+     * @param[in] offset The offset of the first byte in the file.
+     * @param[in] length The number of bytes to send (`0` sends the file up to its end).
+     * @return `0` if the operation is successful.
+     * @return `1` if the port is not open.
+     * @return `2` if the data write operation fails or a timeout occurs.
+     * @return `3` if the file can not be opened or read, or the requested range is beyond the end of the file.
+     */
+    int sendFile(const std::string &path, off_t offset, size_t length);
+
+    /**
+     * @brief Method overloading of `sendFile` with input as a file path and a progress handler.
+     *
+     * @param[in] path The path of the file.
+     * @param[in] offset The offset of the first byte in the file.
+     * @param[in] length The number of bytes to send (`0` sends the file up to its end).
+     * @param[in] func callback function that is called after every chunk (see `sendFile(int, off_t, size_t, void (*)(Socket &, size_t, size_t, void *), void *)`).
+     * @param[in] param callback function parameter.
+     * @return `0` if the operation is successful.
+     * @return `1` if the port is not open.
+     * @return `2` if the data write operation fails or a timeout occurs.
+     * @return `3` if the file can not be opened or read, or the requested range is beyond the end of the file.
+     */
+    int sendFile(const std::string &path, off_t offset, size_t length, void (*func)(Socket &, size_t, size_t, void *), void *param);
 
     /**
      * @brief Closes the Socket connection between client and server.
@@ -807,6 +1552,8 @@ class Socket {
      * This function is used to close the currently Socket connection between client and server,
      * ensuring that the port is no longer in use and that any associated system resources
      * are released.
+     *
+     * Data left in the cork buffer is written before the connection is closed.
      */
     void closeConnection();
 
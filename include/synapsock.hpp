@@ -38,12 +38,510 @@
 #define __SYNAPSOCK_HPP__
 
 #include "socket.hpp"
+#include "checksum.hpp"
 #include "data-frame.hpp"
+#include "inplace-function.hpp"
+#include "field-view.hpp"
+#include "buffer-pool.hpp"
 
 class SynapSock : public Socket {
+  public:
+    typedef struct _FRAME_VIEW_t {        /*!< view of a frame stored in the connection buffer */
+      const unsigned char *data;          /*!< pointer to the first byte of the frame */
+      size_t size;                        /*!< size of the frame */
+    } FRAME_VIEW_t;
+
+    typedef InplaceFunction <void(DataFrame &)> FRAME_HOOK_t;   /*!< execute or post-execute handler of a field, called with the field */
+
+    /**
+     * @brief Frame parser: finds the first frame of a buffer.
+     *
+     * `begin` is the offset of the frame (the data before it is skipped, also when `2` is returned) and `size` is the size of the frame.
+     * The parser returns `0` if a complete frame has been found, `2` if more data is needed, or `4` if the frame at `begin` is invalid.
+     */
+    typedef int (*FRAME_PARSER_t)(const unsigned char *buffer, size_t sz, size_t *begin, size_t *size);
+
+    typedef enum _LENGTH_ENCODING_t {     /*!< list of encodings of a length field */
+      LENGTH_ENCODING_UINT8 = 0,          /*!< 1 byte unsigned integer */
+      LENGTH_ENCODING_UINT16_BE,          /*!< 2 bytes unsigned integer, big-endian */
+      LENGTH_ENCODING_UINT16_LE,          /*!< 2 bytes unsigned integer, little-endian */
+      LENGTH_ENCODING_UINT32_BE,          /*!< 4 bytes unsigned integer, big-endian */
+      LENGTH_ENCODING_UINT32_LE,          /*!< 4 bytes unsigned integer, little-endian */
+      LENGTH_ENCODING_UINT64_BE,          /*!< 8 bytes unsigned integer, big-endian */
+      LENGTH_ENCODING_UINT64_LE,          /*!< 8 bytes unsigned integer, little-endian */
+      LENGTH_ENCODING_VARINT              /*!< unsigned LEB128 varint (7 bits per byte, least significant group first), up to 10 bytes */
+    } LENGTH_ENCODING_t;
+
+  private:
+    typedef enum _PARSE_OP_t {            /*!< list of parse operations of the compiled frame format */
+      PARSE_OP_START_BYTES = 0,           /*!< search the start bytes */
+      PARSE_OP_STOP_BYTES,                /*!< match the stop bytes */
+      PARSE_OP_FIELD,                     /*!< read a field of `getSize()` bytes, or up to the stop bytes that follow it if the size is `0` */
+      PARSE_OP_LENGTH,                    /*!< read a length field and set the size of the field bound to it */
+      PARSE_OP_VALIDATOR,                 /*!< read a checksum field and compare it with the checksum of the fields it covers */
+      PARSE_OP_INVALID                    /*!< the field can not be parsed */
+    } PARSE_OP_t;
+
+    typedef struct _PARSE_STEP_t {        /*!< one step of the compiled frame format */
+      DataFrame *node;                    /*!< field of the frame format */
+      unsigned char op;                   /*!< parse operation (`PARSE_OP_t`) */
+      std::vector <unsigned char> delimiter;  /*!< start or stop bytes of the field, or the stop bytes that terminate a field without size */
+      unsigned char lengthEncoding;       /*!< encoding of the length field (`LENGTH_ENCODING_t`), only for `PARSE_OP_LENGTH` */
+      long lengthAdjustment;              /*!< value added to the decoded length to get the size of the bound field */
+      size_t lengthMax;                   /*!< maximum size of the bound field (`0` for no limit) */
+      size_t lengthTarget;                /*!< index of the step of the bound field */
+      bool isSizeBound;                   /*!< `true` if the size of this field is set by a length field */
+      unsigned char checksumAlgorithm;    /*!< validation algorithm (`Checksum::ALGORITHM_t`), only for `PARSE_OP_VALIDATOR` */
+      bool isChecksumBigEndian;           /*!< `true` if the checksum is stored big-endian */
+      size_t checksumBegin;               /*!< index of the first step covered by the checksum */
+      size_t checksumEnd;                 /*!< index of the last step covered by the checksum */
+      FRAME_HOOK_t execute;               /*!< execute handler declared with `setExecuteHandler` (empty to use the execute function of the field) */
+      FRAME_HOOK_t postExecute;           /*!< post-execute handler declared with `setPostExecuteHandler` (empty to use the post-execute function of the field) */
+    } PARSE_STEP_t;
+
+    typedef struct _STEP_STATE_t {        /*!< state of one parse step for the frame of a connection */
+      size_t boundSize;                   /*!< size of the field decoded from its length field */
+      uint32_t checksumValue;             /*!< checksum of the covered fields, updated as the fields are parsed (only for a checksum field) */
+      size_t fieldOffset;                 /*!< offset of the field of the last parsed frame from the beginning of the frame */
+      size_t fieldSize;                   /*!< size of the field of the last parsed frame */
+    } STEP_STATE_t;
+
+    typedef struct _LENGTH_BINDING_t {    /*!< length field bound to the field it sizes */
+      DataFrame *lengthNode;              /*!< field that holds the length */
+      DataFrame *targetNode;              /*!< field that is sized by the length */
+      unsigned char encoding;             /*!< encoding of the length field (`LENGTH_ENCODING_t`) */
+      long adjustment;                    /*!< value added to the decoded length to get the size of the bound field */
+      size_t maxSize;                     /*!< maximum size of the bound field (`0` for no limit) */
+    } LENGTH_BINDING_t;
+
+    typedef struct _VALIDATOR_BINDING_t { /*!< checksum field bound to the range of fields it covers */
+      DataFrame *validatorNode;           /*!< field that holds the checksum */
+      DataFrame *beginNode;               /*!< first field covered by the checksum */
+      DataFrame *endNode;                 /*!< last field covered by the checksum */
+      unsigned char algorithm;            /*!< validation algorithm (`Checksum::ALGORITHM_t`) */
+      bool isBigEndian;                   /*!< `true` if the checksum is stored big-endian */
+    } VALIDATOR_BINDING_t;
+
+    typedef struct _HOOK_BINDING_t {      /*!< execute and post-execute handlers bound to a field */
+      DataFrame *node;                    /*!< field the handlers are bound to */
+      FRAME_HOOK_t execute;               /*!< handler called before the field is parsed */
+      FRAME_HOOK_t postExecute;           /*!< handler called after the field is parsed */
+    } HOOK_BINDING_t;
+
+    typedef struct _PARSE_CURSOR_t {      /*!< state of the frame that is being parsed, kept across receive operations */
+      size_t step;                        /*!< index of the parse step to be resumed */
+      size_t begin;                       /*!< offset of the first byte of the frame in the buffered data */
+      size_t pos;                         /*!< offset of the first byte of the field to be parsed */
+      size_t scanned;                     /*!< offset where the delimiter search of the current step resumes */
+      bool isExecuted;                    /*!< `true` if the execute function of the current step has been called */
+    } PARSE_CURSOR_t;
+
+  public:
+    /**
+     * @brief Frame format compiled for parsing, that can be shared by several connections.
+     *
+     * The schema holds the fields of the frame format, the parse plan and the declared length fields, checksum fields and handlers. It is only
+     * read while parsing, the state of the frame being parsed is kept by each connection, so the connections that share a schema can parse
+     * concurrently. Use `shareFormat` and `setFormat` to share a schema.
+     */
+    class FrameSchema {
+      private:
+        friend class SynapSock;
+        DataFrame *frameFormat;                                 /*!< fields of the frame format */
+        std::vector <PARSE_STEP_t> parsePlan;                   /*!< frame format compiled into a flat list of parse steps */
+        std::vector <std::vector <DataFrame *>> formatIndex;    /*!< fields of the frame format indexed by type */
+        std::vector <LENGTH_BINDING_t> lengthBindings;          /*!< length fields declared with `setLengthField` */
+        std::vector <VALIDATOR_BINDING_t> validatorBindings;    /*!< checksum fields declared with `setValidator` */
+        std::vector <size_t> validatorSteps;                    /*!< indexes of the parse steps of the checksum fields */
+        std::vector <HOOK_BINDING_t> hookBindings;              /*!< field handlers declared with `setExecuteHandler` and `setPostExecuteHandler` */
+
+        /**
+         * @brief Gets the number of bytes of a field of the frame encoded from `fields`.
+         *
+         * @param[in] idx The index of the field.
+         * @param[in] fields The value of every field.
+         * @return the number of bytes of the field (`0` for a length field if the size of its bound field cannot be encoded, see `encodeLength`).
+         */
+        size_t getEncodedSize(size_t idx, const FieldView *fields) const;
+
+        /**
+         * @brief Gets the offset of a field in the frame encoded from `fields`.
+         *
+         * @param[in] idx The index of the field (the number of fields for the size of the frame).
+         * @param[in] fields The value of every field.
+         * @return the offset of the field.
+         */
+        size_t getEncodedOffset(size_t idx, const FieldView *fields) const;
+
+      public:
+        /**
+         * @brief Default constructor, creates an empty schema.
+         */
+        FrameSchema();
+
+        FrameSchema(const FrameSchema &obj) = delete;
+
+        /**
+         * @brief Destructor, releases the fields of the frame format.
+         */
+        ~FrameSchema();
+
+        /**
+         * @brief Gets the number of fields of the frame format.
+         *
+         * @return the number of fields.
+         */
+        size_t getFieldCount() const;
+
+        /**
+         * @brief Checks if a field of the frame format has an execute function, a post-execute function or a handler.
+         *
+         * @return `true` if a function is called while parsing.
+         */
+        bool hasCallbacks() const;
+
+        /**
+         * @brief Encodes a frame from the values of its fields.
+         *
+         * The frame is written into `buffer` (its capacity is kept) in one pass over the fields: the start and stop bytes come from the frame format,
+         * the declared length fields are encoded from the size of the field they size and the declared checksum fields are computed over the
+         * bytes that have just been written. The frame format is only read, so the same schema can encode frames from any number of threads.
+         *
+         * @param[in] fields The value of every field, indexed as the frame format (the values of the start bytes, stop bytes, declared length and
+         * checksum fields are ignored).
+         * @param[in] count The number of values, it must be the number of fields of the frame format.
+         * @param[out] buffer A variable that holds the encoded frame.
+         * @return `0` on success.
+         * @return `1` if the frame format is not set up, the number of values is invalid or the size of a bound field does not fit in its length field (or exceeds its maximum size), or if a value does not match its field (a fixed size field with a value of another size, or a delimited field whose value contains its stop bytes).
+         */
+        int encode(const FieldView *fields, size_t count, std::vector <unsigned char> &buffer) const;
+
+        FrameSchema& operator=(const FrameSchema &obj) = delete;
+    };
+
+    typedef std::shared_ptr <FrameSchema> SHARED_FORMAT_t;  /*!< frame format shared by several connections */
+
+    /**
+     * @brief Frame encoded once, that is sent again with only some of its fields changed.
+     *
+     * A template is created with `createFrameTemplate`. Its fields can be changed in place with `patch`, by index or by the name of a patch point
+     * (for example a sequence number or a payload). The declared length fields are updated when the size of the field they size changes, and
+     * the declared checksum fields are computed again before the frame is sent with `sendFramedData(FrameTemplate &)`, the other bytes are not
+     * encoded again. A template keeps a copy of the parse plan, so it does not depend on the frame format after it has been created.
+     */
+    class FrameTemplate {
+      private:
+        friend class SynapSock;
+        std::vector <PARSE_STEP_t> parsePlan;                           /*!< parse plan of the frame format the template was created with */
+        std::vector <unsigned char> frame;                              /*!< encoded frame */
+        std::vector <size_t> offsets;                                   /*!< offset of each field in the frame, followed by the size of the frame */
+        std::vector <std::pair <std::string, size_t>> patchPoints;      /*!< named fields */
+        bool isValidated;                                               /*!< `true` if the checksum fields are up to date */
+
+        /**
+         * @brief Replaces the bytes of a field, the next fields are moved if the size changes.
+         *
+         * @param[in] idx The index of the field.
+         * @param[in] data The new bytes of the field.
+         * @param[in] sz The number of new bytes.
+         */
+        void replaceField(size_t idx, const unsigned char *data, size_t sz);
+
+      public:
+        /**
+         * @brief Default constructor, creates an empty template.
+         */
+        FrameTemplate();
+
+        /**
+         * @brief Names a field of the template.
+         *
+         * @param[in] name The name of the patch point.
+         * @param[in] idx The index of the field in the frame format.
+         * @return `0` on success.
+         * @return `1` if the index is invalid, or the field is start bytes, stop bytes, or a declared length or checksum field (they are computed).
+         */
+        int setPatchPoint(const std::string &name, int idx);
+
+        /**
+         * @brief Gets the index of the field of a patch point.
+         *
+         * @param[in] name The name of the patch point.
+         * @return the index of the field (`-1` if there is no patch point with this name).
+         */
+        int getPatchPoint(const std::string &name);
+
+        /**
+         * @brief Changes the value of a field.
+         *
+         * The bytes are copied in place when the size does not change. Otherwise the next fields are moved and the length field bound to the
+         * field (if any) is encoded again.
+         *
+         * @param[in] idx The index of the field in the frame format.
+         * @param[in] value The new value of the field.
+         * @return `0` on success.
+         * @return `1` if the index is invalid, the field is start bytes, stop bytes, or a declared length or checksum field, or the new size does not
+         * fit in the length field bound to the field (or exceeds its maximum size). The template is then not modified.
+         */
+        int patch(int idx, const FieldView &value);
+
+        /**
+         * @brief Overloaded method of `patch` with the name of a patch point.
+         *
+         * @param[in] name The name of the patch point.
+         * @param[in] value The new value of the field.
+         * @return `0` on success.
+         * @return `1` if there is no patch point with this name.
+         */
+        int patch(const std::string &name, const FieldView &value);
+
+        /**
+         * @brief Gets a field of the template.
+         *
+         * @param[in] idx The index of the field in the frame format.
+         * @return view of the field (empty if the index is invalid), valid until the template is patched.
+         */
+        FieldView getField(int idx);
+
+        /**
+         * @brief Gets the encoded frame, the checksum fields are computed first if a covered field has been patched.
+         *
+         * @return view of the frame (empty if the template has not been created), valid until the template is patched.
+         */
+        FieldView getFrame();
+    };
+
   private:
     bool isFormatValid;
-    DataFrame *frameFormat;
+    SHARED_FORMAT_t schema;                                 /*!< frame format of this connection (never `nullptr`) */
+    bool isSchemaShared;                                    /*!< `true` if the schema is shared with other connections, it is then only read */
+    SHARED_FORMAT_t sharedSchema;                           /*!< read-only snapshot of the frame format returned by `shareFormat` (`nullptr` until it is taken) */
+    pthread_mutex_t formatMtx;                              /*!< protects `sharedSchema` */
+    std::vector <STEP_STATE_t> stepStates;                  /*!< state of the parse steps for the frame of this connection */
+    PARSE_CURSOR_t parseCursor;                             /*!< parse state of the partial frame held in the remaining buffer */
+    size_t parseCursorDataSize;                             /*!< size of the remaining buffer the parse state refers to */
+    std::vector <unsigned char> frameData;                  /*!< scratch space where `receiveFramedData` assembles the frame (keeps its capacity) */
+    bool isResync;                                          /*!< `true` if `receiveFramedData` resynchronizes inside the receive buffer */
+    size_t skippedBytes;                                    /*!< number of bytes discarded by the frame parser */
+    size_t invalidFrames;                                   /*!< number of frames rejected by the frame parser */
+    std::vector <std::vector <unsigned char>> sendSegments;   /*!< scratch space for the field data of the frame being sent (keeps its capacity) */
+    std::vector <struct iovec> sendIov;                       /*!< scratch list of buffers of the frame being sent */
+    BufferPool sendPool;                                      /*!< output buffers of the frames encoded by `sendFramedData(const FieldView *, size_t)` */
+
+    /**
+     * @brief Compiles the frame format into the parse plan and the index of fields.
+     *
+     * The delimiters and the parse operation of every field are resolved once, so receiving a frame does not walk the linked list or copy the
+     * delimiters. The field sizes are still read from the fields while parsing, since an execute or post-execute function may resize a field.
+     */
+    void compileFormat();
+
+    /**
+     * @brief Compiles the fields of a schema into its parse plan and its index of fields.
+     *
+     * @param[in,out] schema The schema, its declared length fields, checksum fields and handlers are resolved to parse steps.
+     */
+    static void compileSchema(FrameSchema &schema);
+
+    /**
+     * @brief Copies a list of fields.
+     *
+     * @param[in] obj The first field of the list.
+     * @return the first field of the copy.
+     */
+    static DataFrame *copyFrames(const DataFrame &obj);
+
+    /**
+     * @brief Copies a schema.
+     *
+     * The fields, the declared length fields, checksum fields and handlers are copied, then the copy is compiled.
+     *
+     * @param[in] format The schema to be copied.
+     * @return the copy of the schema.
+     */
+    static SHARED_FORMAT_t copySchema(const FrameSchema &format);
+
+    /**
+     * @brief Decodes the value of a length field.
+     *
+     * @param[in] buffer The buffer that starts with the length field.
+     * @param[in] sz The size of the buffer.
+     * @param[in] step The parse step of the length field.
+     * @param[out] fieldSize The number of bytes of the length field.
+     * @param[out] length The size of the bound field (the adjustment has been applied).
+     * @return `0` if the length has been decoded.
+     * @return `2` if the buffer does not hold the whole length field yet.
+     * @return `4` if the length is invalid or exceeds the maximum size.
+     */
+    static int decodeLength(const unsigned char *buffer, size_t sz, const PARSE_STEP_t &step, size_t *fieldSize, size_t *length);
+
+    /**
+     * @brief Encodes the size of a field into a length field.
+     *
+     * @param[out] buffer A variable that holds the encoded length field.
+     * @param[in] step The parse step of the length field.
+     * @param[in] size The size of the bound field.
+     * @return `true` when success.
+     * @return `false` if the size does not fit in the length field or exceeds the maximum size (the buffer is then empty).
+     */
+    static bool encodeLength(std::vector <unsigned char> &buffer, const PARSE_STEP_t &step, size_t size);
+
+    /**
+     * @brief Overloaded method of `encodeLength` that writes into a buffer of at least 10 bytes.
+     *
+     * @param[out] buffer The buffer that holds the encoded length field.
+     * @param[in] step The parse step of the length field.
+     * @param[in] size The size of the bound field.
+     * @return the number of bytes of the length field.
+     * @return `0` if the size does not fit in the length field or exceeds the maximum size (nothing is written).
+     */
+    static size_t encodeLength(unsigned char *buffer, const PARSE_STEP_t &step, size_t size);
+
+    /**
+     * @brief Updates the checksums that cover a parse step with the bytes of the step.
+     *
+     * @param[in] stepIdx The index of the parse step.
+     * @param[in] buffer The bytes of the step (field data or delimiter).
+     * @param[in] sz The number of bytes of the step.
+     */
+    void updateValidators(size_t stepIdx, const unsigned char *buffer, size_t sz);
+
+    /**
+     * @brief Compares a received checksum with the checksum computed over the covered fields.
+     *
+     * @param[in] step The parse step of the checksum field.
+     * @param[in] checksum The checksum computed over the covered fields.
+     * @param[in] buffer The received checksum (`Checksum::getSize` bytes).
+     * @return `true` if the checksum is valid.
+     */
+    static bool isChecksumValid(const PARSE_STEP_t &step, uint32_t checksum, const unsigned char *buffer);
+
+    /**
+     * @brief Encodes a checksum into a checksum field.
+     *
+     * @param[out] buffer A variable that holds the encoded checksum field.
+     * @param[in] step The parse step of the checksum field.
+     * @param[in] value The checksum.
+     */
+    static void encodeChecksum(std::vector <unsigned char> &buffer, const PARSE_STEP_t &step, uint32_t value);
+
+    /**
+     * @brief Overloaded method of `encodeChecksum` that writes into a buffer of `Checksum::getSize` bytes.
+     *
+     * @param[out] buffer The buffer that holds the encoded checksum field.
+     * @param[in] step The parse step of the checksum field.
+     * @param[in] value The checksum.
+     */
+    static void encodeChecksum(unsigned char *buffer, const PARSE_STEP_t &step, uint32_t value);
+
+    /**
+     * @brief Calls the execute handler of a parse step, or the execute function of its field if no handler is declared.
+     *
+     * @param[in] step The parse step.
+     */
+    void executeStep(const PARSE_STEP_t &step);
+
+    /**
+     * @brief Calls the post-execute handler of a parse step, or the post-execute function of its field if no handler is declared.
+     *
+     * @param[in] step The parse step.
+     */
+    void postExecuteStep(const PARSE_STEP_t &step);
+
+    /**
+     * @brief Binds an execute or post-execute handler to a field of the frame format.
+     *
+     * @param[in] idx The index of the field in the frame format.
+     * @param[in] func The handler (an empty handler removes it).
+     * @param[in] isPost `true` for the post-execute handler, `false` for the execute handler.
+     * @return `0` on success.
+     * @return `1` if the frame format is not set up or the index is invalid.
+     */
+    int setFieldHandler(int idx, const FRAME_HOOK_t &func, bool isPost);
+
+    /**
+     * @brief Restarts the parse state at the beginning of a frame.
+     *
+     * @param[in] offset The offset in the buffered data where the next frame is searched.
+     */
+    void resetParseCursor(size_t offset);
+
+    /**
+     * @brief Gives this connection its own copy of a shared frame format before it is modified.
+     *
+     * The fields, the declared length fields, checksum fields and handlers are copied. Nothing is done if the frame format is not shared.
+     * The shared frame format is always copied, other connections may still hold it.
+     */
+    void detachFormat();
+
+    /**
+     * @brief Drops the snapshot taken by `shareFormat` after the frame format has changed, the next call takes a new one.
+     */
+    void resetSharedFormat();
+
+    /**
+     * @brief Receives all the complete frames with the resumable parser.
+     *
+     * @param[out] frames A variable that holds the views of the received frames.
+     * @param[in] isWait `true` to wait (up to the timeout) for data if no complete frame is buffered, `false` to only parse the data that has already arrived.
+     * @return 0 on success.
+     * @return 1 if the port is not open.
+     * @return 2 if a timeout occurs or no complete frame is available.
+     * @return 3 if the frame format is not set up.
+     */
+    int receiveFrames(std::vector <FRAME_VIEW_t> &frames, bool isWait);
+
+    /**
+     * @brief Receives all the complete frames with a compiled frame parser.
+     *
+     * @param[out] frames A variable that holds the views of the received frames.
+     * @param[in] parser The frame parser.
+     * @param[in] isWait `true` to wait (up to the timeout) for data if no complete frame is buffered, `false` to only parse the data that has already arrived.
+     * @return 0 on success.
+     * @return 1 if the port is not open.
+     * @return 2 if a timeout occurs or no complete frame is available.
+     * @return 3 if the parser is not set.
+     */
+    int receiveParsedFrames(std::vector <FRAME_VIEW_t> &frames, FRAME_PARSER_t parser, bool isWait);
+
+    /**
+     * @brief Receives one frame in resync mode.
+     *
+     * @return 0 on success.
+     * @return 1 if the port is not open.
+     * @return 2 if a timeout occurs.
+     */
+    int receiveFrameResync();
+
+  protected:
+    /**
+     * @brief Parses one frame from a buffer with the frame format, resuming from the parse state.
+     *
+     * This method runs the parse plan over the buffer without performing any read operation. The data of each field is stored in the frame format
+     * and the execute and post-execute functions are called, the same as `receiveFramedData` does (except for a shared frame format, which is only read). If the buffer ends inside the frame, the parse
+     * state is kept so the next call continues with the field (and the delimiter search) where this one stopped, every field is parsed and every
+     * execute function is called only once per frame.
+     *
+     * @param[in] buffer The buffer that holds the received data.
+     * @param[in] sz The size of the buffer.
+     * @param[in,out] cursor The parse state. When a frame is complete, `begin` and `pos` delimit the frame (the data before the start bytes is skipped).
+     * @return `0` if a complete frame has been parsed.
+     * @return `2` if the buffer does not hold a complete frame yet.
+     * @return `4` if the frame data format is invalid.
+     */
+    int parseFrame(const unsigned char *buffer, size_t sz, PARSE_CURSOR_t &cursor);
+
+    /**
+     * @brief Overloaded method of `sendFramedData` that reports whether the connection still holds the frame after a failed write operation.
+     *
+     * @param[out] isQueued A variable that is set to `true` if (a part of) the frame is held by the output queue or the cork buffer (may be `nullptr`).
+     * @return 0 on success.
+     * @return 1 if the port is not open.
+     * @return 2 if a timeout occurs.
+     * @return 3 if there is no data to send, or if the size of a bound field does not fit in its length field or exceeds its maximum size.
+     */
+    int sendFramedData(bool *isQueued);
+
   public:
     /**
      * @brief Default constructor.
@@ -91,7 +589,7 @@ class SynapSock : public Socket {
      * - Initializes the mutex for thread safety.
      * @param[in] address The address is in the form of an IP address with a size of 4 bytes.
      */
-    SynapSock(const std::vector <unsigned char> address);
+    SynapSock(const std::vector <unsigned char> &address);
 
     /**
      * @brief Overloading of Custom constructor.
@@ -103,7 +601,7 @@ class SynapSock : public Socket {
      * @param[in] address The address is in the form of an IP address with a size of 4 bytes.
      * @param[in] port The port of Socket interface.
      */
-    SynapSock(const std::vector <unsigned char> address, int port);
+    SynapSock(const std::vector <unsigned char> &address, int port);
 
     /**
      * @brief Overloading of Custom constructor.
@@ -139,7 +637,7 @@ class SynapSock : public Socket {
      * - Initializes the mutex for thread safety.
      * @param[in] address The address in the form of an IP address or domain (string).
      */
-    SynapSock(const std::string address);
+    SynapSock(const std::string &address);
 
     /**
      * @brief Overloading of Custom constructor.
@@ -151,7 +649,7 @@ class SynapSock : public Socket {
      * @param[in] address The address in the form of an IP address or domain (string).
      * @param[in] port The port of Socket interface.
      */
-    SynapSock(const std::string address, int port);
+    SynapSock(const std::string &address, int port);
 
     /**
      * @brief Destructor.
@@ -163,12 +661,58 @@ class SynapSock : public Socket {
     /**
      * @brief Retrieves the memory address of the frame format.
      *
-     * This function returns the address of the `frameFormat` data member.
+     * This function returns the address of the `frameFormat` data member. The fields may be modified through this pointer, but fields must only be
+     * added or removed with the operators of this class, so the compiled parse plan stays in sync with the frame format. The parse plan keeps a
+     * copy of the start bytes and stop bytes, so `refreshFormat` must be called after a delimiter has been modified through this pointer (or
+     * through `operator[]`). The fields of a shared frame format (see `shareFormat`) must not be modified.
      *
      * @return The memory address of the `frameFormat`.
      */
     DataFrame *getFormat();
 
+    /**
+     * @brief Compiles the frame format again after its fields have been modified in place.
+     *
+     * The data of the fields is read while sending and receiving, but the start bytes and stop bytes are copied into the parse plan when the frame
+     * format is set. This method must be called after a delimiter has been modified through `getFormat` or `operator[]`, the parse state of a
+     * partially received frame is discarded.
+     */
+    void refreshFormat();
+
+    /**
+     * @brief Shares the frame format of this connection.
+     *
+     * The returned schema is a read-only snapshot of the frame format, it can be given to other connections with `setFormat`, so they parse
+     * with the same fields and parse plan instead of a copy each. This connection keeps its own frame format and parses as before. The snapshot
+     * is taken once and returned again until the frame format of this connection is changed.
+     *
+     * @return the shared frame format (`nullptr` if the frame format is not set up).
+     */
+    SHARED_FORMAT_t shareFormat();
+
+    /**
+     * @brief Uses a shared frame format.
+     *
+     * The frame format is not copied, this connection only keeps the state of the frame being parsed. A shared frame format is read-only:
+     * the fields are not written while parsing (use `getFieldView` to read the received fields) and `receiveFramedData` always resynchronizes
+     * as in resync mode, so the size of a field must be fixed, declared with `setLengthField`, or given by the stop bytes that follow it.
+     * A frame format with an execute function, a post-execute function or a handler is not shared: this connection gets its own copy,
+     * so the functions are called and the fields are written for this connection. Changing the frame format of a connection (with the
+     * operators, `setLengthField`, `setValidator` or a handler) also gives the connection its own copy.
+     *
+     * @param[in] format The shared frame format, returned by `shareFormat`.
+     * @return `0` on success.
+     * @return `1` if the frame format is `nullptr`.
+     */
+    int setFormat(const SHARED_FORMAT_t &format);
+
+    /**
+     * @brief Checks if the frame format is shared with other connections.
+     *
+     * @return `true` if the frame format is shared.
+     */
+    bool isFormatShared();
+
     /**
      * @brief Release and destroy frame format pointer.
      *
@@ -186,11 +730,136 @@ class SynapSock : public Socket {
      */
     void trigInvDataIndicator();
 
+    /**
+     * @brief Sets the resync mode of `receiveFramedData`.
+     *
+     * In resync mode, `receiveFramedData` parses the frames in the receive buffer with the resumable parser. When a frame is invalid, the search
+     * for the start bytes resumes one byte past the start of the invalid frame inside the same buffer, no field data is copied or pushed back
+     * to the remaining buffer, and the method only returns when a valid frame is received or on timeout. The invalid data is counted by
+     * `getSkippedBytes` and `getInvalidFrames`.
+     *
+     * @param[in] isResync `true` to enable the resync mode.
+     */
+    void setResync(bool isResync);
+
+    /**
+     * @brief Gets the resync mode of `receiveFramedData`.
+     *
+     * @return `true` if the resync mode is enabled.
+     */
+    bool getResync();
+
+    /**
+     * @brief Gets the number of bytes discarded by the frame parser (the data before the start bytes and the data of invalid frames).
+     *
+     * The counter is updated by `receiveFramedDataBatch`, `pollFramedData` and by `receiveFramedData` in resync mode.
+     *
+     * @return the number of skipped bytes since the counters were reset.
+     */
+    size_t getSkippedBytes();
+
+    /**
+     * @brief Gets the number of frames rejected by the frame parser (invalid format, length or checksum).
+     *
+     * @return the number of invalid frames since the counters were reset.
+     */
+    size_t getInvalidFrames();
+
+    /**
+     * @brief Resets the skipped bytes and invalid frames counters.
+     */
+    void resetResyncCounters();
+
+    /**
+     * @brief Binds a length field to the field it sizes.
+     *
+     * The length is decoded by the parser while receiving, and the size of the bound field is set from it, so no post-execute function is
+     * needed to size the field. When a frame is sent with `sendFramedData`, the length field is encoded from the size of the bound field.
+     * The size of a fixed-width length field is set to the width of the encoding, a varint length field has a variable size.
+     *
+     * @param[in] lengthIdx The index of the length field in the frame format (usually a `FRAME_TYPE_CONTENT_LENGTH` field).
+     * @param[in] targetIdx The index of the field sized by the length (usually a `FRAME_TYPE_DATA` field), it must come after the length field.
+     * @param[in] encoding The encoding of the length field.
+     * @return `0` on success.
+     * @return `1` if the frame format is not set up or an index is invalid.
+     */
+    int setLengthField(int lengthIdx, int targetIdx, LENGTH_ENCODING_t encoding);
+
+    /**
+     * @brief Overloaded method of `setLengthField` with an adjustment and a maximum size.
+     *
+     * @param[in] lengthIdx The index of the length field in the frame format (usually a `FRAME_TYPE_CONTENT_LENGTH` field).
+     * @param[in] targetIdx The index of the field sized by the length (usually a `FRAME_TYPE_DATA` field), it must come after the length field.
+     * @param[in] encoding The encoding of the length field.
+     * @param[in] adjustment The value added to the decoded length to get the size of the bound field (for example `-2` if the length also counts a 2 bytes checksum).
+     * @param[in] maxSize The maximum size of the bound field, a frame with a larger length is invalid (`0` for no limit).
+     * @return `0` on success.
+     * @return `1` if the frame format is not set up or an index is invalid.
+     */
+    int setLengthField(int lengthIdx, int targetIdx, LENGTH_ENCODING_t encoding, long adjustment, size_t maxSize);
+
+    /**
+     * @brief Declares a built-in checksum validator on the frame format.
+     *
+     * The checksum is computed incrementally over the covered fields as they are parsed (the bytes are not copied), and compared with the
+     * checksum field when it is received. A frame with an invalid checksum is handled as an invalid frame, so no post-execute function is
+     * needed to validate it. When a frame is sent with `sendFramedData`, the checksum field is computed from the covered fields.
+     * The size of the checksum field is set to the size of the checksum, which is stored with the default byte order of the algorithm.
+     *
+     * @param[in] validatorIdx The index of the checksum field in the frame format (usually a `FRAME_TYPE_VALIDATOR` field).
+     * @param[in] beginIdx The index of the first field covered by the checksum.
+     * @param[in] endIdx The index of the last field covered by the checksum, it must come before the checksum field.
+     * @param[in] algorithm The validation algorithm.
+     * @return `0` on success.
+     * @return `1` if the frame format is not set up or an index is invalid.
+     */
+    int setValidator(int validatorIdx, int beginIdx, int endIdx, Checksum::ALGORITHM_t algorithm);
+
+    /**
+     * @brief Overloaded method of `setValidator` with the byte order of the checksum.
+     *
+     * @param[in] validatorIdx The index of the checksum field in the frame format (usually a `FRAME_TYPE_VALIDATOR` field).
+     * @param[in] beginIdx The index of the first field covered by the checksum.
+     * @param[in] endIdx The index of the last field covered by the checksum, it must come before the checksum field.
+     * @param[in] algorithm The validation algorithm.
+     * @param[in] isBigEndian `true` if the checksum is stored big-endian, `false` if it is stored little-endian.
+     * @return `0` on success.
+     * @return `1` if the frame format is not set up or an index is invalid.
+     */
+    int setValidator(int validatorIdx, int beginIdx, int endIdx, Checksum::ALGORITHM_t algorithm, bool isBigEndian);
+
+    /**
+     * @brief Sets the handler that is called before a field of the frame format is parsed.
+     *
+     * The handler (lambda, `std::function` or function object) is stored inline in the compiled frame format without allocation and
+     * replaces the execute function of the field for this connection, so it can carry per-connection state instead of a `void *` parameter.
+     *
+     * @param[in] idx The index of the field in the frame format.
+     * @param[in] func The handler, called with the field (an empty handler restores the execute function of the field).
+     * @return `0` on success.
+     * @return `1` if the frame format is not set up or the index is invalid.
+     */
+    int setExecuteHandler(int idx, const FRAME_HOOK_t &func);
+
+    /**
+     * @brief Sets the handler that is called after a field of the frame format is parsed.
+     *
+     * The handler (lambda, `std::function` or function object) is stored inline in the compiled frame format without allocation and
+     * replaces the post-execute function of the field for this connection, for example to size the next field or to validate the field.
+     *
+     * @param[in] idx The index of the field in the frame format.
+     * @param[in] func The handler, called with the field (an empty handler restores the post-execute function of the field).
+     * @return `0` on success.
+     * @return `1` if the frame format is not set up or the index is invalid.
+     */
+    int setPostExecuteHandler(int idx, const FRAME_HOOK_t &func);
+
     /**
      * @brief Performs socket data receive operations with a custom frame format.
      *
      * This function executes socket data receiving operations using a specific frame format.
      * The receive socket data can be retrieved using the `__Serial::getBuffer__` method.
+     * In resync mode (see `setResync`), or with a shared frame format (see `setFormat`), invalid data is skipped inside the receive buffer and `4` is never returned.
      *
      * @return 0 on success.
      * @return 1 if the port is not open.
@@ -200,18 +869,133 @@ class SynapSock : public Socket {
      */
     int receiveFramedData();
 
+    /**
+     * @brief Receives all the complete frames that are available with a custom frame format.
+     *
+     * This method parses every complete frame in the buffered data in one pass, and only performs a read operation (that reads all the available data at once)
+     * if no complete frame is buffered yet. Invalid data is skipped. An incomplete frame is kept in the remaining buffer and completed by the next call.
+     * The frames are returned as views into the connection buffer, they are only valid until the next receive operation on this connection.
+     * The frame format is used as scratch space while parsing, so use the views to access the data of each frame.
+     *
+     * @param[out] frames A variable that holds the views of the received frames.
+     * @return 0 on success.
+     * @return 1 if the port is not open.
+     * @return 2 if a timeout occurs.
+     * @return 3 if the frame format is not set up.
+     */
+    int receiveFramedDataBatch(std::vector <FRAME_VIEW_t> &frames);
+
+    /**
+     * @brief Overloaded method of `receiveFramedDataBatch` with a compiled frame parser.
+     *
+     * The frames are parsed by `parser` (for example `&Format::parse` of a `FrameDsl::Frame` format) instead of the frame format of this
+     * connection, so the frame format does not need to be set up. Invalid data is skipped and an incomplete frame is kept in the remaining buffer.
+     *
+     * @param[out] frames A variable that holds the views of the received frames.
+     * @param[in] parser The frame parser.
+     * @return 0 on success.
+     * @return 1 if the port is not open.
+     * @return 2 if a timeout occurs.
+     * @return 3 if the parser is not set.
+     */
+    int receiveFramedDataBatch(std::vector <FRAME_VIEW_t> &frames, FRAME_PARSER_t parser);
+
+    /**
+     * @brief Parses the complete frames from the data that has already arrived, without blocking.
+     *
+     * This method is intended for event loops (for example the reception handler of `TCPServer`): it reads the data that is available without waiting,
+     * feeds it to the resumable parser and returns the frames that have been completed. A partial frame keeps its parse state (current field and
+     * delimiter search position) in the connection, so the next call continues where this one stopped instead of parsing the frame again.
+     * The frames are returned as views into the connection buffer, they are only valid until the next receive operation on this connection.
+     *
+     * @param[out] frames A variable that holds the views of the received frames.
+     * @return 0 if at least one frame has been completed.
+     * @return 1 if the port is not open.
+     * @return 2 if no complete frame is available yet.
+     * @return 3 if the frame format is not set up.
+     */
+    int pollFramedData(std::vector <FRAME_VIEW_t> &frames);
+
+    /**
+     * @brief Overloaded method of `pollFramedData` with a compiled frame parser.
+     *
+     * @param[out] frames A variable that holds the views of the received frames.
+     * @param[in] parser The frame parser (for example `&Format::parse` of a `FrameDsl::Frame` format).
+     * @return 0 if at least one frame has been completed.
+     * @return 1 if the port is not open.
+     * @return 2 if no complete frame is available yet.
+     * @return 3 if the parser is not set.
+     */
+    int pollFramedData(std::vector <FRAME_VIEW_t> &frames, FRAME_PARSER_t parser);
+
     /**
      * @brief Performs socket data send operations with a custom frame format.
      *
-     * This function executes socket data send operations using a specific frame format.
+     * This function executes socket data send operations using a specific frame format. Each field of the frame format is sent as a separate
+     * buffer of a single scatter-gather write, the fields are not concatenated into one buffer first.
      *
      * @return 0 on success.
      * @return 1 if the port is not open.
      * @return 2 if a timeout occurs.
-     * @return 3 if there is no data to send.
+     * @return 3 if there is no data to send, or if the size of a bound field does not fit in its length field or exceeds its maximum size.
      */
     int sendFramedData();
 
+    /**
+     * @brief Overloaded method of `sendFramedData` that encodes the frame from the values of its fields.
+     *
+     * The frame is encoded with `FrameSchema::encode` into a buffer of the output buffer pool of this connection and sent with one write, the
+     * fields of the frame format are not modified. Several threads may send frames on the same connection at the same time, as long as the frame
+     * format is not changed meanwhile.
+     *
+     * @param[in] fields The value of every field, indexed as the frame format (see `FrameSchema::encode`).
+     * @param[in] count The number of values, it must be the number of fields of the frame format.
+     * @return 0 on success.
+     * @return 1 if the port is not open.
+     * @return 2 if a timeout occurs.
+     * @return 3 if the frame format is not set up, the number of values is invalid or the size of a bound field does not fit in its length field (or exceeds its maximum size), or if a value does not match its field (a fixed size field with a value of another size, or a delimited field whose value contains its stop bytes).
+     */
+    int sendFramedData(const FieldView *fields, size_t count);
+
+    /**
+     * @brief Encodes a frame from the values of its fields with the frame format of this connection.
+     *
+     * See `FrameSchema::encode`. This method does not modify the connection, it may be called from any thread as long as the frame format is not changed meanwhile.
+     *
+     * @param[in] fields The value of every field, indexed as the frame format.
+     * @param[in] count The number of values, it must be the number of fields of the frame format.
+     * @param[out] buffer A variable that holds the encoded frame.
+     * @return `0` on success.
+     * @return `1` if the frame format is not set up, the number of values is invalid or the size of a bound field does not fit in its length field (or exceeds its maximum size), or if a value does not match its field (a fixed size field with a value of another size, or a delimited field whose value contains its stop bytes).
+     */
+    int encodeFramedData(const FieldView *fields, size_t count, std::vector <unsigned char> &buffer);
+
+    /**
+     * @brief Creates a frame template from the values of its fields with the frame format of this connection.
+     *
+     * The frame is encoded once with `FrameSchema::encode`, then only the patched fields are written for each frame sent with the template.
+     *
+     * @param[out] frame The template.
+     * @param[in] fields The value of every field, indexed as the frame format (see `FrameSchema::encode`).
+     * @param[in] count The number of values, it must be the number of fields of the frame format.
+     * @return `0` on success.
+     * @return `1` if the frame format is not set up, the number of values is invalid or the size of a bound field does not fit in its length field (or exceeds its maximum size), or if a value does not match its field (a fixed size field with a value of another size, or a delimited field whose value contains its stop bytes).
+     */
+    int createFrameTemplate(FrameTemplate &frame, const FieldView *fields, size_t count);
+
+    /**
+     * @brief Overloaded method of `sendFramedData` that sends a frame template.
+     *
+     * The checksum fields of the template are computed again if a covered field has been patched, then the frame is sent with one write.
+     *
+     * @param[in] frame The template, created with `createFrameTemplate`.
+     * @return 0 on success.
+     * @return 1 if the port is not open.
+     * @return 2 if a timeout occurs.
+     * @return 3 if the template has not been created.
+     */
+    int sendFramedData(FrameTemplate &frame);
+
     /**
      * @brief Retrieves a buffer of data receive and stored in the Framed Data within a specified range.
      *
@@ -238,12 +1022,51 @@ class SynapSock : public Socket {
      */
     std::vector <unsigned char> getSpecificBufferAsVector(const DataFrame *begin, const DataFrame *end);
 
+    /**
+     * @brief Gets a view of a field of the last frame received with `receiveFramedData`.
+     *
+     * The view points into the receive buffer, where the frame is stored as one contiguous block, so the field is not copied.
+     * It is only valid until the next receive operation on this connection.
+     *
+     * @param[in] idx The index of the field in the frame format.
+     * @return view of the field (empty if the index is invalid or no frame has been received).
+     */
+    FieldView getFieldView(int idx);
+
+    /**
+     * @brief Overloaded method of `getFieldView` that gets the first field of a type.
+     *
+     * @param[in] type The type of the field.
+     * @return view of the field (empty if the frame format has no field of this type or no frame has been received).
+     */
+    FieldView getFieldView(DataFrame::FRAME_TYPE_t type);
+
+    /**
+     * @brief Gets a view of a range of fields of the last frame received with `receiveFramedData`.
+     *
+     * This is the zero-copy version of `getSpecificBufferAsVector`, the view is only valid until the next receive operation on this connection.
+     *
+     * @param[in] begin The type of the first field of the range.
+     * @param[in] end The type of the last field of the range.
+     * @return view of the fields (empty if a type is not in the frame format, or `end` comes before `begin`).
+     */
+    FieldView getSpecificBufferView(DataFrame::FRAME_TYPE_t begin, DataFrame::FRAME_TYPE_t end);
+
     SynapSock& operator=(const DataFrame &obj);
 
     SynapSock& operator+=(const DataFrame &obj);
 
     SynapSock& operator+(const DataFrame &obj);
 
+    /**
+     * @brief Gets a field of the frame format.
+     *
+     * The field may be modified through the returned pointer (see `getFormat`), `refreshFormat` must be called after its start bytes or stop bytes
+     * have been modified.
+     *
+     * @param[in] idx The index of the field in the frame format.
+     * @return The field (`nullptr` if the index is invalid).
+     */
     DataFrame* operator[](int idx);
 
     DataFrame* operator[](DataFrame::FRAME_TYPE_t type);
@@ -65,10 +65,61 @@
 
 class TCPClient : public SynapSock {
   private:
+    typedef struct _PIPELINE_REQUEST_t {      /*!< request that waits for its response */
+      std::vector <unsigned char> key;        /*!< value of the correlation field of the request (empty if the responses are matched in order) */
+      const void *callbackFunction;           /*!< callback function that is called with the response */
+      void *callbackParam;                    /*!< parameters of the callback function */
+      unsigned long sequence;                 /*!< sequence number of the request */
+      bool isFailed;                          /*!< `true` if the write operation of the request failed after (part of) the request has been queued */
+    } PIPELINE_REQUEST_t;
+
     unsigned char status;             /*!< Socket status */
 #ifdef __STCP_SSL__
     SSLWarper *sslWarper;             /*!< framework to establish TLS/SSL enabled connections (this variable only available if SSL layer mode is activated) */
 #endif
+    std::deque <PIPELINE_REQUEST_t> pendingRequests;  /*!< requests that have been sent and wait for their response, in the order they have been sent */
+    size_t correlationOffset;                         /*!< offset of the correlation field from the first byte of the frame */
+    size_t correlationLength;                         /*!< size of the correlation field (`0` means the responses are matched in order) */
+    std::vector <unsigned char> requestSegment;       /*!< scratch space for the field data of the request frame */
+    std::vector <FRAME_VIEW_t> responseFrames;        /*!< scratch list of the received responses */
+    unsigned long requestSequence;                    /*!< sequence number of the next request */
+    pthread_mutex_t pmtx;                             /*!< locking mechanism for the pending requests */
+    pthread_mutex_t smtx;                             /*!< serializes the registration and the write of the requests */
+
+    /**
+     * @brief Gets the value of the correlation field from the data of the frame format.
+     *
+     * @param[out] key A variable that holds the value of the correlation field.
+     * @return `true` when success.
+     * @return `false` if the frame format is shorter than the correlation field.
+     */
+    bool getFormatCorrelationKey(std::vector <unsigned char> &key);
+
+    /**
+     * @brief Matches a response with its pending request and calls the callback function of the request.
+     *
+     * @param[in] frame The response frame.
+     */
+    void dispatchResponse(const FRAME_VIEW_t &frame);
+
+    /**
+     * @brief Settles a pending request after its write operation.
+     *
+     * A request that is not held by the connection is removed, a request that is (partially) held by the output queue or the cork buffer keeps its
+     * place in the order of the pending requests but is marked as failed.
+     *
+     * @param[in] sequence The sequence number of the request.
+     * @param[in] ret The result of the write operation.
+     * @param[in] isQueued `true` if (a part of) the request is held by the output queue or the cork buffer.
+     */
+    void settleRequest(unsigned long sequence, int ret, bool isQueued);
+
+    /**
+     * @brief Removes all the pipelined requests that wait for their response and calls their callback function with a status.
+     *
+     * @param[in] status The status that is passed to the callback functions.
+     */
+    void failPendingRequests(int status);
 
   protected:
     typedef enum _CLIENT_STATUS_t {   /*!< List of Socket (client) status */
@@ -140,7 +191,7 @@ class TCPClient : public SynapSock {
      * - Initializes the mutex for thread safety.
      * @param[in] address The address is in the form of an IP address with a size of 4 bytes.
      */
-    TCPClient(const std::vector <unsigned char> address);
+    TCPClient(const std::vector <unsigned char> &address);
 
     /**
      * @brief Overloading of Custom constructor.
@@ -153,7 +204,7 @@ class TCPClient : public SynapSock {
      * @param[in] address The address is in the form of an IP address with a size of 4 bytes.
      * @param[in] port The port of TCP/IP interface.
      */
-    TCPClient(const std::vector <unsigned char> address, int port);
+    TCPClient(const std::vector <unsigned char> &address, int port);
 
     /**
      * @brief Overloading of Custom constructor.
@@ -192,7 +243,7 @@ class TCPClient : public SynapSock {
      * - Initializes the mutex for thread safety.
      * @param[in] address The address in the form of an IP address or domain (string).
      */
-    TCPClient(const std::string address);
+    TCPClient(const std::string &address);
 
     /**
      * @brief Overloading of Custom constructor.
@@ -205,7 +256,7 @@ class TCPClient : public SynapSock {
      * @param[in] address The address in the form of an IP address or domain (string).
      * @param[in] port The port of TCP/IP interface.
      */
-    TCPClient(const std::string address, int port);
+    TCPClient(const std::string &address, int port);
 
     /**
      * @brief Destructor.
@@ -246,6 +297,87 @@ class TCPClient : public SynapSock {
     bool initializeSSL();
 #endif
 
+    /**
+     * @brief Sets the correlation field that matches the responses with the pipelined requests.
+     *
+     * By default (`length = 0`) the responses are matched with the pipelined requests in the order the requests have been sent. With a correlation
+     * field, a response is matched with the oldest pending request that has the same value of the `length` bytes at `offset` from the first byte of
+     * the frame, so the server may answer the requests out of order.
+     *
+     * @param[in] offset The offset of the correlation field from the first byte of the frame.
+     * @param[in] length The size of the correlation field (`0` to match the responses in order).
+     */
+    void setPipelineCorrelation(size_t offset, size_t length);
+
+    /**
+     * @brief Sends a framed request without waiting for the response of the previous requests (pipelining).
+     *
+     * The request is a complete frame that has been built by the caller. It is registered as pending and sent immediately, so many requests can
+     * be sent back to back. The response is delivered to `func` by `TCPClient::processResponses`. Requests may be sent from several threads,
+     * the requests are registered and written one at a time so the order of the pending requests is the order on the wire. The pending requests
+     * are not locked during the write, so the responses are still processed while a request is being written. If the write fails, the request is
+     * removed when none of its data is held by the output queue or the cork buffer, otherwise it is marked as failed.
+     *
+     * @param[in] buffer The request frame.
+     * @param[in] sz The size of the request frame.
+     * @param[in] func callback function that has 5 parameters. `TCPClient &` is the connection. `int` is `0` when the response has been received,
+     *                 `1` when the request has been cancelled and `2` when the response has been received for a request whose write operation failed
+     *                 (timeout or partial write) and `3` when the peer has closed the connection before the response has been received.
+     *                 `const unsigned char *` and `size_t` are the response frame (a view into the connection buffer, `nullptr` and `0` when
+     *                 cancelled or closed). `void *` is a pointer that will connect directly to `void *param`.
+     * @param[in] param callback function parameter.
+     * @return `0` if the operation is successful.
+     * @return `1` if the port is not open.
+     * @return `2` if the data write operation fails.
+     * @return `3` if the request is shorter than the correlation field.
+     */
+    int sendRequest(const unsigned char *buffer, size_t sz, void (*func)(TCPClient &, int, const unsigned char *, size_t, void *), void *param);
+
+    /**
+     * @brief Sends the data of the frame format as a pipelined request.
+     *
+     * This method is the same as `TCPClient::sendRequest` but the request is built from the data of the frame format (see `SynapSock::sendFramedData`).
+     *
+     * @param[in] func callback function that is called with the response (see `TCPClient::sendRequest`).
+     * @param[in] param callback function parameter.
+     * @return `0` if the operation is successful.
+     * @return `1` if the port is not open.
+     * @return `2` if the data write operation fails.
+     * @return `3` if there is no data to send, or if the size of a bound field does not fit in its length field or exceeds its maximum size.
+     * @return `4` if the request is shorter than the correlation field.
+     */
+    int sendFramedRequest(void (*func)(TCPClient &, int, const unsigned char *, size_t, void *), void *param);
+
+    /**
+     * @brief Receives the available responses of the pipelined requests and calls the callback function of each request.
+     *
+     * The responses are received with `SynapSock::receiveFramedDataBatch`, so all the complete responses are handled with a single read operation.
+     * A response that does not match any pending request is discarded. The callback functions are called from the calling thread without holding
+     * any lock, they may send new requests but must not receive data from this connection (the response frame is a view into the connection buffer).
+     * When no response is available and the peer has closed the connection, the callback function of every pending request is called with status `3`.
+     *
+     * @return `0` if at least one response has been received.
+     * @return `1` if the port is not open.
+     * @return `2` if a timeout occurs.
+     * @return `3` if the frame format is not set up.
+     * @return `4` if the peer has closed the connection.
+     */
+    int processResponses();
+
+    /**
+     * @brief Gets the number of pipelined requests that wait for their response.
+     *
+     * @return The number of pending requests.
+     */
+    size_t getPendingRequestsSize();
+
+    /**
+     * @brief Cancels all the pipelined requests that wait for their response.
+     *
+     * The callback function of every pending request is called with status `1` (for example after the connection has been lost).
+     */
+    void cancelPendingRequests();
+
     TCPClient& operator=(const DataFrame &obj);
 
     TCPClient& operator+=(const DataFrame &obj);
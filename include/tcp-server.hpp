@@ -78,28 +78,44 @@ class ClientCollection {
 };
 
 class TCPServer : public SynapSock {
+  public:
+    typedef InplaceFunction <void(TCPServer &)> CON_REQ_HANDLER_t;     /*!< connection request handler, called with the server itself */
+    typedef InplaceFunction <void(SynapSock &)> RECEPTION_HANDLER_t;   /*!< reception handler, called with the active connection */
+
   private:
     bool receptionHandlerAsThread;          /*!< mode to choose how the reception handler is run (as a thread or not) */
     unsigned short maxClient;               /*!< maximum number of client (for server) */
+    bool isClientFormatShared;              /*!< `true` if the accepted clients get the frame format of the server */
     SynapSock *client;                      /*!< client pointer that is being processed */
     ClientCollection *clientList;           /*!< a collection of TCP/IP clients that have been accepted by the server */
+    int wakePipe[2];                        /*!< pipe written when a client queues output data, it wakes up `eventCheck` to flush the queue */
     const void *conReqCallbackFunction;     /*!< callback function that is automatically called when there is a connection request event */
     void *conReqCallbackParam;              /*!< parameters of the connection request event callback function */
     const void *receptionCallbackFunction;  /*!< callback function that is automatically called when there is a reception event */
     void *receptionCallbackParam;           /*!< parameters of the reception event callback function */
+    CON_REQ_HANDLER_t conReqHandler;        /*!< handler that is called when there is a connection request event (wraps the callback function) */
+    RECEPTION_HANDLER_t receptionHandler;   /*!< handler that is called when there is a reception event (wraps the callback function) */
 #ifdef __STCP_SSL__
     SSLWarper *sslWarper;                   /*!< framework to establish TLS/SSL enabled connections (this variable only available if SSL layer mode is activated) */
 #endif
 
     /* Set some parent method as private method on TCPServer */
     using SynapSock::getFormat;
+    using SynapSock::refreshFormat;
     using SynapSock::destroyFormat;
     using SynapSock::trigInvDataIndicator;
     using SynapSock::receiveFramedData;
+    using SynapSock::receiveFramedDataBatch;
+    using SynapSock::pollFramedData;
     using SynapSock::sendFramedData;
+    using SynapSock::encodeFramedData;
+    using SynapSock::createFrameTemplate;
     using SynapSock::getSpecificBufferAsVector;
+    using SynapSock::getFieldView;
+    using SynapSock::getSpecificBufferView;
     using Socket::duplicate;
     using Socket::isInputBytesAvailable;
+    using Socket::isPeerClosed;
     using Socket::receiveData;
     using Socket::receiveStartBytes;
     using Socket::receiveUntillStopBytes;
@@ -112,6 +128,14 @@ class TCPServer : public SynapSock {
     using Socket::getRemainingBuffer;
     using Socket::getRemainingBufferAsVector;
     using Socket::sendData;
+    using Socket::sendFile;
+    using Socket::processZeroCopyCompletions;
+    using Socket::getZeroCopyPendingSize;
+    using Socket::flush;
+    using Socket::flushIfDeadlineExpired;
+    using Socket::getCorkTimeLeft;
+    using Socket::flushOutputQueue;
+    using Socket::getOutputQueueSize;
     using Socket::closeConnection;
 
   protected:
@@ -191,7 +215,7 @@ class TCPServer : public SynapSock {
      * - Initializes the mutex for thread safety.
      * @param[in] address The address is in the form of an IP address with a size of 4 bytes.
      */
-    TCPServer(const std::vector <unsigned char> address);
+    TCPServer(const std::vector <unsigned char> &address);
 
     /**
      * @brief Overloading of Custom constructor.
@@ -204,7 +228,7 @@ class TCPServer : public SynapSock {
      * @param[in] address The address is in the form of an IP address with a size of 4 bytes.
      * @param[in] port The port of TCP/IP interface.
      */
-    TCPServer(const std::vector <unsigned char> address, int port);
+    TCPServer(const std::vector <unsigned char> &address, int port);
 
     /**
      * @brief Overloading of Custom constructor.
@@ -243,7 +267,7 @@ class TCPServer : public SynapSock {
      * - Initializes the mutex for thread safety.
      * @param[in] address The address in the form of an IP address or domain (string).
      */
-    TCPServer(const std::string address);
+    TCPServer(const std::string &address);
 
     /**
      * @brief Overloading of Custom constructor.
@@ -256,7 +280,7 @@ class TCPServer : public SynapSock {
      * @param[in] address The address in the form of an IP address or domain (string).
      * @param[in] port The port of TCP/IP interface.
      */
-    TCPServer(const std::string address, int port);
+    TCPServer(const std::string &address, int port);
 
     /**
      * @brief Destructor.
@@ -286,6 +310,23 @@ class TCPServer : public SynapSock {
      */
     int getMaximumClient();
 
+    /**
+     * @brief Shares the frame format of the server with the clients that are accepted afterwards.
+     *
+     * Disabled by default. When enabled, every accepted client gets the frame format of the server with `setFormat`: the clients read one
+     * read-only schema instead of a copy each (see `SynapSock::setFormat`), a frame format with callbacks is still copied for every client.
+     *
+     * @param[in] isShared `true` to share the frame format of the server with the clients.
+     */
+    void setClientFormatSharing(bool isShared);
+
+    /**
+     * @brief Checks if the frame format of the server is shared with the accepted clients.
+     *
+     * @return `true` if the frame format is shared.
+     */
+    bool isClientFormatSharing();
+
     /**
      * @brief Initialize TCP/IP Server connection.
      *
@@ -310,7 +351,10 @@ class TCPServer : public SynapSock {
      *
      * This function attempts to check available event on server side after server has been initialized.
      *
-     * @param[in] timeoutMs maximum waiting time to check event.
+     * The wait also ends when a client queues output data (for example a reply sent from a reception handler thread), so the queue is written without
+     * waiting for the timeout.
+     *
+     * @param[in] timeoutMs maximum waiting time to check event (shortened to the earliest flush deadline of the cork buffers of the clients).
      * @return `EVENT_NONE` when nothing happens
      * @return `EVENT_CONNECT_REQUEST` when there is a connection request from the client side (when receiving this event, the server side needs to call the `acceptNewClient` method)
      * @return `EVENT_BYTES_AVAILABLE` when there is data sent from the client side (to obtain this data, the server needs to call the reception method)
@@ -351,6 +395,16 @@ class TCPServer : public SynapSock {
      */
     void setConnectionRequestHandler(void (*func)(TCPServer &, void *), void *param);
 
+    /**
+     * @brief Overloaded method of `setConnectionRequestHandler` with a callable.
+     *
+     * The callable (lambda, `std::function` or function object) is stored inline without allocation, so it can carry its own state
+     * instead of a `void *` parameter.
+     *
+     * @param[in] func callable that has 1 parameter. `TCP Server &` is an object of the server itself.
+     */
+    void setConnectionRequestHandler(const CON_REQ_HANDLER_t &func);
+
     /**
      * @brief Set handler to receive data sent by remote client.
      *
@@ -372,10 +426,38 @@ class TCPServer : public SynapSock {
      */
     void setReceptionHandler(void (*func)(SynapSock &, void *), void *param);
 
+    /**
+     * @brief Overloaded method of `setReceptionHandler` with a callable.
+     *
+     * This method must be called before socket communication begins (before calling the `eventCheck` method).
+     * The callable (lambda, `std::function` or function object) is stored inline without allocation, so it can carry per-server state
+     * instead of a `void *` parameter.
+     *
+     * @param[in] func callable that has 1 parameter. `SynapSock &` is an active connection.
+     * @param[in] asThread if the given value is true, then the reception handler will run as a thread.
+     */
+    void setReceptionHandler(const RECEPTION_HANDLER_t &func, bool asThread);
+
+    /**
+     * @brief Overloaded method of `setReceptionHandler` with a callable for non-thread operation.
+     *
+     * This method must be called before socket communication begins (before calling the `eventCheck` method).
+     *
+     * @param[in] func callable that has 1 parameter. `SynapSock &` is an active connection.
+     */
+    void setReceptionHandler(const RECEPTION_HANDLER_t &func);
+
+    /**
+     * @brief Retrieves the data reception handler.
+     *
+     * @return copy of the reception handler (empty if no handler is set).
+     */
+    RECEPTION_HANDLER_t getReceptionHandler();
+
     /**
      * @brief Retrieves the pointer address for the data reception handler function.
      *
-     * @return pointer of reception handler function.
+     * @return pointer of reception handler function (`nullptr` if the handler has been set with a callable).
      */
     const void *getReceptionHandlerFunction();
 
@@ -397,7 +479,7 @@ class TCPServer : public SynapSock {
      * @return `true` when success.
      * @return `false` when failed (if the SSL preprocessor is not enabled or SSL handshake is not enabled)
      */
-    bool initializeSSL(const std::string cert, const std::string key);
+    bool initializeSSL(const std::string &cert, const std::string &key);
 #endif
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,97 @@
+/*
+ * $Id: buffer-pool.cpp,v 1.0.0 2026/10/18 09:12:40 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "buffer-pool.hpp"
+
+BufferPool::Storage::Storage(size_t maxBuffers){
+  pthread_mutex_init(&(this->mtx), nullptr);
+  this->maxBuffers = maxBuffers;
+  this->buffers.reserve(maxBuffers);
+}
+
+BufferPool::Storage::~Storage(){
+  for (size_t i = 0; i < this->buffers.size(); i++){
+    delete this->buffers[i];
+  }
+  this->buffers.clear();
+  pthread_mutex_destroy(&(this->mtx));
+}
+
+/**
+ * @brief Default constructor, keeps up to 16 free buffers.
+ */
+BufferPool::BufferPool(){
+  this->storage = std::make_shared<Storage>(16);
+}
+
+/**
+ * @brief Custom constructor.
+ *
+ * @param[in] maxBuffers The maximum number of free buffers kept by the pool, the other released buffers are freed.
+ */
+BufferPool::BufferPool(size_t maxBuffers){
+  this->storage = std::make_shared<Storage>(maxBuffers);
+}
+
+/**
+ * @brief Acquires an empty buffer.
+ *
+ * The buffer keeps the capacity it had when it was released. It goes back to the pool when the last reference is released (from any thread),
+ * the pool may be destroyed before.
+ *
+ * @return the buffer.
+ */
+BufferPool::BUFFER_t BufferPool::acquire(){
+  std::vector <unsigned char> *buffer = nullptr;
+  std::shared_ptr <Storage> pool = this->storage;
+  pthread_mutex_lock(&(pool->mtx));
+  if (!pool->buffers.empty()){
+    buffer = pool->buffers.back();
+    pool->buffers.pop_back();
+  }
+  pthread_mutex_unlock(&(pool->mtx));
+  if (buffer == nullptr) buffer = new std::vector <unsigned char>;
+  /* the buffer holds a reference to the free list, so it can be released after the pool */
+  return BUFFER_t(buffer, [pool](std::vector <unsigned char> *released){
+    released->clear();
+    pthread_mutex_lock(&(pool->mtx));
+    if (pool->buffers.size() < pool->maxBuffers){
+      pool->buffers.push_back(released);
+      released = nullptr;
+    }
+    pthread_mutex_unlock(&(pool->mtx));
+    if (released != nullptr) delete released;
+  });
+}
+
+/**
+ * @brief Gets the number of free buffers of the pool.
+ *
+ * @return the number of free buffers.
+ */
+size_t BufferPool::getFreeCount(){
+  pthread_mutex_lock(&(this->storage->mtx));
+  size_t count = this->storage->buffers.size();
+  pthread_mutex_unlock(&(this->storage->mtx));
+  return count;
+}
@@ -0,0 +1,287 @@
+/*
+ * $Id: byte-search.cpp,v 1.0.0 2026/10/18 09:12:40 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <string.h>
+#include "byte-search.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define __BYTE_SEARCH_X86__
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define __BYTE_SEARCH_NEON__
+#include <arm_neon.h>
+#if !defined(__aarch64__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
+const size_t ByteSearch::NOT_FOUND;
+
+typedef size_t (*searchKernel_t)(const unsigned char *, size_t, const unsigned char *, size_t);
+
+/* verify a candidate position, the first and the last byte has been checked by the caller */
+static inline bool isCandidateMatch(const unsigned char *candidate, const unsigned char *pattern, size_t patternSz){
+  if (patternSz <= 2) return true;
+  return (memcmp(candidate + 1, pattern + 1, patternSz - 2) == 0);
+}
+
+static size_t searchScalar(const unsigned char *buffer, size_t sz, const unsigned char *pattern, size_t patternSz){
+  const unsigned char *crn = buffer;
+  const unsigned char *end = buffer + sz - patternSz + 1;
+  const unsigned char last = pattern[patternSz - 1];
+  while (crn < end){
+    crn = (const unsigned char *) memchr(crn, pattern[0], end - crn);
+    if (crn == nullptr) break;
+    if (crn[patternSz - 1] == last && isCandidateMatch(crn, pattern, patternSz)){
+      return static_cast<size_t>(crn - buffer);
+    }
+    crn++;
+  }
+  return ByteSearch::NOT_FOUND;
+}
+
+#ifdef __BYTE_SEARCH_X86__
+__attribute__((target("sse2")))
+static size_t searchSSE2(const unsigned char *buffer, size_t sz, const unsigned char *pattern, size_t patternSz){
+  const __m128i first = _mm_set1_epi8(static_cast<char>(pattern[0]));
+  const __m128i last = _mm_set1_epi8(static_cast<char>(pattern[patternSz - 1]));
+  size_t i = 0;
+  unsigned int mask = 0;
+  for (i = 0; i + patternSz - 1 + 16 <= sz; i += 16){
+    __m128i blockFirst = _mm_loadu_si128((const __m128i *) (buffer + i));
+    __m128i blockLast = _mm_loadu_si128((const __m128i *) (buffer + i + patternSz - 1));
+    mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast))));
+    while (mask != 0){
+      unsigned int bit = static_cast<unsigned int>(__builtin_ctz(mask));
+      if (isCandidateMatch(buffer + i + bit, pattern, patternSz)) return i + bit;
+      mask &= mask - 1;
+    }
+  }
+  if (i + patternSz > sz) return ByteSearch::NOT_FOUND;
+  size_t result = searchScalar(buffer + i, sz - i, pattern, patternSz);
+  return (result == ByteSearch::NOT_FOUND ? result : result + i);
+}
+
+__attribute__((target("avx2")))
+static size_t searchAVX2(const unsigned char *buffer, size_t sz, const unsigned char *pattern, size_t patternSz){
+  const __m256i first = _mm256_set1_epi8(static_cast<char>(pattern[0]));
+  const __m256i last = _mm256_set1_epi8(static_cast<char>(pattern[patternSz - 1]));
+  size_t i = 0;
+  unsigned int mask = 0;
+  for (i = 0; i + patternSz - 1 + 32 <= sz; i += 32){
+    __m256i blockFirst = _mm256_loadu_si256((const __m256i *) (buffer + i));
+    __m256i blockLast = _mm256_loadu_si256((const __m256i *) (buffer + i + patternSz - 1));
+    mask = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst), _mm256_cmpeq_epi8(last, blockLast))));
+    while (mask != 0){
+      unsigned int bit = static_cast<unsigned int>(__builtin_ctz(mask));
+      if (isCandidateMatch(buffer + i + bit, pattern, patternSz)) return i + bit;
+      mask &= mask - 1;
+    }
+  }
+  if (i + patternSz > sz) return ByteSearch::NOT_FOUND;
+  size_t result = searchSSE2(buffer + i, sz - i, pattern, patternSz);
+  return (result == ByteSearch::NOT_FOUND ? result : result + i);
+}
+#endif
+
+#ifdef __BYTE_SEARCH_NEON__
+static size_t searchNEON(const unsigned char *buffer, size_t sz, const unsigned char *pattern, size_t patternSz){
+  const uint8x16_t first = vdupq_n_u8(pattern[0]);
+  const uint8x16_t last = vdupq_n_u8(pattern[patternSz - 1]);
+  size_t i = 0;
+  uint64_t mask = 0;
+  for (i = 0; i + patternSz - 1 + 16 <= sz; i += 16){
+    uint8x16_t eq = vandq_u8(vceqq_u8(first, vld1q_u8(buffer + i)), vceqq_u8(last, vld1q_u8(buffer + i + patternSz - 1)));
+    /* narrow every byte of the compare result into 4 bits (NEON has no movemask) */
+    mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+    while (mask != 0){
+      unsigned int bit = static_cast<unsigned int>(__builtin_ctzll(mask)) >> 2;
+      if (isCandidateMatch(buffer + i + bit, pattern, patternSz)) return i + bit;
+      mask &= ~(0x0FULL << (bit * 4));
+    }
+  }
+  if (i + patternSz > sz) return ByteSearch::NOT_FOUND;
+  size_t result = searchScalar(buffer + i, sz - i, pattern, patternSz);
+  return (result == ByteSearch::NOT_FOUND ? result : result + i);
+}
+#endif
+
+static searchKernel_t selectKernel(const char **name){
+#if defined(__BYTE_SEARCH_X86__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")){
+    *name = "avx2";
+    return &searchAVX2;
+  }
+  if (__builtin_cpu_supports("sse2")){
+    *name = "sse2";
+    return &searchSSE2;
+  }
+#elif defined(__BYTE_SEARCH_NEON__)
+#if defined(__aarch64__)
+  *name = "neon";
+  return &searchNEON;
+#else
+  if (getauxval(AT_HWCAP) & HWCAP_NEON){
+    *name = "neon";
+    return &searchNEON;
+  }
+#endif
+#endif
+  *name = "scalar";
+  return &searchScalar;
+}
+
+static const char *kernelName = "scalar";
+
+static searchKernel_t getKernel(){
+  static const searchKernel_t kernel = selectKernel(&kernelName);
+  return kernel;
+}
+
+/**
+ * @brief Finds the first occurrence of a byte pattern in a buffer.
+ *
+ * This method searches the buffer for the first position where the whole pattern matches.
+ * An empty pattern always matches at offset 0.
+ *
+ * @param[in] buffer The buffer to be searched.
+ * @param[in] sz The size of the buffer.
+ * @param[in] pattern The byte pattern (delimiter) to be detected.
+ * @param[in] patternSz The size of the byte pattern.
+ * @return offset of the first match in the buffer.
+ * @return `ByteSearch::NOT_FOUND` if the pattern is not found.
+ */
+size_t ByteSearch::find(const unsigned char *buffer, size_t sz, const unsigned char *pattern, size_t patternSz){
+  if (patternSz == 0) return 0;
+  if (buffer == nullptr || sz < patternSz) return ByteSearch::NOT_FOUND;
+  return getKernel()(buffer, sz, pattern, patternSz);
+}
+
+/**
+ * @brief Gets the name of the search kernel selected for the running CPU.
+ *
+ * @return `"avx2"`, `"sse2"`, `"neon"` or `"scalar"`.
+ */
+const char *ByteSearch::getKernelName(){
+  getKernel();
+  return kernelName;
+}
+
+/**
+ * @brief Default constructor.
+ *
+ * This constructor initializes the matcher with an empty pattern and zero partial-match state.
+ */
+ByteMatcher::ByteMatcher(){
+  this->state = 0;
+}
+
+/* advance the KMP automaton by one byte */
+void ByteMatcher::step(unsigned char byte){
+  while (this->state > 0 && this->pattern[this->state] != byte){
+    this->state = this->failure[this->state - 1];
+  }
+  if (this->pattern[this->state] == byte) this->state++;
+}
+
+/**
+ * @brief Sets the byte pattern to be detected.
+ *
+ * The partial-match state is only reset if the pattern differs from the current one, so the same
+ * pattern can be set before every receive operation without losing a match that spans two calls.
+ *
+ * @param[in] pattern The byte pattern (delimiter) to be detected.
+ * @param[in] sz The size of the byte pattern.
+ * @return `true` if the pattern has been changed (and the state reset).
+ * @return `false` if the pattern is the same as the current one.
+ */
+bool ByteMatcher::setPattern(const unsigned char *pattern, size_t sz){
+  size_t i = 0;
+  size_t k = 0;
+  if (sz == this->pattern.size() && (sz == 0 || memcmp(this->pattern.data(), pattern, sz) == 0)){
+    return false;
+  }
+  this->pattern.assign(pattern, pattern + sz);
+  this->failure.assign(sz, 0);
+  for (i = 1; i < sz; i++){
+    while (k > 0 && pattern[i] != pattern[k]) k = this->failure[k - 1];
+    if (pattern[i] == pattern[k]) k++;
+    this->failure[i] = k;
+  }
+  this->state = 0;
+  return true;
+}
+
+/**
+ * @brief Resets the partial-match state.
+ */
+void ByteMatcher::reset(){
+  this->state = 0;
+}
+
+/**
+ * @brief Gets the partial-match state.
+ *
+ * @return number of pattern bytes matched by the tail of the data fed so far.
+ */
+size_t ByteMatcher::getState(){
+  return this->state;
+}
+
+/**
+ * @brief Feeds a chunk of data into the matcher.
+ *
+ * The data is scanned starting from the partial-match state left by the previous chunk, so a pattern
+ * that spans two chunks is detected without re-scanning the previous chunk. The state is reset after
+ * a full match.
+ *
+ * @param[in] buffer The chunk of data.
+ * @param[in] sz The size of the chunk of data.
+ * @return number of bytes of the chunk consumed up to and including the end of the pattern.
+ * @return `ByteSearch::NOT_FOUND` if the pattern end is not in this chunk.
+ */
+size_t ByteMatcher::feed(const unsigned char *buffer, size_t sz){
+  size_t m = this->pattern.size();
+  size_t pos = 0;
+  size_t idx = 0;
+  if (m == 0) return 0;
+  while (pos < sz){
+    if (this->state == 0){
+      /* no partial match pending, let the vectorized search skip ahead */
+      idx = ByteSearch::find(buffer + pos, sz - pos, this->pattern.data(), m);
+      if (idx != ByteSearch::NOT_FOUND) return pos + idx + m;
+      /* only the last (m - 1) bytes can hold the prefix of the next match */
+      if (sz - pos > m - 1) pos = sz - (m - 1);
+      while (pos < sz) this->step(buffer[pos++]);
+      return ByteSearch::NOT_FOUND;
+    }
+    this->step(buffer[pos++]);
+    if (this->state == m){
+      this->state = 0;
+      return pos;
+    }
+  }
+  return ByteSearch::NOT_FOUND;
+}
@@ -0,0 +1,434 @@
+/*
+ * $Id: checksum.cpp,v 1.0.0 2026/10/18 09:12:40 Jaya Wikrama Exp $
+ *
+ * Copyright (c) 2024 Jaya Wikrama
+ * jayawikrama89@gmail.com
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <string.h>
+#include "checksum.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define __CHECKSUM_X86__
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define __CHECKSUM_ARMV8__
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#if defined(__clang__)
+#define __CHECKSUM_ARMV8_TARGET__ __attribute__((target("crc")))
+#else
+#define __CHECKSUM_ARMV8_TARGET__ __attribute__((target("+crc")))
+#endif
+#endif
+
+typedef uint32_t (*crcKernel_t)(uint32_t, const unsigned char *, size_t);
+
+typedef struct _CRC_TABLES_t {
+  uint16_t crc16[8][256];   /*!< CRC16-CCITT (0x1021, not reflected) slice-by-8 tables */
+  uint32_t crc32[8][256];   /*!< CRC32 (0xEDB88320, reflected) slice-by-8 tables */
+  uint32_t crc32c[8][256];  /*!< CRC32C (0x82F63B78, reflected) slice-by-8 tables */
+} CRC_TABLES_t;
+
+static void buildReflectedTables(uint32_t table[8][256], uint32_t poly){
+  uint32_t crc = 0;
+  for (uint32_t n = 0; n < 256; n++){
+    crc = n;
+    for (int i = 0; i < 8; i++) crc = (crc & 1 ? (crc >> 1) ^ poly : crc >> 1);
+    table[0][n] = crc;
+  }
+  /* table[k][n] is the CRC of byte n followed by k zero bytes */
+  for (int k = 1; k < 8; k++){
+    for (uint32_t n = 0; n < 256; n++) table[k][n] = (table[k - 1][n] >> 8) ^ table[0][table[k - 1][n] & 0xFF];
+  }
+}
+
+static const CRC_TABLES_t *buildTables(){
+  static CRC_TABLES_t tables;
+  uint16_t crc = 0;
+  for (uint32_t n = 0; n < 256; n++){
+    crc = static_cast<uint16_t>(n << 8);
+    for (int i = 0; i < 8; i++) crc = static_cast<uint16_t>(crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1);
+    tables.crc16[0][n] = crc;
+  }
+  for (int k = 1; k < 8; k++){
+    for (uint32_t n = 0; n < 256; n++){
+      tables.crc16[k][n] = static_cast<uint16_t>((tables.crc16[k - 1][n] << 8) ^ tables.crc16[0][tables.crc16[k - 1][n] >> 8]);
+    }
+  }
+  buildReflectedTables(tables.crc32, 0xEDB88320);
+  buildReflectedTables(tables.crc32c, 0x82F63B78);
+  return &tables;
+}
+
+static const CRC_TABLES_t &getTables(){
+  static const CRC_TABLES_t *tables = buildTables();
+  return *tables;
+}
+
+/* reflected CRC32 update on the raw (not inverted) register */
+static uint32_t crcSliceBy8(uint32_t crc, const uint32_t table[8][256], const unsigned char *buffer, size_t sz){
+  uint32_t one = 0;
+  uint32_t two = 0;
+  while (sz >= 8){
+    one = crc ^ (static_cast<uint32_t>(buffer[0]) | static_cast<uint32_t>(buffer[1]) << 8 |
+                 static_cast<uint32_t>(buffer[2]) << 16 | static_cast<uint32_t>(buffer[3]) << 24);
+    two = static_cast<uint32_t>(buffer[4]) | static_cast<uint32_t>(buffer[5]) << 8 |
+          static_cast<uint32_t>(buffer[6]) << 16 | static_cast<uint32_t>(buffer[7]) << 24;
+    crc = table[7][one & 0xFF] ^ table[6][(one >> 8) & 0xFF] ^ table[5][(one >> 16) & 0xFF] ^ table[4][one >> 24] ^
+          table[3][two & 0xFF] ^ table[2][(two >> 8) & 0xFF] ^ table[1][(two >> 16) & 0xFF] ^ table[0][two >> 24];
+    buffer += 8;
+    sz -= 8;
+  }
+  while (sz-- > 0) crc = (crc >> 8) ^ table[0][(crc ^ *buffer++) & 0xFF];
+  return crc;
+}
+
+static uint32_t crc32SliceBy8(uint32_t crc, const unsigned char *buffer, size_t sz){
+  return crcSliceBy8(crc, getTables().crc32, buffer, sz);
+}
+
+static uint32_t crc32cSliceBy8(uint32_t crc, const unsigned char *buffer, size_t sz){
+  return crcSliceBy8(crc, getTables().crc32c, buffer, sz);
+}
+
+#ifdef __CHECKSUM_X86__
+/* fold 16 bytes blocks with carry-less multiplication and reduce with Barrett (Intel, "Fast CRC Computation Using PCLMULQDQ"), sz >= 64 and a multiple of 16 */
+__attribute__((target("pclmul,sse4.1")))
+static uint32_t crc32FoldPclmul(uint32_t crc, const unsigned char *buffer, size_t sz){
+  const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596LL, 0x0154442bd4LL);
+  const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009eLL, 0x01751997d0LL);
+  const __m128i k5k0 = _mm_set_epi64x(0x0000000000LL, 0x0163cd6124LL);
+  const __m128i poly = _mm_set_epi64x(0x01f7011641LL, 0x01db710641LL);
+  const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+  __m128i x1, x2, x3, x4, x5, x6, x7, x8;
+  x1 = _mm_loadu_si128((const __m128i *) (buffer + 0x00));
+  x2 = _mm_loadu_si128((const __m128i *) (buffer + 0x10));
+  x3 = _mm_loadu_si128((const __m128i *) (buffer + 0x20));
+  x4 = _mm_loadu_si128((const __m128i *) (buffer + 0x30));
+  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+  buffer += 64;
+  sz -= 64;
+  /* four parallel folds of 64 bytes */
+  while (sz >= 64){
+    x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+    x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+    x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+    x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+    x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+    x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+    x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i *) (buffer + 0x00)));
+    x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i *) (buffer + 0x10)));
+    x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i *) (buffer + 0x20)));
+    x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i *) (buffer + 0x30)));
+    buffer += 64;
+    sz -= 64;
+  }
+  /* fold the four lanes into one */
+  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+  while (sz >= 16){
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i *) buffer)), x5);
+    buffer += 16;
+    sz -= 16;
+  }
+  /* fold 128 bits to 64 bits */
+  x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_and_si128(x1, mask32);
+  x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k5k0, 0x00), x2);
+  /* Barrett reduction to 32 bits */
+  x2 = _mm_and_si128(x1, mask32);
+  x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+  x2 = _mm_and_si128(x2, mask32);
+  x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+  return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+static uint32_t crc32Pclmul(uint32_t crc, const unsigned char *buffer, size_t sz){
+  size_t blocks = 0;
+  if (sz >= 64){
+    blocks = sz & ~static_cast<size_t>(15);
+    crc = crc32FoldPclmul(crc, buffer, blocks);
+    buffer += blocks;
+    sz -= blocks;
+  }
+  return crc32SliceBy8(crc, buffer, sz);
+}
+
+__attribute__((target("sse4.2")))
+static uint32_t crc32cSse42(uint32_t crc, const unsigned char *buffer, size_t sz){
+  uint32_t word = 0;
+#if defined(__x86_64__)
+  uint64_t crc64 = crc;
+  uint64_t dword = 0;
+  while (sz >= 8){
+    memcpy(&dword, buffer, 8);
+    crc64 = _mm_crc32_u64(crc64, dword);
+    buffer += 8;
+    sz -= 8;
+  }
+  crc = static_cast<uint32_t>(crc64);
+#endif
+  while (sz >= 4){
+    memcpy(&word, buffer, 4);
+    crc = _mm_crc32_u32(crc, word);
+    buffer += 4;
+    sz -= 4;
+  }
+  while (sz-- > 0) crc = _mm_crc32_u8(crc, *buffer++);
+  return crc;
+}
+#endif
+
+#ifdef __CHECKSUM_ARMV8__
+__CHECKSUM_ARMV8_TARGET__
+static uint32_t crc32Armv8(uint32_t crc, const unsigned char *buffer, size_t sz){
+  uint64_t dword = 0;
+  while (sz >= 8){
+    memcpy(&dword, buffer, 8);
+    crc = __crc32d(crc, dword);
+    buffer += 8;
+    sz -= 8;
+  }
+  while (sz-- > 0) crc = __crc32b(crc, *buffer++);
+  return crc;
+}
+
+__CHECKSUM_ARMV8_TARGET__
+static uint32_t crc32cArmv8(uint32_t crc, const unsigned char *buffer, size_t sz){
+  uint64_t dword = 0;
+  while (sz >= 8){
+    memcpy(&dword, buffer, 8);
+    crc = __crc32cd(crc, dword);
+    buffer += 8;
+    sz -= 8;
+  }
+  while (sz-- > 0) crc = __crc32cb(crc, *buffer++);
+  return crc;
+}
+
+static bool isArmv8CrcSupported(){
+  return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+}
+#endif
+
+static crcKernel_t selectCrc32Kernel(const char **name){
+#if defined(__CHECKSUM_X86__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1")){
+    *name = "pclmul";
+    return &crc32Pclmul;
+  }
+#elif defined(__CHECKSUM_ARMV8__)
+  if (isArmv8CrcSupported()){
+    *name = "armv8-crc";
+    return &crc32Armv8;
+  }
+#endif
+  *name = "slice-by-8";
+  return &crc32SliceBy8;
+}
+
+static crcKernel_t selectCrc32cKernel(const char **name){
+#if defined(__CHECKSUM_X86__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse4.2")){
+    *name = "sse4.2";
+    return &crc32cSse42;
+  }
+#elif defined(__CHECKSUM_ARMV8__)
+  if (isArmv8CrcSupported()){
+    *name = "armv8-crc";
+    return &crc32cArmv8;
+  }
+#endif
+  *name = "slice-by-8";
+  return &crc32cSliceBy8;
+}
+
+static const char *crc32KernelName = "slice-by-8";
+static const char *crc32cKernelName = "slice-by-8";
+
+static crcKernel_t getCrc32Kernel(){
+  static const crcKernel_t kernel = selectCrc32Kernel(&crc32KernelName);
+  return kernel;
+}
+
+static crcKernel_t getCrc32cKernel(){
+  static const crcKernel_t kernel = selectCrc32cKernel(&crc32cKernelName);
+  return kernel;
+}
+
+/**
+ * @brief Gets the initial value of an algorithm.
+ *
+ * @param[in] algorithm The validation algorithm.
+ * @return the value to be passed to the first `update` of a frame.
+ */
+uint32_t Checksum::init(ALGORITHM_t algorithm){
+  if (algorithm == Checksum::CHECKSUM_CRC16_CCITT_FALSE) return 0xFFFF;
+  return 0;
+}
+
+/**
+ * @brief Updates a checksum with a chunk of data.
+ *
+ * @param[in] algorithm The validation algorithm.
+ * @param[in] value The value returned by `init` or by the previous `update`.
+ * @param[in] buffer The chunk of data.
+ * @param[in] sz The size of the chunk of data.
+ * @return the checksum of all the data processed so far.
+ */
+uint32_t Checksum::update(ALGORITHM_t algorithm, uint32_t value, const unsigned char *buffer, size_t sz){
+  switch (algorithm){
+    case Checksum::CHECKSUM_CRC16_CCITT_FALSE:
+    case Checksum::CHECKSUM_CRC16_XMODEM:
+      return Checksum::crc16Ccitt(static_cast<uint16_t>(value), buffer, sz);
+    case Checksum::CHECKSUM_CRC32:
+      return Checksum::crc32(value, buffer, sz);
+    case Checksum::CHECKSUM_CRC32C:
+      return Checksum::crc32c(value, buffer, sz);
+    case Checksum::CHECKSUM_SUM8:
+      return Checksum::sum8(static_cast<uint8_t>(value), buffer, sz);
+    case Checksum::CHECKSUM_XOR8:
+      return Checksum::xor8(static_cast<uint8_t>(value), buffer, sz);
+  }
+  return value;
+}
+
+/**
+ * @brief Computes the checksum of a buffer.
+ *
+ * @param[in] algorithm The validation algorithm.
+ * @param[in] buffer The buffer.
+ * @param[in] sz The size of the buffer.
+ * @return the checksum of the buffer.
+ */
+uint32_t Checksum::compute(ALGORITHM_t algorithm, const unsigned char *buffer, size_t sz){
+  return Checksum::update(algorithm, Checksum::init(algorithm), buffer, sz);
+}
+
+/**
+ * @brief Updates a CRC16-CCITT (poly 0x1021, not reflected) with a chunk of data.
+ *
+ * @param[in] crc The initial value (`0xFFFF` for CCITT-FALSE, `0x0000` for XMODEM) or the value returned for the previous chunk.
+ * @param[in] buffer The chunk of data.
+ * @param[in] sz The size of the chunk of data.
+ * @return the CRC of all the data processed so far.
+ */
+uint16_t Checksum::crc16Ccitt(uint16_t crc, const unsigned char *buffer, size_t sz){
+  const uint16_t (*table)[256] = getTables().crc16;
+  while (sz >= 8){
+    crc ^= static_cast<uint16_t>(buffer[0] << 8 | buffer[1]);
+    crc = table[7][crc >> 8] ^ table[6][crc & 0xFF] ^ table[5][buffer[2]] ^ table[4][buffer[3]] ^
+          table[3][buffer[4]] ^ table[2][buffer[5]] ^ table[1][buffer[6]] ^ table[0][buffer[7]];
+    buffer += 8;
+    sz -= 8;
+  }
+  while (sz-- > 0) crc = static_cast<uint16_t>((crc << 8) ^ table[0][((crc >> 8) ^ *buffer++) & 0xFF]);
+  return crc;
+}
+
+/**
+ * @brief Updates a CRC32 (ISO-HDLC) with a chunk of data.
+ *
+ * @param[in] crc `0` for the first chunk, or the value returned for the previous chunk.
+ * @param[in] buffer The chunk of data.
+ * @param[in] sz The size of the chunk of data.
+ * @return the CRC of all the data processed so far.
+ */
+uint32_t Checksum::crc32(uint32_t crc, const unsigned char *buffer, size_t sz){
+  if (buffer == nullptr || sz == 0) return crc;
+  return ~getCrc32Kernel()(~crc, buffer, sz);
+}
+
+/**
+ * @brief Updates a CRC32C (Castagnoli) with a chunk of data.
+ *
+ * @param[in] crc `0` for the first chunk, or the value returned for the previous chunk.
+ * @param[in] buffer The chunk of data.
+ * @param[in] sz The size of the chunk of data.
+ * @return the CRC of all the data processed so far.
+ */
+uint32_t Checksum::crc32c(uint32_t crc, const unsigned char *buffer, size_t sz){
+  if (buffer == nullptr || sz == 0) return crc;
+  return ~getCrc32cKernel()(~crc, buffer, sz);
+}
+
+/**
+ * @brief Updates an 8 bits sum with a chunk of data.
+ *
+ * @param[in] sum `0` for the first chunk, or the value returned for the previous chunk.
+ * @param[in] buffer The chunk of data.
+ * @param[in] sz The size of the chunk of data.
+ * @return the sum (modulo 256) of all the data processed so far.
+ */
+uint8_t Checksum::sum8(uint8_t sum, const unsigned char *buffer, size_t sz){
+  unsigned int total = sum;
+  for (size_t i = 0; i < sz; i++) total += buffer[i];
+  return static_cast<uint8_t>(total);
+}
+
+/**
+ * @brief Updates an 8 bits XOR with a chunk of data.
+ *
+ * @param[in] value `0` for the first chunk, or the value returned for the previous chunk.
+ * @param[in] buffer The chunk of data.
+ * @param[in] sz The size of the chunk of data.
+ * @return the XOR of all the data processed so far.
+ */
+uint8_t Checksum::xor8(uint8_t value, const unsigned char *buffer, size_t sz){
+  for (size_t i = 0; i < sz; i++) value ^= buffer[i];
+  return value;
+}
+
+/**
+ * @brief Gets the name of the CRC32 kernel selected for the running CPU.
+ *
+ * @return `"pclmul"`, `"armv8-crc"` or `"slice-by-8"`.
+ */
+const char *Checksum::getCrc32KernelName(){
+  getCrc32Kernel();
+  return crc32KernelName;
+}
+
+/**
+ * @brief Gets the name of the CRC32C kernel selected for the running CPU.
+ *
+ * @return `"sse4.2"`, `"armv8-crc"` or `"slice-by-8"`.
+ */
+const char *Checksum::getCrc32cKernelName(){
+  getCrc32cKernel();
+  return crc32cKernelName;
+}
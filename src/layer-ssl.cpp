@@ -87,7 +87,7 @@ SSL_CTX *SSLWarper::createClientContext(){
  * @param cert A string containing the server's certificate in PEM format.
  * @param key A string containing the server's private key in PEM format.
  */
-void SSLWarper::loadCertificates(const std::string cert, const std::string key){
+void SSLWarper::loadCertificates(const std::string &cert, const std::string &key){
     BIO* bio_cert = BIO_new_mem_buf((void*) cert.c_str(), -1);
     X509* certX = PEM_read_bio_X509(bio_cert, nullptr, 0, nullptr);
     if (!certX || SSL_CTX_use_certificate(this->ctx, certX) <= 0) {
@@ -116,7 +116,7 @@ void SSLWarper::loadCertificates(const std::string cert, const std::string key){
  * @param cert Optional string containing the server's certificate in PEM format. Only used for server.
  * @param key Optional string containing the server's private key in PEM format. Only used for server.
  */
-SSLWarper::SSLWarper(SSLWarper::CONTEXT_TYPE_t type, const std::string cert, const std::string key){
+SSLWarper::SSLWarper(SSLWarper::CONTEXT_TYPE_t type, const std::string &cert, const std::string &key){
     this->init();
     if (type == CTX_TYPE_SERVER){
         this->ctx = this->createServerContext();
@@ -24,7 +24,27 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#include <sys/sendfile.h>
+#include <linux/errqueue.h>
 #include "socket.hpp"
+#include "byte-search.hpp"
+
+std::atomic <size_t> Socket::globalReceiveBudget(0);
+std::atomic <size_t> Socket::globalReceiveUsage(0);
+
+static const size_t SEND_FILE_CHUNK_SIZE = 1048576;
+static const size_t SEND_FILE_SSL_CHUNK_SIZE = 65536;
+
+static bool isDeadlineExpired(const struct timeval *since, unsigned int deadlineMs){
+  struct timeval now;
+  long diffTime = 0;
+  if (deadlineMs == 0) return false;
+  gettimeofday(&now, nullptr);
+  diffTime = (now.tv_sec - since->tv_sec) * 1000 + (now.tv_usec - since->tv_usec) / 1000;
+  return (diffTime >= static_cast<long>(deadlineMs));
+}
 
 static void __TCP(Socket *obj){
   obj->setPort(3000);
@@ -58,6 +78,34 @@ Socket::Socket(){
 #endif
   this->data.clear();
   this->remainingData.clear();
+  this->remainingOffset = 0;
+  this->lineMaxLength = 0;
+  this->isLineDiscarding = false;
+  this->maxFrameSize = 0;
+  this->receiveBufferLimit = 0;
+  this->receiveUsage = 0;
+  this->outputQueueOffset = 0;
+  this->outputQueueSize = 0;
+  this->isNonBlockingSend = false;
+  this->isNoDelay = false;
+  this->isCorked = false;
+  this->corkMaxSize = 16384;
+  this->corkDeadlineMs = 200;
+  memset(&(this->corkSince), 0x00, sizeof(this->corkSince));
+  this->isZeroCopy = false;
+  this->zeroCopyThreshold = 16384;
+  this->zeroCopySeq = 0;
+  this->zeroCopyPendingSize = 0;
+  this->writeHighWatermark = 0;
+  this->writeLowWatermark = 0;
+  this->isWriteBlocked = false;
+  this->pendingWriteEvents.clear();
+  this->writeBlockedCallbackFunction = nullptr;
+  this->writeBlockedCallbackParam = nullptr;
+  this->writeDrainedCallbackFunction = nullptr;
+  this->writeDrainedCallbackParam = nullptr;
+  this->outputQueuedCallbackFunction = nullptr;
+  this->outputQueuedCallbackParam = nullptr;
 }
 
 /**
@@ -99,7 +147,7 @@ Socket::Socket(const unsigned char *address, int port) : Socket::Socket(){
  * - Initializes the mutex for thread safety.
  * @param[in] address The address is in the form of an IP address with a size of 4 bytes.
  */
-Socket::Socket(const std::vector <unsigned char> address) : Socket::Socket(){
+Socket::Socket(const std::vector <unsigned char> &address) : Socket::Socket(){
   this->setAddress(address);
 }
 
@@ -113,7 +161,7 @@ Socket::Socket(const std::vector <unsigned char> address) : Socket::Socket(){
  * @param[in] address The address is in the form of an IP address with a size of 4 bytes.
  * @param[in] port The port of Socket interface.
  */
-Socket::Socket(const std::vector <unsigned char> address, int port) : Socket::Socket(){
+Socket::Socket(const std::vector <unsigned char> &address, int port) : Socket::Socket(){
   this->setAddress(address);
   this->setPort(port);
 }
@@ -157,7 +205,7 @@ Socket::Socket(const char *address, int port) : Socket::Socket(){
  * - Initializes the mutex for thread safety.
  * @param[in] address The address in the form of an IP address or domain (string).
  */
-Socket::Socket(const std::string address) : Socket::Socket(){
+Socket::Socket(const std::string &address) : Socket::Socket(){
   this->setAddress(address);
 }
 
@@ -171,7 +219,7 @@ Socket::Socket(const std::string address) : Socket::Socket(){
  * @param[in] address The address in the form of an IP address or domain (string).
  * @param[in] port The port of Socket interface.
  */
-Socket::Socket(const std::string address, int port) : Socket::Socket(){
+Socket::Socket(const std::string &address, int port) : Socket::Socket(){
   this->setAddress(address);
   this->setPort(port);
 }
@@ -184,6 +232,7 @@ Socket::Socket(const std::string address, int port) : Socket::Socket(){
  */
 Socket::~Socket(){
   this->closeSocket();
+  Socket::globalReceiveUsage -= this->receiveUsage;
 }
 
 /**
@@ -211,7 +260,7 @@ bool Socket::isValidIPAddress(const unsigned char *address){
  * @return `true` when the IP Address is valid
  * @return `false` when the IP Address is invalid
  */
-bool Socket::isValidIPAddress(const std::vector <unsigned char> address){
+bool Socket::isValidIPAddress(const std::vector <unsigned char> &address){
   if (address.size() != 4) return false;
   return this->isValidIPAddress(address.data());
 }
@@ -271,7 +320,7 @@ bool Socket::isValidIPAddress(const char *address){
  * @return `true` when the IP Address is valid
  * @return `false` when the IP Address is invalid
  */
-bool Socket::isValidIPAddress(const std::string address){
+bool Socket::isValidIPAddress(const std::string &address){
   return this->isValidIPAddress(address.c_str());
 }
 
@@ -303,7 +352,7 @@ bool Socket::setAddress(const unsigned char *address){
  * @return `true` when the IP Address is valid
  * @return `false` when the IP Address is invalid
  */
-bool Socket::setAddress(const std::vector <unsigned char> address){
+bool Socket::setAddress(const std::vector <unsigned char> &address){
   if (this->isValidIPAddress(address) == false) return false;
   pthread_mutex_lock(&(this->mtx));
   pthread_mutex_lock(&(this->wmtx));
@@ -322,7 +371,7 @@ bool Socket::setAddress(const std::vector <unsigned char> address){
  * @return `true` when the Address is valid (base on its pattern)
  * @return `false` when the Address is invalid
  */
-bool Socket::setAddress(const std::string address){
+bool Socket::setAddress(const std::string &address){
   return this->setAddress(address.c_str());
 }
 
@@ -440,6 +489,64 @@ bool Socket::setKeepAlive(int keepAliveMs){
   return true;
 }
 
+/**
+ * @brief Sets the maximum line length for the line reader.
+ *
+ * This setter function configures the maximum length (excluding the line terminator) of a line received by `receiveLines`. Longer lines are discarded.
+ *
+ * @param[in] lineMaxLength The maximum line length in bytes, `0` means unlimited.
+ * @return `true` when success.
+ */
+bool Socket::setLineMaxLength(size_t lineMaxLength){
+  pthread_mutex_lock(&(this->mtx));
+  this->lineMaxLength = lineMaxLength;
+  pthread_mutex_unlock(&(this->mtx));
+  return true;
+}
+
+/**
+ * @brief Sets the maximum frame size.
+ *
+ * This setter function configures the maximum size of the data that may be accumulated by `receiveUntillStopBytes` while the stop bytes have not been found.
+ *
+ * @param[in] maxFrameSize The maximum frame size in bytes, `0` means unlimited.
+ * @return `true` when success.
+ */
+bool Socket::setMaxFrameSize(size_t maxFrameSize){
+  pthread_mutex_lock(&(this->mtx));
+  this->maxFrameSize = maxFrameSize;
+  pthread_mutex_unlock(&(this->mtx));
+  return true;
+}
+
+/**
+ * @brief Sets the receive buffer limit of this connection.
+ *
+ * This setter function configures the maximum number of bytes held in the receive buffers of this connection. When the limit is reached, no more data is read from the socket until the buffered data is consumed.
+ *
+ * @param[in] receiveBufferLimit The receive buffer limit in bytes, `0` means unlimited.
+ * @return `true` when success.
+ */
+bool Socket::setReceiveBufferLimit(size_t receiveBufferLimit){
+  pthread_mutex_lock(&(this->mtx));
+  this->receiveBufferLimit = receiveBufferLimit;
+  pthread_mutex_unlock(&(this->mtx));
+  return true;
+}
+
+/**
+ * @brief Sets the process-wide receive budget.
+ *
+ * This setter function configures the maximum number of bytes buffered by all connections. When the budget is exhausted, the connections stop reading from their sockets until buffered data is consumed.
+ *
+ * @param[in] budget The receive budget in bytes, `0` means unlimited.
+ * @return `true` when success.
+ */
+bool Socket::setGlobalReceiveBudget(size_t budget){
+  Socket::globalReceiveBudget = budget;
+  return true;
+}
+
 /**
  * @brief Sets the SSL protection mode (is activated or not).
  *
@@ -529,6 +636,7 @@ bool Socket::setSocketFd(int sockFd){
   pthread_mutex_lock(&(this->mtx));
   pthread_mutex_lock(&(this->wmtx));
   this->sockFd = sockFd;
+  this->applySocketOptions();
   pthread_mutex_unlock(&(this->mtx));
   pthread_mutex_unlock(&(this->wmtx));
   return true;
@@ -595,6 +703,123 @@ int Socket::getKeepAlive(){
   return this->keepAliveMs;
 }
 
+/**
+ * @brief Gets the maximum line length for the line reader.
+ *
+ * @return The maximum line length in bytes (`0` means unlimited).
+ */
+size_t Socket::getLineMaxLength(){
+  return this->lineMaxLength;
+}
+
+/**
+ * @brief Gets the maximum frame size.
+ *
+ * @return The maximum frame size in bytes (`0` means unlimited).
+ */
+size_t Socket::getMaxFrameSize(){
+  return this->maxFrameSize;
+}
+
+/**
+ * @brief Gets the receive buffer limit of this connection.
+ *
+ * @return The receive buffer limit in bytes (`0` means unlimited).
+ */
+size_t Socket::getReceiveBufferLimit(){
+  return this->receiveBufferLimit;
+}
+
+/**
+ * @brief Gets the number of buffered bytes of this connection accounted in the global receive usage.
+ *
+ * @return The number of buffered bytes.
+ */
+size_t Socket::getReceiveUsage(){
+  return this->receiveUsage;
+}
+
+/**
+ * @brief Gets the process-wide receive budget.
+ *
+ * @return The receive budget in bytes (`0` means unlimited).
+ */
+size_t Socket::getGlobalReceiveBudget(){
+  return Socket::globalReceiveBudget;
+}
+
+/**
+ * @brief Gets the number of bytes buffered by all connections.
+ *
+ * @return The number of buffered bytes.
+ */
+size_t Socket::getGlobalReceiveUsage(){
+  return Socket::globalReceiveUsage;
+}
+
+/**
+ * @brief Checks whether the process-wide receive budget has been exhausted.
+ *
+ * @return `true` if the budget is set and exhausted.
+ * @return `false` otherwise.
+ */
+bool Socket::isGlobalReceiveBudgetExhausted(){
+  size_t budget = Socket::globalReceiveBudget;
+  return (budget > 0 && Socket::globalReceiveUsage >= budget);
+}
+
+/**
+ * @brief Updates the global receive usage with the buffered data of this connection.
+ *
+ * The buffered data is the data that has been read from the socket but not delivered yet (the remaining data and the pending stop bytes search data),
+ * and the line buffer that holds the lines returned by `receiveLines` until the next receive operation.
+ */
+void Socket::updateReceiveUsage(){
+  size_t usage = this->remainingData.size() - this->remainingOffset + this->stopBytesPending.size() + this->lineBuffer.size();
+  if (usage == this->receiveUsage) return;
+  if (usage > this->receiveUsage) Socket::globalReceiveUsage += usage - this->receiveUsage;
+  else Socket::globalReceiveUsage -= this->receiveUsage - usage;
+  this->receiveUsage = usage;
+}
+
+/**
+ * @brief Drops the data at the beginning of the remaining buffer that has already been delivered.
+ *
+ * A receive method may deliver the remaining data in place by advancing `remainingOffset` instead of erasing it. The delivered data is removed
+ * once, before the remaining buffer is used by another receive operation.
+ */
+void Socket::compactRemainingData(){
+  if (this->remainingOffset == 0) return;
+  this->remainingData.erase(this->remainingData.begin(), this->remainingData.begin() + this->remainingOffset);
+  this->remainingOffset = 0;
+}
+
+/**
+ * @brief Gets the number of bytes that may still be read from the socket.
+ *
+ * The allowance is limited by the per-connection receive buffer limit and by the global receive budget. When it reaches zero the reading is paused,
+ * the data stays in the kernel socket buffer and TCP flow control pushes back on the peer.
+ *
+ * @param[in] held The number of bytes currently held by this connection.
+ * @return The number of bytes that may be read (`SIZE_MAX` if unlimited).
+ */
+size_t Socket::getReceiveAllowance(size_t held){
+  size_t allowance = SIZE_MAX;
+  size_t budget = Socket::globalReceiveBudget;
+  size_t usage = Socket::globalReceiveUsage;
+  if (this->receiveBufferLimit > 0){
+    allowance = (held < this->receiveBufferLimit ? this->receiveBufferLimit - held : 0);
+  }
+  if (budget > 0){
+    /* the buffered bytes of this connection are already part of the global usage */
+    if (usage >= this->receiveUsage) usage -= this->receiveUsage;
+    usage += held;
+    if (usage >= budget) return 0;
+    if (budget - usage < allowance) allowance = budget - usage;
+  }
+  return allowance;
+}
+
 /**
  * @brief Gets is the SSL handshake active or not.
  *
@@ -693,7 +918,28 @@ bool Socket::duplicate(Socket &obj){
   obj.sslConn = this->sslConn;
 #endif
   obj.data.assign(this->data.begin(), this->data.end());
-  obj.remainingData.assign(this->remainingData.begin(), this->remainingData.end());
+  obj.remainingData.assign(this->remainingData.begin() + this->remainingOffset, this->remainingData.end());
+  obj.remainingOffset = 0;
+  obj.stopBytesPending.assign(this->stopBytesPending.begin(), this->stopBytesPending.end());
+  obj.stopBytesMatcher = this->stopBytesMatcher;
+  obj.lineMaxLength = this->lineMaxLength;
+  obj.maxFrameSize = this->maxFrameSize;
+  obj.receiveBufferLimit = this->receiveBufferLimit;
+  obj.isNoDelay = this->isNoDelay;
+  obj.isCorked = this->isCorked;
+  obj.corkMaxSize = this->corkMaxSize;
+  obj.corkDeadlineMs = this->corkDeadlineMs;
+  obj.isZeroCopy = this->isZeroCopy;
+  obj.zeroCopyThreshold = this->zeroCopyThreshold;
+  obj.writeHighWatermark = this->writeHighWatermark;
+  obj.writeLowWatermark = this->writeLowWatermark;
+  obj.writeBlockedCallbackFunction = this->writeBlockedCallbackFunction;
+  obj.writeBlockedCallbackParam = this->writeBlockedCallbackParam;
+  obj.writeDrainedCallbackFunction = this->writeDrainedCallbackFunction;
+  obj.writeDrainedCallbackParam = this->writeDrainedCallbackParam;
+  obj.outputQueuedCallbackFunction = this->outputQueuedCallbackFunction;
+  obj.outputQueuedCallbackParam = this->outputQueuedCallbackParam;
+  obj.updateReceiveUsage();
   pthread_mutex_unlock(&(this->mtx));
   pthread_mutex_unlock(&(this->wmtx));
   pthread_mutex_unlock(&(obj.mtx));
@@ -720,6 +966,36 @@ bool Socket::isInputBytesAvailable(){
   return (inputBytes > 0 ? true : false);
 }
 
+/**
+ * @brief Checks whether the peer has closed the connection.
+ *
+ * The peer has closed the connection when the socket is readable but the end of the stream is the next thing to read (the check does not
+ * consume any data). The check does not wait, the data that has already been received is read first.
+ *
+ * @return `true` if the peer has closed the connection (or the connection has been reset).
+ * @return `false` if the connection is open or the port is not open.
+ */
+bool Socket::isPeerClosed(){
+  unsigned char tmp = 0;
+  ssize_t bytes = 0;
+  fd_set readfds;
+  struct timeval tvTmout;
+  pthread_mutex_lock(&(this->mtx));
+  if (this->sockFd <= 0){
+    pthread_mutex_unlock(&(this->mtx));
+    return false;
+  }
+  tvTmout.tv_sec = 0;
+  tvTmout.tv_usec = 0;
+  if (this->waitReadable(&readfds, &tvTmout) <= 0 || !FD_ISSET(this->sockFd, &readfds)){
+    pthread_mutex_unlock(&(this->mtx));
+    return false;
+  }
+  bytes = recv(this->sockFd, (void *) &tmp, 1, MSG_PEEK | MSG_DONTWAIT);
+  pthread_mutex_unlock(&(this->mtx));
+  return (bytes == 0 || (bytes < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR));
+}
+
 /**
  * @brief Performs a Socket data receive operation.
  *
@@ -732,6 +1008,7 @@ bool Socket::isInputBytesAvailable(){
  * @return `2` if a timeout occurs.
  */
 int Socket::receiveData(size_t sz, bool dontSplitRemainingData){
+  this->flushCorkBeforeWait();
   pthread_mutex_lock(&(this->mtx));
   if (this->sockFd <= 0){
     pthread_mutex_unlock(&(this->mtx));
@@ -740,19 +1017,27 @@ int Socket::receiveData(size_t sz, bool dontSplitRemainingData){
   ssize_t bytes = 0;
   int idx = 0;
   size_t tmpSz = 0;
+  size_t allowance = 0;
   unsigned char *tmp = nullptr;
   fd_set readfds;
+  this->compactRemainingData();
   this->data.clear();
+  /* the lines returned by receiveLines are only valid until the next receive operation */
+  this->lineBuffer.clear();
   struct timeval tvTmout;
   if (this->remainingData.size() > 0){
     this->data.assign(this->remainingData.begin(), this->remainingData.end());
     this->remainingData.clear();
   }
-  FD_ZERO(&readfds);
-  FD_SET(this->sockFd, &readfds);
+  allowance = this->getReceiveAllowance(this->data.size() + this->stopBytesPending.size());
+  if (allowance == 0){
+    /* receive buffer limit or global budget reached, leave the data in the kernel buffer */
+    goto process;
+  }
+  if (allowance != SIZE_MAX) allowance += this->data.size();
   tvTmout.tv_sec = this->tvTimeout.tv_sec;
   tvTmout.tv_usec = this->tvTimeout.tv_usec;
-  idx = select(this->sockFd + 1, &readfds, nullptr, nullptr, &tvTmout);
+  idx = this->waitReadable(&readfds, &tvTmout);
   if (idx <= 0){
     goto process;
   }
@@ -812,24 +1097,25 @@ int Socket::receiveData(size_t sz, bool dontSplitRemainingData){
         pthread_mutex_unlock(&(this->wmtx));
         return 1;
       }
-      bytes = SSL_read(this->sslConn, (void *) tmp, tmpSz);
+      bytes = SSL_read(this->sslConn, (void *) tmp, (tmpSz < allowance - this->data.size() ? tmpSz : allowance - this->data.size()));
     }
     else {
-      bytes = read(this->sockFd, (void *) tmp, tmpSz);
+      bytes = read(this->sockFd, (void *) tmp, (tmpSz < allowance - this->data.size() ? tmpSz : allowance - this->data.size()));
     }
 #else
-    bytes = read(this->sockFd, (void *) tmp, tmpSz);
+    bytes = read(this->sockFd, (void *) tmp, (tmpSz < allowance - this->data.size() ? tmpSz : allowance - this->data.size()));
 #endif
     if (bytes > 0){
       for (idx = 0; idx < bytes; idx++){
         this->data.push_back(tmp[idx]);
       }
     }
-  } while (bytes > 0 && (sz == 0 || this->data.size() < sz));
+  } while (bytes > 0 && (sz == 0 || this->data.size() < sz) && this->data.size() < allowance);
   delete[] tmp;
   tmp = nullptr;
 process:
   if (this->data.size() == 0){
+    this->updateReceiveUsage();
     pthread_mutex_unlock(&(this->mtx));
     return 2;
   }
@@ -837,6 +1123,7 @@ process:
     this->remainingData.assign(this->data.begin() + sz, this->data.end());
     this->data.erase(this->data.begin() + sz, this->data.end());
   }
+  this->updateReceiveUsage();
   pthread_mutex_unlock(&(this->mtx));
   return 0;
 }
@@ -886,6 +1173,7 @@ int Socket::receiveStartBytes(const unsigned char *startBytes, size_t sz){
   int ret = 0;
   std::vector <unsigned char> tmp;
   bool isRcvFirstBytes = false;
+  this->compactRemainingData();
   do {
     if (this->remainingData.size() > 0){
       this->data.assign(this->remainingData.begin(), this->remainingData.end());
@@ -902,17 +1190,23 @@ int Socket::receiveStartBytes(const unsigned char *startBytes, size_t sz){
       else if (tmp.size() > sz){
         idxCheck = tmp.size() + 1 - sz;
       }
+      else {
+        idxCheck = 0;
+      }
       tmp.insert(tmp.end(), this->data.begin(), this->data.end());
       if (this->remainingData.size() > 0){
         tmp.insert(tmp.end(), this->remainingData.begin(), this->remainingData.end());
         this->remainingData.clear();
       }
       if (tmp.size() >= sz){
-        for (i = idxCheck; i <= tmp.size() - sz; i++){
-          if (memcmp(tmp.data() + i, startBytes, sz) == 0){
-            found = true;
-            break;
-          }
+        i = ByteSearch::find(tmp.data() + idxCheck, tmp.size() - idxCheck, startBytes, sz);
+        if (i != ByteSearch::NOT_FOUND){
+          i += idxCheck;
+          found = true;
+        }
+        else if (this->maxFrameSize > 0 && tmp.size() > this->maxFrameSize){
+          /* the data before the start bytes is discarded anyway, only keep what may hold a prefix of them */
+          tmp.erase(tmp.begin(), tmp.end() - (sz - 1));
         }
       }
     }
@@ -925,6 +1219,7 @@ int Socket::receiveStartBytes(const unsigned char *startBytes, size_t sz){
   else {
     this->data.assign(tmp.begin(), tmp.end());
   }
+  this->updateReceiveUsage();
   return ret;
 }
 
@@ -938,7 +1233,7 @@ int Socket::receiveStartBytes(const unsigned char *startBytes, size_t sz){
  * @return `1` if the port is not open.
  * @return `2` if a timeout occurs.
  */
-int Socket::receiveStartBytes(const std::vector <unsigned char> startBytes){
+int Socket::receiveStartBytes(const std::vector <unsigned char> &startBytes){
   return this->receiveStartBytes(startBytes.data(), startBytes.size());
 }
 
@@ -957,7 +1252,7 @@ int Socket::receiveStartBytes(const char *startBytes){
 }
 
 /**
- * @brief Overloaded method for `receiveStartBytes` with `std::string` input.
+ * @brief Overloaded method for `receiveStartBytes` with `std::string_view` input.
  *
  * This overloaded function performs a Socket data reception operation until the specified start bytes are detected. Any Socket data received before the start bytes are found is automatically discarded. The received Socket data can be accessed using the `Socket::getBuffer` method.
  *
@@ -966,31 +1261,33 @@ int Socket::receiveStartBytes(const char *startBytes){
  * @return `1` if the port is not open.
  * @return `2` if a timeout occurs.
  */
-int Socket::receiveStartBytes(const std::string startBytes){
-  return this->receiveStartBytes((const unsigned char *) startBytes.c_str(), startBytes.length());
+int Socket::receiveStartBytes(std::string_view startBytes){
+  return this->receiveStartBytes((const unsigned char *) startBytes.data(), startBytes.length());
 }
 
 /**
  * @brief Performs a Socket data receiving operation until the specified stop bytes are detected.
  *
  * This function receives Socket data until the specified stop bytes are detected. Any Socket data received up to and including the stop bytes is automatically stored in the buffer. The received Socket data can be accessed using the `Socket::getBuffer` method.
+ * If the stop bytes are not found, the data received so far and the partial-match state are kept pending, so the next call with the same stop bytes resumes the search (including stop bytes that span two reads) instead of starting from scratch and returns the whole data at once. Use `Socket::resetStopBytesMatcher` to discard them.
  *
  * @param[in] stopBytes The data representing the stop bytes to be detected.
  * @param[in] sz The size of the stop bytes data to be detected.
  * @return `0` if the operation is successful.
  * @return `1` if the port is not open.
- * @return `2` if a timeout occurs.
+ * @return `2` if a timeout occurs (the buffer holds the data received so far, it is also kept pending for the next call).
+ * @return `3` if the stop bytes are not found within the maximum frame size (the received data is discarded).
  */
 int Socket::receiveUntillStopBytes(const unsigned char *stopBytes, size_t sz){
-  size_t i = 0;
-  size_t idxCheck = 0;
-  bool found = false;
+  size_t i = ByteSearch::NOT_FOUND;
   int ret = 0;
-  std::vector <unsigned char> tmp;
-  bool isRcvFirstBytes = false;
+  if (this->stopBytesMatcher.setPattern(stopBytes, sz) == true){
+    this->stopBytesPending.clear();
+  }
+  this->compactRemainingData();
   do {
     if (this->remainingData.size() > 0){
-      this->data.assign(this->remainingData.begin(), this->remainingData.end());
+      this->data.swap(this->remainingData);
       this->remainingData.clear();
       ret = 0;
     }
@@ -998,42 +1295,44 @@ int Socket::receiveUntillStopBytes(const unsigned char *stopBytes, size_t sz){
       ret = this->receiveData(sz, true);
     }
     if (!ret){
-      if (isRcvFirstBytes == false){
-        isRcvFirstBytes = true;
-      }
-      else if (tmp.size() > sz){
-        idxCheck = tmp.size() + 1 - sz;
-      }
-      tmp.insert(tmp.end(), this->data.begin(), this->data.end());
-      if (this->remainingData.size() > 0){
-        tmp.insert(tmp.end(), this->remainingData.begin(), this->remainingData.end());
-        this->remainingData.clear();
-      }
-      if (tmp.size() >= sz){
-        for (i = idxCheck; i <= tmp.size() - sz; i++){
-          if (memcmp(tmp.data() + i, stopBytes, sz) == 0){
-            found = true;
-            break;
-          }
+      i = this->stopBytesMatcher.feed(this->data.data(), this->data.size());
+      if (i == ByteSearch::NOT_FOUND){
+        this->stopBytesPending.insert(this->stopBytesPending.end(), this->data.begin(), this->data.end());
+        if (this->maxFrameSize > 0 && this->stopBytesPending.size() > this->maxFrameSize){
+          /* a peer that never sends the stop bytes must not grow the buffer without bound */
+          this->data.clear();
+          this->resetStopBytesMatcher();
+          this->updateReceiveUsage();
+          return 3;
         }
       }
     }
-  } while(found == false && ret == 0);
-  if (tmp.size() < sz){
-    this->data.assign(tmp.begin(), tmp.end());
-    return 2;
+  } while(i == ByteSearch::NOT_FOUND && ret == 0);
+  if (i == ByteSearch::NOT_FOUND){
+    /* keep the pending data and the matcher state, the next call resumes from here (the buffer still shows the data received so far) */
+    this->data.assign(this->stopBytesPending.begin(), this->stopBytesPending.end());
+    this->updateReceiveUsage();
+    if (this->stopBytesPending.size() < sz) return 2;
+    return ret;
   }
-  if (this->data.size() != tmp.size()){
+  if (this->maxFrameSize > 0 && this->stopBytesPending.size() + i > this->maxFrameSize){
+    this->remainingData.assign(this->data.begin() + i, this->data.end());
     this->data.clear();
-    this->data.assign(tmp.begin(), tmp.begin() + i + sz);
-    if (tmp.size() > i + sz) this->remainingData.assign(tmp.begin() + i + sz, tmp.end());
-    return 0;
+    this->resetStopBytesMatcher();
+    this->updateReceiveUsage();
+    return 3;
   }
-  if (this->data.size() > i + sz){
-    this->remainingData.assign(this->data.begin() + i + sz, this->data.end());
-    this->data.erase(this->data.begin() + i + sz, this->data.end());
+  if (this->data.size() > i){
+    this->remainingData.assign(this->data.begin() + i, this->data.end());
+    this->data.erase(this->data.begin() + i, this->data.end());
   }
-  return ret;
+  if (this->stopBytesPending.size() > 0){
+    this->stopBytesPending.insert(this->stopBytesPending.end(), this->data.begin(), this->data.end());
+    this->data.swap(this->stopBytesPending);
+    this->stopBytesPending.clear();
+  }
+  this->updateReceiveUsage();
+  return 0;
 }
 
 /**
@@ -1046,7 +1345,7 @@ int Socket::receiveUntillStopBytes(const unsigned char *stopBytes, size_t sz){
  * @return `1` if the port is not open.
  * @return `2` if a timeout occurs.
  */
-int Socket::receiveUntillStopBytes(const std::vector <unsigned char> stopBytes){
+int Socket::receiveUntillStopBytes(const std::vector <unsigned char> &stopBytes){
   return this->receiveUntillStopBytes(stopBytes.data(), stopBytes.size());
 }
 
@@ -1065,7 +1364,7 @@ int Socket::receiveUntillStopBytes(const char *stopBytes){
 }
 
 /**
- * @brief Overloaded function for `receiveUntillStopBytes` with input as `std::string`.
+ * @brief Overloaded function for `receiveUntillStopBytes` with input as `std::string_view`.
  *
  * This function receives Socket data until the specified stop bytes are detected. Any Socket data received up to and including the stop bytes is automatically stored in the buffer. The received Socket data can be accessed using the `Socket::getBuffer` method.
  *
@@ -1074,8 +1373,27 @@ int Socket::receiveUntillStopBytes(const char *stopBytes){
  * @return `1` if the port is not open.
  * @return `2` if a timeout occurs.
  */
-int Socket::receiveUntillStopBytes(const std::string stopBytes){
-  return this->receiveUntillStopBytes((const unsigned char *) stopBytes.c_str(), stopBytes.length());
+int Socket::receiveUntillStopBytes(std::string_view stopBytes){
+  return this->receiveUntillStopBytes((const unsigned char *) stopBytes.data(), stopBytes.length());
+}
+
+/**
+ * @brief Discards the pending state of `receiveUntillStopBytes`.
+ *
+ * This method discards the data received while the stop bytes have not been found and resets the partial-match state, so the next `receiveUntillStopBytes` call starts from scratch.
+ */
+void Socket::resetStopBytesMatcher(){
+  this->stopBytesPending.clear();
+  this->stopBytesMatcher.reset();
+  this->updateReceiveUsage();
+}
+
+/**
+ * @brief Moves the data kept pending by `receiveUntillStopBytes` into the buffer and resets the partial-match state.
+ */
+void Socket::takeStopBytesPending(){
+  this->data.swap(this->stopBytesPending);
+  this->resetStopBytesMatcher();
 }
 
 /**
@@ -1094,6 +1412,7 @@ int Socket::receiveStopBytes(const unsigned char *stopBytes, size_t sz){
   bool found = false;
   int ret = 0;
   std::vector <unsigned char> tmp;
+  this->compactRemainingData();
   do {
     if (this->remainingData.size() > 0){
       this->data.assign(this->remainingData.begin(), this->remainingData.end());
@@ -1129,12 +1448,14 @@ int Socket::receiveStopBytes(const unsigned char *stopBytes, size_t sz){
     this->data.clear();
     this->data.assign(tmp.begin(), tmp.begin() + sz);
     if (tmp.size() > sz) this->remainingData.assign(tmp.begin() + sz, tmp.end());
+    this->updateReceiveUsage();
     return 0;
   }
   if (this->data.size() > sz){
     this->remainingData.assign(this->data.begin() + sz, this->data.end());
     this->data.erase(this->data.begin() + sz, this->data.end());
   }
+  this->updateReceiveUsage();
   return ret;
 }
 
@@ -1149,7 +1470,7 @@ int Socket::receiveStopBytes(const unsigned char *stopBytes, size_t sz){
  * @return `2` if a timeout occurs.
  * @return `3` if data is received but does not match the specified stop bytes.
  */
-int Socket::receiveStopBytes(const std::vector <unsigned char> stopBytes){
+int Socket::receiveStopBytes(const std::vector <unsigned char> &stopBytes){
   return this->receiveStopBytes(stopBytes.data(), stopBytes.size());
 }
 
@@ -1169,18 +1490,18 @@ int Socket::receiveStopBytes(const char *stopBytes){
 }
 
 /**
- * @brief Function overloading for `receiveStopBytes` with input using `std::string`.
+ * @brief Function overloading for `receiveStopBytes` with input using `std::string_view`.
  *
  * This method performs Socket data reception while simultaneously checking if the data matches the desired stop bytes. The received Socket data can be accessed using the `Socket::getBuffer` method.
  *
- * @param[in] stopBytes A `std::string` object representing the stop bytes to be detected.
+ * @param[in] stopBytes A `std::string_view` representing the stop bytes to be detected (a `std::string` is passed without copying).
  * @return `0` if the operation is successful and the data is valid.
  * @return `1` if the port is not open.
  * @return `2` if a timeout occurs.
  * @return `3` if data is received but does not match the specified stop bytes.
  */
-int Socket::receiveStopBytes(const std::string stopBytes){
-  return this->receiveStopBytes((const unsigned char *) stopBytes.c_str(), stopBytes.length());
+int Socket::receiveStopBytes(std::string_view stopBytes){
+  return this->receiveStopBytes((const unsigned char *) stopBytes.data(), stopBytes.length());
 }
 
 /**
@@ -1199,6 +1520,7 @@ int Socket::receiveNBytes(size_t sz){
   int ret = 0;
   int tryTimes = 0;
   bool isRcvFirstBytes = false;
+  this->compactRemainingData();
   do {
     if (this->remainingData.size() > 0){
       this->data.assign(this->remainingData.begin(), this->remainingData.end());
@@ -1232,86 +1554,331 @@ int Socket::receiveNBytes(size_t sz){
     this->data.clear();
     this->data.assign(tmp.begin(), tmp.begin() + sz);
     if (tmp.size() > sz) this->remainingData.assign(tmp.begin() + sz, tmp.end());
+    this->updateReceiveUsage();
     return 0;
   }
   if (this->data.size() > sz){
     this->remainingData.assign(this->data.begin() + sz, this->data.end());
     this->data.erase(this->data.begin() + sz, this->data.end());
   }
+  this->updateReceiveUsage();
   return 0;
 }
 
 /**
- * @brief Retrieves the amount of successfully received data.
+ * @brief Stores partially received data as the received data buffer.
  *
- * This function retrieves the information about the size of the data that has been successfully received.
- *
- * @return The size of the data in bytes.
+ * @param[in] buffer The partially received data (it may point to the received data buffer itself).
+ * @param[in] sz The size of the partially received data.
  */
-size_t Socket::getDataSize(){
-  return this->data.size();
+void Socket::setPartialData(const unsigned char *buffer, size_t sz){
+  if (buffer == this->data.data()){
+    this->data.resize(sz);
+  }
+  else {
+    this->data.assign(buffer, buffer + sz);
+  }
 }
 
 /**
- * @brief Retrieves the received data buffer.
+ * @brief Performs an exact-length Socket data reception straight into the destination buffer.
  *
- * This function retrieves all the data that has been successfully received by the `receive` method.
+ * This is the fast path for fixed-length fields. The buffered data is used first, then the kernel is asked to wake up the reception only once all the
+ * missing bytes are available (`SO_RCVLOWAT`) and they are read with a single `MSG_WAITALL` read operation. No data beyond the requested size is read.
+ * On timeout, the partially received data can be accessed using the `Socket::getBuffer` method.
  *
- * @param[out] buffer A variable to hold the data that has been successfully received.
- * @param[in] maxBufferSz The maximum size of the data that can be accommodated in the buffer.
- * @return The size of the data received.
+ * @param[out] buffer The destination buffer (at least `sz` bytes).
+ * @param[in] sz The size of the Socket data to be received.
+ * @return `0` if successful.
+ * @return `1` if the port is not open.
+ * @return `2` if a timeout occurs.
  */
-size_t Socket::getBuffer(unsigned char *buffer, size_t maxBufferSz){
+int Socket::receiveNBytes(unsigned char *buffer, size_t sz){
+  size_t received = 0;
+  size_t need = 0;
+  ssize_t bytes = 0;
+  int lowat = 1;
+  int idx = 0;
+  fd_set readfds;
+  struct timeval tvTmout;
+  this->flushCorkBeforeWait();
+  this->compactRemainingData();
+  if (this->remainingData.size() > 0){
+    received = (this->remainingData.size() < sz ? this->remainingData.size() : sz);
+    memcpy(buffer, this->remainingData.data(), received);
+    this->remainingData.erase(this->remainingData.begin(), this->remainingData.begin() + received);
+    this->updateReceiveUsage();
+  }
+  if (received == sz) return 0;
   pthread_mutex_lock(&(this->mtx));
-  size_t result = (this->data.size() < maxBufferSz ? this->data.size() : maxBufferSz);
-  memset(buffer, 0x00, maxBufferSz);
-  if (result > 0) memcpy(buffer, this->data.data(), result);
+  if (this->sockFd <= 0){
+    pthread_mutex_unlock(&(this->mtx));
+    this->setPartialData(buffer, received);
+    return 1;
+  }
+  while (received < sz){
+    need = sz - received;
+    FD_ZERO(&readfds);
+    FD_SET(this->sockFd, &readfds);
+    tvTmout.tv_sec = this->tvTimeout.tv_sec;
+    tvTmout.tv_usec = this->tvTimeout.tv_usec;
+#ifdef __STCP_SSL__
+    if (this->useSSL){
+      /* the record layer hides the byte count from the kernel, fall back to reading straight into the buffer */
+      if (this->sslConn == nullptr) break;
+      if (SSL_pending(this->sslConn) <= 0 && select(this->sockFd + 1, &readfds, nullptr, nullptr, &tvTmout) <= 0) break;
+      bytes = SSL_read(this->sslConn, (void *) (buffer + received), need);
+      if (bytes <= 0) break;
+      received += bytes;
+      continue;
+    }
+#endif
+    /* a low-water mark above the socket buffer size would never be reached, keep it bounded */
+    lowat = (need < 65536 ? static_cast<int>(need) : 65536);
+    if (lowat > 1) setsockopt(this->sockFd, SOL_SOCKET, SO_RCVLOWAT, &lowat, sizeof(lowat));
+    idx = this->waitReadable(&readfds, &tvTmout);
+    if (lowat > 1){
+      int one = 1;
+      setsockopt(this->sockFd, SOL_SOCKET, SO_RCVLOWAT, &one, sizeof(one));
+    }
+    if (idx <= 0) break;
+    bytes = recv(this->sockFd, (void *) (buffer + received), need, (static_cast<size_t>(lowat) == need ? MSG_WAITALL : MSG_DONTWAIT));
+    if (bytes <= 0) break;
+    received += bytes;
+  }
   pthread_mutex_unlock(&(this->mtx));
-  return result;
+  if (received < sz){
+    this->setPartialData(buffer, received);
+    return 2;
+  }
+  return 0;
 }
 
 /**
- * @brief Overloaded method for `getBuffer` with `std::vector<unsigned char>` as the output parameter.
- *
- * Retrieves all the data that has been successfully received by the `receive` method.
+ * @brief Reads all the Socket data that is currently available.
  *
- * This overload allows you to use a `std::vector<unsigned char>` as the buffer to hold the received data.
+ * This method waits (up to the timeout) until the socket is readable and appends all the available data to the buffer with a single read operation.
  *
- * @param[out] buffer A `std::vector<unsigned char>` to hold the received data that has been successfully received.
- * @return The size of the data received.
+ * @param[out] buffer A variable to which the received data is appended.
+ * @return `0` if the operation is successful.
+ * @return `1` if the port is not open.
+ * @return `2` if a timeout occurs.
  */
-size_t Socket::getBuffer(std::vector <unsigned char> &buffer){
-  pthread_mutex_lock(&(this->mtx));
-  buffer.clear();
-  buffer.assign(this->data.begin(), this->data.end());
-  pthread_mutex_unlock(&(this->mtx));
-  return buffer.size();
+int Socket::readAvailableData(std::vector <unsigned char> &buffer){
+  return this->readAvailableData(buffer, true);
 }
 
 /**
- * @brief Retrieves the received data buffer as a vector.
- *
- * This method returns all the data that has been successfully received by the `receive` method as a `std::vector<unsigned char>`.
+ * @brief Overloaded method of `readAvailableData` that can return immediately.
  *
- * @return A `std::vector<unsigned char>` containing the data that has been successfully recieved.
+ * @param[out] buffer A variable to which the received data is appended.
+ * @param[in] isWait `true` to wait (up to the timeout) until the socket is readable, `false` to only read the data that has already arrived.
+ * @return `0` if the operation is successful.
+ * @return `1` if the port is not open.
+ * @return `2` if a timeout occurs or no data is available.
  */
-std::vector <unsigned char> Socket::getBufferAsVector(){
+int Socket::readAvailableData(std::vector <unsigned char> &buffer, bool isWait){
+  if (isWait) this->flushCorkBeforeWait();
   pthread_mutex_lock(&(this->mtx));
-  std::vector <unsigned char> tmp;
-  tmp.assign(this->data.begin(), this->data.end());
+  if (this->sockFd <= 0){
+    pthread_mutex_unlock(&(this->mtx));
+    return 1;
+  }
+  ssize_t bytes = 0;
+  int available = 0;
+  size_t offset = buffer.size();
+  size_t allowance = 0;
+  /* the lines returned by receiveLines are only valid until the next receive operation, when reading into the line buffer it is part of the offset */
+  if (&buffer != &(this->lineBuffer)) this->lineBuffer.clear();
+  /* when reading into the remaining buffer, its undelivered data is part of the offset and the delivered data is dropped by the caller */
+  if (&buffer != &(this->remainingData)) this->compactRemainingData();
+  allowance = this->getReceiveAllowance(offset + (&buffer != &(this->remainingData) ? this->remainingData.size() : 0) + this->stopBytesPending.size());
+  fd_set readfds;
+  struct timeval tvTmout;
+  if (allowance == 0){
+    /* receive buffer limit or global budget reached, leave the data in the kernel buffer */
+    pthread_mutex_unlock(&(this->mtx));
+    return 2;
+  }
+  tvTmout.tv_sec = (isWait ? this->tvTimeout.tv_sec : 0);
+  tvTmout.tv_usec = (isWait ? this->tvTimeout.tv_usec : 0);
+  if (this->waitReadable(&readfds, &tvTmout) <= 0 || !FD_ISSET(this->sockFd, &readfds)){
+    pthread_mutex_unlock(&(this->mtx));
+    return 2;
+  }
+#ifdef __STCP_SSL__
+  if (this->useSSL){
+    if (this->sslConn == nullptr){
+      pthread_mutex_unlock(&(this->mtx));
+      return 1;
+    }
+    /* the decrypted size is unknown before reading, drain the records that are already buffered by SSL */
+    do {
+      available = (allowance < 2048 ? static_cast<int>(allowance) : 2048);
+      buffer.resize(offset + available);
+      bytes = SSL_read(this->sslConn, (void *) (buffer.data() + offset), available);
+      if (bytes > 0){
+        offset += bytes;
+        allowance -= bytes;
+      }
+    } while (bytes > 0 && allowance > 0 && SSL_pending(this->sslConn) > 0);
+    buffer.resize(offset);
+    pthread_mutex_unlock(&(this->mtx));
+    return (offset > 0 && bytes > 0 ? 0 : 2);
+  }
+#endif
+  if (ioctl(this->sockFd, FIONREAD, &available) < 0 || available <= 0){
+    pthread_mutex_unlock(&(this->mtx));
+    return 2;
+  }
+  if (static_cast<size_t>(available) > allowance) available = static_cast<int>(allowance);
+  buffer.resize(offset + available);
+  bytes = read(this->sockFd, (void *) (buffer.data() + offset), available);
+  buffer.resize(offset + (bytes > 0 ? bytes : 0));
   pthread_mutex_unlock(&(this->mtx));
-  return tmp;
+  return (bytes > 0 ? 0 : 2);
 }
 
 /**
- * @brief Retrieves the number of bytes in the remaining buffer.
+ * @brief Performs a line oriented Socket data reception.
  *
- * This method provides the size of the data that is still present in the remaining buffer.
+ * This method receives Socket data until at least one complete line (terminated by LF or CRLF) is available and returns all the complete lines at once, so a burst of lines costs a single read operation.
+ * The lines are returned without the line terminator as views into the connection buffer, they are only valid until the next receive operation on this connection.
+ * An incomplete line is kept in the remaining buffer and completed by the next call. Lines longer than `Socket::getLineMaxLength` are discarded.
  *
- * @return The size of the remaining data in bytes.
- */
+ * @param[out] lines A variable that holds the received lines.
+ * @return `0` if the operation is successful.
+ * @return `1` if the port is not open.
+ * @return `2` if a timeout occurs.
+ * @return `3` if a line exceeding the maximum line length has been discarded (the valid lines are still returned).
+ */
+int Socket::receiveLines(std::vector <std::string_view> &lines){
+  const unsigned char *eol = nullptr;
+  size_t start = 0;
+  size_t scanned = 0;
+  size_t idx = 0;
+  size_t len = 0;
+  bool isOverflow = false;
+  int ret = 0;
+  this->compactRemainingData();
+  lines.clear();
+  /* the incomplete line of the previous call (or data left by other receive methods) comes first */
+  this->lineBuffer.clear();
+  this->lineBuffer.swap(this->remainingData);
+  while (true){
+    while (scanned < this->lineBuffer.size() &&
+           (eol = (const unsigned char *) memchr(this->lineBuffer.data() + scanned, '\n', this->lineBuffer.size() - scanned)) != nullptr
+    ){
+      idx = static_cast<size_t>(eol - this->lineBuffer.data());
+      len = idx - start;
+      if (len > 0 && this->lineBuffer[idx - 1] == '\r') len--;
+      if (this->isLineDiscarding == true){
+        this->isLineDiscarding = false;
+      }
+      else if (this->lineMaxLength > 0 && len > this->lineMaxLength){
+        isOverflow = true;
+      }
+      else {
+        lines.emplace_back((const char *) (this->lineBuffer.data() + start), len);
+      }
+      start = idx + 1;
+      scanned = start;
+    }
+    scanned = this->lineBuffer.size();
+    /* one extra byte is allowed for the CR of a CRLF terminator */
+    if (this->lineMaxLength > 0 && (this->isLineDiscarding == true || scanned - start > this->lineMaxLength + 1)){
+      if (this->isLineDiscarding == false) isOverflow = true;
+      this->isLineDiscarding = true;
+      this->lineBuffer.resize(start);
+      scanned = start;
+    }
+    if (lines.size() > 0 || isOverflow == true) break;
+    /* no line has been referenced yet, so the buffer may grow (and be reallocated) */
+    ret = this->readAvailableData(this->lineBuffer);
+    if (ret != 0) break;
+  }
+  if (this->lineBuffer.size() > start){
+    /* the incomplete line is only kept in the remaining buffer, the line buffer keeps the returned lines (shrinking does not move them) */
+    this->remainingData.assign(this->lineBuffer.begin() + start, this->lineBuffer.end());
+    this->lineBuffer.resize(start);
+  }
+  this->updateReceiveUsage();
+  if (isOverflow == true) return 3;
+  if (lines.size() > 0) return 0;
+  return ret;
+}
+
+/**
+ * @brief Retrieves the amount of successfully received data.
+ *
+ * This function retrieves the information about the size of the data that has been successfully received.
+ *
+ * @return The size of the data in bytes.
+ */
+size_t Socket::getDataSize(){
+  return this->data.size();
+}
+
+/**
+ * @brief Retrieves the received data buffer.
+ *
+ * This function retrieves all the data that has been successfully received by the `receive` method.
+ *
+ * @param[out] buffer A variable to hold the data that has been successfully received.
+ * @param[in] maxBufferSz The maximum size of the data that can be accommodated in the buffer.
+ * @return The size of the data received.
+ */
+size_t Socket::getBuffer(unsigned char *buffer, size_t maxBufferSz){
+  pthread_mutex_lock(&(this->mtx));
+  size_t result = (this->data.size() < maxBufferSz ? this->data.size() : maxBufferSz);
+  memset(buffer, 0x00, maxBufferSz);
+  if (result > 0) memcpy(buffer, this->data.data(), result);
+  pthread_mutex_unlock(&(this->mtx));
+  return result;
+}
+
+/**
+ * @brief Overloaded method for `getBuffer` with `std::vector<unsigned char>` as the output parameter.
+ *
+ * Retrieves all the data that has been successfully received by the `receive` method.
+ *
+ * This overload allows you to use a `std::vector<unsigned char>` as the buffer to hold the received data.
+ *
+ * @param[out] buffer A `std::vector<unsigned char>` to hold the received data that has been successfully received.
+ * @return The size of the data received.
+ */
+size_t Socket::getBuffer(std::vector <unsigned char> &buffer){
+  pthread_mutex_lock(&(this->mtx));
+  buffer.clear();
+  buffer.assign(this->data.begin(), this->data.end());
+  pthread_mutex_unlock(&(this->mtx));
+  return buffer.size();
+}
+
+/**
+ * @brief Retrieves the received data buffer as a vector.
+ *
+ * This method returns all the data that has been successfully received by the `receive` method as a `std::vector<unsigned char>`.
+ *
+ * @return A `std::vector<unsigned char>` containing the data that has been successfully recieved.
+ */
+std::vector <unsigned char> Socket::getBufferAsVector(){
+  pthread_mutex_lock(&(this->mtx));
+  std::vector <unsigned char> tmp;
+  tmp.assign(this->data.begin(), this->data.end());
+  pthread_mutex_unlock(&(this->mtx));
+  return tmp;
+}
+
+/**
+ * @brief Retrieves the number of bytes in the remaining buffer.
+ *
+ * This method provides the size of the data that is still present in the remaining buffer.
+ *
+ * @return The size of the remaining data in bytes.
+ */
 size_t Socket::getRemainingDataSize(){
-  return this->remainingData.size();
+  return this->remainingData.size() - this->remainingOffset;
 }
 
 /**
@@ -1325,8 +1892,9 @@ size_t Socket::getRemainingDataSize(){
  */
 size_t Socket::getRemainingBuffer(unsigned char *buffer, size_t maxBufferSz){
   pthread_mutex_lock(&(this->mtx));
-  size_t result = (this->remainingData.size() < maxBufferSz ? this->remainingData.size() : maxBufferSz);
-  memcpy(buffer, this->remainingData.data(), result);
+  size_t result = this->remainingData.size() - this->remainingOffset;
+  if (result > maxBufferSz) result = maxBufferSz;
+  memcpy(buffer, this->remainingData.data() + this->remainingOffset, result);
   pthread_mutex_unlock(&(this->mtx));
   return result;
 }
@@ -1342,9 +1910,9 @@ size_t Socket::getRemainingBuffer(unsigned char *buffer, size_t maxBufferSz){
 size_t Socket::getRemainingBuffer(std::vector <unsigned char> &buffer){
   pthread_mutex_lock(&(this->mtx));
   buffer.clear();
-  buffer.assign(this->remainingData.begin(), this->remainingData.end());
+  buffer.assign(this->remainingData.begin() + this->remainingOffset, this->remainingData.end());
   pthread_mutex_unlock(&(this->mtx));
-  return this->remainingData.size();
+  return buffer.size();
 }
 
 /**
@@ -1357,145 +1925,1267 @@ size_t Socket::getRemainingBuffer(std::vector <unsigned char> &buffer){
 std::vector <unsigned char> Socket::getRemainingBufferAsVector(){
   pthread_mutex_lock(&(this->mtx));
   std::vector <unsigned char> tmp;
-  tmp.assign(this->remainingData.begin(), this->remainingData.end());
+  tmp.assign(this->remainingData.begin() + this->remainingOffset, this->remainingData.end());
   pthread_mutex_unlock(&(this->mtx));
   return tmp;
 }
 
 /**
- * @brief Performs the operation of sending Socket data.
+ * @brief Writes the queued output data without blocking (the caller must hold `wmtx`).
  *
- * This method sends the specified data to the Socket port.
+ * @return `0` if the output queue is empty.
+ * @return `2` if the data write operation fails.
+ * @return `3` if data is still queued because the socket send buffer is full.
+ */
+int Socket::writeOutputQueue(){
+  ssize_t bytes = 0;
+  while (this->outputQueue.size() > 0){
+    std::vector <unsigned char> &chunk = this->outputQueue.front();
+    bytes = send(this->sockFd, (const void *) (chunk.data() + this->outputQueueOffset), chunk.size() - this->outputQueueOffset, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (bytes < 0){
+      if (errno == EINTR) continue;
+      if (errno == EAGAIN || errno == EWOULDBLOCK) return 3;
+      return 2;
+    }
+    this->outputQueueOffset += bytes;
+    this->outputQueueSize -= bytes;
+    this->updateWriteWatermark();
+    if (this->outputQueueOffset >= chunk.size()){
+      this->outputQueue.pop_front();
+      this->outputQueueOffset = 0;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Queues data behind the output queue, or writes it directly if the queue is empty (the caller must hold `wmtx`).
  *
  * @param[in] buffer Data to be written.
  * @param[in] sz Size of the data to be written.
- * @return `0` if the operation is successful.
- * @return `1` if the port is not open.
+ * @return `0` if the data has been written.
  * @return `2` if the data write operation fails.
+ * @return `3` if (a part of) the data has been queued.
  */
-int Socket::sendData(const unsigned char *buffer, size_t sz){
-  pthread_mutex_lock(&(this->wmtx));
+int Socket::writeOrQueue(const unsigned char *buffer, size_t sz){
   size_t total = 0;
-  struct timeval tv_start;
-  struct timeval tv_crn;
-  int diffTime = 0;
-  if (this->sockFd <= 0){
-    pthread_mutex_unlock(&(this->wmtx));
-    return 1;
+  ssize_t bytes = 0;
+  this->readZeroCopyCompletions();
+  if (this->outputQueueSize > 0 && this->writeOutputQueue() == 2){
+    return 2;
+  }
+  /* keep the byte order, nothing may overtake the queued data */
+  while (this->outputQueueSize == 0 && total < sz){
+    bytes = send(this->sockFd, (const void *) (buffer + total), sz - total, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (bytes < 0){
+      if (errno == EINTR) continue;
+      if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+      return 2;
+    }
+    total += bytes;
+  }
+  if (total < sz){
+    if (this->outputQueueSize == 0 && this->outputQueuedCallbackFunction != nullptr) this->pendingWriteEvents.push_back(3);
+    this->outputQueue.emplace_back(buffer + total, buffer + sz);
+    this->outputQueueSize += sz - total;
+    this->updateWriteWatermark();
+    return 3;
   }
+  return 0;
+}
+
+/**
+ * @brief Overloaded method of `writeOrQueue` that takes the ownership of the data (the caller must hold `wmtx`).
+ *
+ * The part that cannot be written is queued by moving the vector into the output queue, so the data is not copied.
+ *
+ * @param[in] buffer Data to be written.
+ * @return `0` if the data has been written.
+ * @return `2` if the data write operation fails.
+ * @return `3` if (a part of) the data has been queued.
+ */
+int Socket::writeOrQueue(std::vector <unsigned char> &&buffer){
+  size_t total = 0;
   ssize_t bytes = 0;
-  /* check Socket Output Buffer before send any data */
-  gettimeofday(&tv_start, NULL);
-  do {
-    ioctl(this->sockFd, TIOCOUTQ, &bytes);
-    if (bytes > 0){
-      gettimeofday(&tv_crn, NULL);
-      diffTime = (tv_crn.tv_sec - tv_start.tv_sec) * 1000 + (tv_crn.tv_usec - tv_start.tv_usec) / 1000;
-      if (this->tvTimeout.tv_sec > 0 || this->tvTimeout.tv_usec > 0){
-        if (diffTime > (this->tvTimeout.tv_sec * 1000 + this->tvTimeout.tv_usec / 1000)){
-          pthread_mutex_unlock(&(this->wmtx));
-          return 2;
-        }
-      }
-      else {
-        pthread_mutex_unlock(&(this->wmtx));
-        return 2;
-      }
+  this->readZeroCopyCompletions();
+  if (this->outputQueueSize > 0 && this->writeOutputQueue() == 2){
+    return 2;
+  }
+  while (this->outputQueueSize == 0 && total < buffer.size()){
+    bytes = send(this->sockFd, (const void *) (buffer.data() + total), buffer.size() - total, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (bytes < 0){
+      if (errno == EINTR) continue;
+      if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+      return 2;
     }
-  } while (bytes > 0);
-#ifdef __STCP_SSL__
-  if (this->useSSL){
-    if (this->sslConn == nullptr){
-      pthread_mutex_unlock(&(this->wmtx));
-      return 1;
+    total += bytes;
+  }
+  if (total < buffer.size()){
+    /* data has only been written if the queue was empty, the written part is skipped by the offset of the front chunk */
+    if (this->outputQueue.size() == 0) this->outputQueueOffset = total;
+    if (this->outputQueueSize == 0 && this->outputQueuedCallbackFunction != nullptr) this->pendingWriteEvents.push_back(3);
+    this->outputQueueSize += buffer.size() - total;
+    this->outputQueue.push_back(std::move(buffer));
+    this->updateWriteWatermark();
+    return 3;
+  }
+  return 0;
+}
+
+/**
+ * @brief Overloaded method of `writeOrQueue` with input as a list of buffers (the caller must hold `wmtx`).
+ *
+ * The buffers are written with a single `sendmsg` call (per batch of buffers) and the part that cannot be written is queued as one chunk.
+ *
+ * @param[in] iov List of buffers to be written in order.
+ * @param[in] iovcnt Number of buffers in the list.
+ * @return `0` if the data has been written.
+ * @return `2` if the data write operation fails.
+ * @return `3` if (a part of) the data has been queued.
+ */
+int Socket::writeOrQueue(const struct iovec *iov, int iovcnt){
+  struct iovec batch[64];
+  struct msghdr msg;
+  size_t offset = 0;
+  size_t remaining = 0;
+  ssize_t bytes = 0;
+  int idx = 0;
+  int cnt = 0;
+  this->readZeroCopyCompletions();
+  if (this->outputQueueSize > 0 && this->writeOutputQueue() == 2){
+    return 2;
+  }
+  while (this->outputQueueSize == 0 && idx < iovcnt){
+    /* batch the buffers that have not been (fully) written, the first one starts at the partial offset */
+    for (cnt = 0; cnt < (int) (sizeof(batch) / sizeof(batch[0])) && idx + cnt < iovcnt; cnt++){
+      batch[cnt].iov_base = (unsigned char *) iov[idx + cnt].iov_base + (cnt == 0 ? offset : 0);
+      batch[cnt].iov_len = iov[idx + cnt].iov_len - (cnt == 0 ? offset : 0);
     }
-    if (BIO_ctrl_pending(SSL_get_wbio(this->sslConn)) != 0){
-      pthread_mutex_unlock(&(this->wmtx));
+    memset(&msg, 0x00, sizeof(msg));
+    msg.msg_iov = batch;
+    msg.msg_iovlen = cnt;
+    bytes = sendmsg(this->sockFd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (bytes < 0){
+      if (errno == EINTR) continue;
+      if (errno == EAGAIN || errno == EWOULDBLOCK) break;
       return 2;
     }
+    offset += bytes;
+    while (idx < iovcnt && offset >= iov[idx].iov_len){
+      offset -= iov[idx].iov_len;
+      idx++;
+    }
   }
-#endif
-  bytes = 0;
-    /* send data */
-  while (total < sz){
+  if (idx >= iovcnt) return 0;
+  for (int i = idx; i < iovcnt; i++){
+    remaining += iov[i].iov_len;
+  }
+  remaining -= offset;
+  if (this->outputQueueSize == 0 && this->outputQueuedCallbackFunction != nullptr) this->pendingWriteEvents.push_back(3);
+  this->outputQueue.emplace_back();
+  std::vector <unsigned char> &chunk = this->outputQueue.back();
+  chunk.reserve(remaining);
+  for (; idx < iovcnt; idx++){
+    chunk.insert(chunk.end(), (const unsigned char *) iov[idx].iov_base + offset, (const unsigned char *) iov[idx].iov_base + iov[idx].iov_len);
+    offset = 0;
+  }
+  this->outputQueueSize += remaining;
+  this->updateWriteWatermark();
+  return 3;
+}
+
 #ifdef __STCP_SSL__
-    if (this->useSSL){
-      if (this->sslConn == nullptr){
-        pthread_mutex_unlock(&(this->wmtx));
-        return 1;
-      }
-      bytes = SSL_write(this->sslConn, (void *) (buffer + total), sz - total);
+/**
+ * @brief Writes data to the SSL connection, blocking until all data has been written (the caller must hold `wmtx`).
+ *
+ * @param[in] buffer Data to be written.
+ * @param[in] sz Size of the data to be written.
+ * @return `0` if the operation is successful.
+ * @return `2` if the data write operation fails.
+ */
+int Socket::writeSSL(const unsigned char *buffer, size_t sz){
+  size_t total = 0;
+  int bytes = 0;
+  /* the record layer needs the same buffer on a retried write, keep the blocking write for SSL */
+  while (total < sz){
+    bytes = SSL_write(this->sslConn, (const void *) (buffer + total), sz - total);
+    if (bytes <= 0) return 2;
+    total += bytes;
+  }
+  return 0;
+}
+#endif
+
+/**
+ * @brief Waits (up to the timeout) until the output queue has been written (the caller must hold `wmtx`).
+ *
+ * @return `0` if the output queue is empty.
+ * @return `2` if the data write operation fails or a timeout occurs (the data that has not been written stays queued).
+ */
+int Socket::waitOutputQueue(){
+  fd_set writefds;
+  struct timeval tvTmout;
+  int ret = 0;
+  while (this->outputQueueSize > 0){
+    FD_ZERO(&writefds);
+    FD_SET(this->sockFd, &writefds);
+    tvTmout.tv_sec = this->tvTimeout.tv_sec;
+    tvTmout.tv_usec = this->tvTimeout.tv_usec;
+    if (select(this->sockFd + 1, nullptr, &writefds, nullptr, &tvTmout) <= 0){
+      return 2;
     }
-    else {
-      bytes = write(this->sockFd, (void *) (buffer + total), sz - total);
+    ret = this->writeOutputQueue();
+    if (ret == 2) return 2;
+  }
+  return 0;
+}
+
+/**
+ * @brief Checks the output queue size against the watermarks and queues the event to be dispatched (the caller must hold `wmtx`).
+ */
+void Socket::updateWriteWatermark(){
+  if (this->writeHighWatermark == 0) return;
+  if (this->isWriteBlocked == false && this->outputQueueSize >= this->writeHighWatermark){
+    this->isWriteBlocked = true;
+    this->pendingWriteEvents.push_back(1);
+  }
+  else if (this->isWriteBlocked == true && this->outputQueueSize <= this->writeLowWatermark){
+    this->isWriteBlocked = false;
+    this->pendingWriteEvents.push_back(2);
+  }
+}
+
+/**
+ * @brief Calls the write blocked, write drained or output queued handler for every queued write event, in the order of the events (the caller must not hold `wmtx`).
+ */
+void Socket::dispatchWriteWatermark(){
+  unsigned char event = 0;
+  void (*callback)(Socket &, void *) = nullptr;
+  void *param = nullptr;
+  while (true){
+    pthread_mutex_lock(&(this->wmtx));
+    if (this->pendingWriteEvents.size() == 0){
+      pthread_mutex_unlock(&(this->wmtx));
+      return;
     }
-#else
-    bytes = write(this->sockFd, (void *) (buffer + total), sz - total);
-#endif
-    if (bytes > 0){
-      total += bytes;
+    event = this->pendingWriteEvents.front();
+    this->pendingWriteEvents.pop_front();
+    if (event == 1){
+      callback = (void (*)(Socket &, void *)) this->writeBlockedCallbackFunction;
+      param = this->writeBlockedCallbackParam;
+    }
+    else if (event == 2){
+      callback = (void (*)(Socket &, void *)) this->writeDrainedCallbackFunction;
+      param = this->writeDrainedCallbackParam;
     }
     else {
-      pthread_mutex_unlock(&(this->wmtx));
-      return 2;
+      callback = (void (*)(Socket &, void *)) this->outputQueuedCallbackFunction;
+      param = this->outputQueuedCallbackParam;
     }
+    pthread_mutex_unlock(&(this->wmtx));
+    if (callback != nullptr) callback(*this, param);
   }
-  pthread_mutex_unlock(&(this->wmtx));
-  return 0;
 }
 
 /**
- * @brief Method overloading of `sendData` with input as `const std::vector`.
+ * @brief Writes the data coalesced in the cork buffer (the caller must hold `wmtx`).
  *
- * This method sends the specified data to the Socket port. This overload allows the data to be passed as a `const std::vector`.
+ * The data is written the same way as `sendData` does (including waiting for the output queue in the default send mode).
  *
- * @param[in] buffer Data to be written.
  * @return `0` if the operation is successful.
- * @return `1` if the port is not open.
- * @return `2` if the data write operation fails.
+ * @return `2` if the data write operation fails, or if it has to be tried again (the data that has not been written or queued stays in the
+ * cork buffer and is written by the next flush).
  */
-int Socket::sendData(const std::vector <unsigned char> buffer){
-  return this->sendData(buffer.data(), buffer.size());
+int Socket::writeCorkBuffer(){
+  int ret = 0;
+  if (this->corkBuffer.size() == 0) return 0;
+#ifdef __STCP_SSL__
+  if (this->useSSL){
+    if (this->sslConn == nullptr || BIO_ctrl_pending(SSL_get_wbio(this->sslConn)) != 0){
+      return 2;
+    }
+    ret = this->writeSSL(this->corkBuffer.data(), this->corkBuffer.size());
+    if (ret == 0) this->corkBuffer.clear();
+    return ret;
+  }
+#endif
+  /* the vector is only moved into the output queue if a part of it cannot be written, it is left untouched on failure */
+  ret = this->writeOrQueue(std::move(this->corkBuffer));
+  if (ret == 2) return ret;
+  this->corkBuffer.clear();
+  return (this->isNonBlockingSend ? 0 : this->waitOutputQueue());
 }
 
 /**
- * @brief Method overloading of `sendData` with input as `const char*`.
+ * @brief Flushes the cork buffer before a receive operation waits for the peer (the caller must not hold `mtx` or `wmtx`).
  *
- * This method sends the specified data to the Socket port. This overload allows the data to be passed as a `const char*`.
- *
- * @param[in] buffer Data to be written.
- * @return `0` if the operation is successful.
- * @return `1` if the port is not open.
- * @return `2` if the data write operation fails.
+ * The peer usually waits for the corked data (for example a request) before it answers, so the data is not left in the cork buffer until the deadline.
  */
-int Socket::sendData(const char *buffer){
-  return this->sendData((const unsigned char *) buffer, strlen(buffer));
+void Socket::flushCorkBeforeWait(){
+  pthread_mutex_lock(&(this->wmtx));
+  if (this->sockFd <= 0 || this->corkBuffer.size() == 0){
+    pthread_mutex_unlock(&(this->wmtx));
+    return;
+  }
+  this->writeCorkBuffer();
+  pthread_mutex_unlock(&(this->wmtx));
+  this->dispatchWriteWatermark();
+}
+
+/**
+ * @brief Applies the `TCP_NODELAY` and `SO_ZEROCOPY` options to the socket (the caller must hold `wmtx`).
+ */
+void Socket::applySocketOptions(){
+  int value = (this->isNoDelay ? 1 : 0);
+  if (this->sockFd <= 0) return;
+  setsockopt(this->sockFd, IPPROTO_TCP, TCP_NODELAY, &value, sizeof(value));
+  this->zeroCopySeq = 0;
+  if (this->isZeroCopy){
+    value = 1;
+    /* without SO_ZEROCOPY the kernel copies silently and never sends a completion, so keep the copy path */
+    if (setsockopt(this->sockFd, SOL_SOCKET, SO_ZEROCOPY, &value, sizeof(value)) != 0){
+      this->isZeroCopy = false;
+    }
+  }
 }
 
 /**
- * @brief Method overloading of `sendData` with input as `const std::string`.
+ * @brief Waits (up to the given time) until the socket is readable (the caller must hold `mtx`).
  *
- * This method sends the specified data to the Socket port. This overload allows the data to be passed as a `const std::string`.
+ * A zero-copy completion on the socket error queue also wakes up `select`. Those wake-ups are consumed here and the wait goes on with the
+ * remaining time.
  *
- * @param[in] buffer Data to be written.
- * @return `0` if the operation is successful.
- * @return `1` if the port is not open.
- * @return `2` if the data write operation fails.
+ * @param[out] readfds The set of file descriptors filled by `select`.
+ * @param[in,out] tvTmout The maximum waiting time, updated to the remaining time.
+ * @return The return value of `select`.
  */
-int Socket::sendData(const std::string buffer){
-  return this->sendData((const unsigned char *) buffer.c_str(), buffer.length());
+int Socket::waitReadable(fd_set *readfds, struct timeval *tvTmout){
+  int ret = 0;
+  int completions = 0;
+  do {
+    FD_ZERO(readfds);
+    FD_SET(this->sockFd, readfds);
+    ret = select(this->sockFd + 1, readfds, nullptr, nullptr, tvTmout);
+    if (ret <= 0 || this->zeroCopySeq == 0) return ret;
+    pthread_mutex_lock(&(this->wmtx));
+    completions = this->readZeroCopyCompletions();
+    pthread_mutex_unlock(&(this->wmtx));
+  } while (completions > 0);
+  return ret;
 }
 
 /**
- * @brief Closes the Socket connection between client and server.
+ * @brief Reads the `MSG_ZEROCOPY` completion notifications from the socket error queue and releases the completed buffers (the caller must hold `wmtx`).
  *
- * This function is used to close the currently Socket connection between client and server,
- * ensuring that the port is no longer in use and that any associated system resources
- * are released.
+ * @return The number of completion notifications that have been read.
  */
-void Socket::closeConnection(){
+int Socket::readZeroCopyCompletions(){
+  struct msghdr msg;
+  struct cmsghdr *cmsg = nullptr;
+  struct sock_extended_err *serr = nullptr;
+  char control[128];
+  int count = 0;
+  /* drain the error queue even if no buffer is pending, a late completion would otherwise stay queued and keep waking up select */
+  if (this->zeroCopySeq == 0 || this->sockFd <= 0) return 0;
+  while (true){
+    memset(&msg, 0x00, sizeof(msg));
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (recvmsg(this->sockFd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0){
+      if (errno == EINTR) continue;
+      break;
+    }
+    for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)){
+      if (!(cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) && !(cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)){
+        continue;
+      }
+      serr = (struct sock_extended_err *) CMSG_DATA(cmsg);
+      if (serr->ee_errno != 0 || serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY) continue;
+      count++;
+      /* [ee_info, ee_data] is the range of completed send calls, TCP completes them in order */
+      while (this->zeroCopyPending.size() > 0 && static_cast<int32_t>(this->zeroCopyPending.front().first - serr->ee_data) <= 0){
+        this->zeroCopyPendingSize -= this->zeroCopyPending.front().second->size();
+        this->zeroCopyPending.pop_front();
+      }
+    }
+  }
+  return count;
+}
+
+/**
+ * @brief Performs the operation of sending Socket data.
+ *
+ * This method writes as much data as the socket accepts without blocking and queues the rest. In the default (blocking) send mode the method then waits
+ * (up to the timeout) until the queued data has been written. In non-blocking send mode the method returns immediately and the queued data is written
+ * by `Socket::flushOutputQueue` when the socket becomes writable (the `TCPServer` event loop does this for its clients).
+ *
+ * @param[in] buffer Data to be written.
+ * @param[in] sz Size of the data to be written.
+ * @return `0` if the operation is successful.
+ * @return `1` if the port is not open.
+ * @return `2` if the data write operation fails.
+ */
+int Socket::sendData(const unsigned char *buffer, size_t sz){
+  pthread_mutex_lock(&(this->wmtx));
+  int ret = 0;
+  if (this->sockFd <= 0){
+    pthread_mutex_unlock(&(this->wmtx));
+    return 1;
+  }
+  if (this->isCorked){
+    if (this->corkBuffer.size() == 0) gettimeofday(&(this->corkSince), nullptr);
+    this->corkBuffer.insert(this->corkBuffer.end(), buffer, buffer + sz);
+    if (this->corkBuffer.size() >= this->corkMaxSize || isDeadlineExpired(&(this->corkSince), this->corkDeadlineMs)){
+      ret = this->writeCorkBuffer();
+    }
+    pthread_mutex_unlock(&(this->wmtx));
+    this->dispatchWriteWatermark();
+    return ret;
+  }
+#ifdef __STCP_SSL__
+  if (this->useSSL){
+    if (this->sslConn == nullptr){
+      pthread_mutex_unlock(&(this->wmtx));
+      return 1;
+    }
+    if (BIO_ctrl_pending(SSL_get_wbio(this->sslConn)) != 0){
+      pthread_mutex_unlock(&(this->wmtx));
+      return 2;
+    }
+    ret = this->writeSSL(buffer, sz);
+    pthread_mutex_unlock(&(this->wmtx));
+    this->dispatchWriteWatermark();
+    return ret;
+  }
+#endif
+  ret = this->writeOrQueue(buffer, sz);
+  if (ret != 2){
+    ret = (this->isNonBlockingSend ? 0 : this->waitOutputQueue());
+  }
+  pthread_mutex_unlock(&(this->wmtx));
+  this->dispatchWriteWatermark();
+  return ret;
+}
+
+/**
+ * @brief Method overloading of `sendData` with input as a list of buffers (scatter-gather).
+ *
+ * This method sends the buffers in order as one continuous byte stream without concatenating them first. Plain sockets write the list with `sendmsg`
+ * (the same send mode and output queue rules as `sendData` apply). SSL connections pack small buffers into records of up to 16 KB and write large
+ * buffers directly.
+ *
+ * @param[in] iov List of buffers to be written in order.
+ * @param[in] iovcnt Number of buffers in the list.
+ * @return `0` if the operation is successful.
+ * @return `1` if the port is not open.
+ * @return `2` if the data write operation fails.
+ */
+int Socket::sendData(const struct iovec *iov, int iovcnt){
+  return this->sendData(iov, iovcnt, nullptr);
+}
+
+/**
+ * @brief Overloaded method of `sendData` with input as a list of buffers that reports whether the connection still holds the data.
+ *
+ * When the write operation fails, the data of this call may already be held by the output queue or the cork buffer (it is written later)
+ * or it may have been discarded. `isQueued` tells the two cases apart, the size of the output queue does not (it may only hold older data).
+ *
+ * @param[in] iov List of buffers to be written in order.
+ * @param[in] iovcnt Number of buffers in the list.
+ * @param[out] isQueued A variable that is set to `true` if (a part of) the data is held by the output queue or the cork buffer (may be `nullptr`).
+ * @return `0` if the operation is successful.
+ * @return `1` if the port is not open.
+ * @return `2` if the data write operation fails.
+ */
+int Socket::sendData(const struct iovec *iov, int iovcnt, bool *isQueued){
+  pthread_mutex_lock(&(this->wmtx));
+  int ret = 0;
+  if (isQueued != nullptr) *isQueued = false;
+  if (this->sockFd <= 0){
+    pthread_mutex_unlock(&(this->wmtx));
+    return 1;
+  }
+  if (this->isCorked){
+    /* the cork buffer keeps the data until it has been written or queued */
+    if (isQueued != nullptr) *isQueued = true;
+    if (this->corkBuffer.size() == 0) gettimeofday(&(this->corkSince), nullptr);
+    for (int i = 0; i < iovcnt; i++){
+      this->corkBuffer.insert(this->corkBuffer.end(), (const unsigned char *) iov[i].iov_base, (const unsigned char *) iov[i].iov_base + iov[i].iov_len);
+    }
+    if (this->corkBuffer.size() >= this->corkMaxSize || isDeadlineExpired(&(this->corkSince), this->corkDeadlineMs)){
+      ret = this->writeCorkBuffer();
+    }
+    pthread_mutex_unlock(&(this->wmtx));
+    this->dispatchWriteWatermark();
+    return ret;
+  }
+#ifdef __STCP_SSL__
+  if (this->useSSL){
+    unsigned char record[16384];
+    size_t recordSz = 0;
+    if (this->sslConn == nullptr){
+      pthread_mutex_unlock(&(this->wmtx));
+      return 1;
+    }
+    if (BIO_ctrl_pending(SSL_get_wbio(this->sslConn)) != 0){
+      pthread_mutex_unlock(&(this->wmtx));
+      return 2;
+    }
+    for (int i = 0; i < iovcnt && ret == 0; i++){
+      if (recordSz + iov[i].iov_len <= sizeof(record)){
+        memcpy(record + recordSz, iov[i].iov_base, iov[i].iov_len);
+        recordSz += iov[i].iov_len;
+        continue;
+      }
+      if (recordSz > 0){
+        ret = this->writeSSL(record, recordSz);
+        recordSz = 0;
+      }
+      if (ret == 0 && iov[i].iov_len <= sizeof(record)){
+        memcpy(record, iov[i].iov_base, iov[i].iov_len);
+        recordSz = iov[i].iov_len;
+      }
+      else if (ret == 0){
+        ret = this->writeSSL((const unsigned char *) iov[i].iov_base, iov[i].iov_len);
+      }
+    }
+    if (ret == 0 && recordSz > 0){
+      ret = this->writeSSL(record, recordSz);
+    }
+    pthread_mutex_unlock(&(this->wmtx));
+    this->dispatchWriteWatermark();
+    return ret;
+  }
+#endif
+  ret = this->writeOrQueue(iov, iovcnt);
+  if (isQueued != nullptr) *isQueued = (ret == 3);
+  if (ret != 2){
+    ret = (this->isNonBlockingSend ? 0 : this->waitOutputQueue());
+  }
+  pthread_mutex_unlock(&(this->wmtx));
+  this->dispatchWriteWatermark();
+  return ret;
+}
+
+/**
+ * @brief Method overloading of `sendData` with input as a shared buffer.
+ *
+ * In zero-copy send mode, a buffer of at least the zero-copy threshold is sent with `MSG_ZEROCOPY` and the connection keeps a reference to it
+ * until the kernel has released it, so the buffer must not be modified after the call. Otherwise the data is sent the same way as
+ * `sendData(const unsigned char *, size_t)` does.
+ *
+ * @param[in] buffer Data to be written.
+ * @return `0` if the operation is successful.
+ * @return `1` if the port is not open.
+ * @return `2` if the data write operation fails.
+ */
+int Socket::sendData(std::shared_ptr <const std::vector <unsigned char>> buffer){
+  struct iovec iov;
+  struct msghdr msg;
+  fd_set writefds;
+  struct timeval tvTmout;
+  size_t total = 0;
+  ssize_t bytes = 0;
+  bool isReferenced = false;
+  bool isTimeout = false;
+  int ret = 0;
+  if (buffer == nullptr) return 2;
+  pthread_mutex_lock(&(this->wmtx));
+  if (this->sockFd <= 0){
+    pthread_mutex_unlock(&(this->wmtx));
+    return 1;
+  }
+#ifdef __STCP_SSL__
+  if (this->useSSL){
+    pthread_mutex_unlock(&(this->wmtx));
+    return this->sendData(buffer->data(), buffer->size());
+  }
+#endif
+  if (this->isZeroCopy == false || this->isCorked || buffer->size() < this->zeroCopyThreshold){
+    pthread_mutex_unlock(&(this->wmtx));
+    return this->sendData(buffer->data(), buffer->size());
+  }
+  this->readZeroCopyCompletions();
+  if (this->outputQueueSize > 0 && this->writeOutputQueue() == 2){
+    pthread_mutex_unlock(&(this->wmtx));
+    return 2;
+  }
+  /* keep the byte order, nothing may overtake the queued data */
+  while (this->outputQueueSize == 0 && total < buffer->size()){
+    iov.iov_base = (void *) (buffer->data() + total);
+    iov.iov_len = buffer->size() - total;
+    memset(&msg, 0x00, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    bytes = sendmsg(this->sockFd, &msg, MSG_ZEROCOPY | MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (bytes < 0){
+      if (errno == EINTR) continue;
+      /* ENOBUFS: the kernel can not pin more pages (optmem limit), the rest takes the copy path */
+      if (errno == ENOBUFS) break;
+      if ((errno == EAGAIN || errno == EWOULDBLOCK) && this->isNonBlockingSend == false){
+        FD_ZERO(&writefds);
+        FD_SET(this->sockFd, &writefds);
+        tvTmout.tv_sec = this->tvTimeout.tv_sec;
+        tvTmout.tv_usec = this->tvTimeout.tv_usec;
+        if (select(this->sockFd + 1, nullptr, &writefds, nullptr, &tvTmout) > 0) continue;
+        isTimeout = true;
+        break;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+      ret = 2;
+      break;
+    }
+    total += bytes;
+    this->zeroCopySeq++;
+    isReferenced = true;
+  }
+  if (isReferenced){
+    this->zeroCopyPending.emplace_back(this->zeroCopySeq - 1, buffer);
+    this->zeroCopyPendingSize += buffer->size();
+  }
+  if (ret == 0 && total < buffer->size()){
+    ret = this->writeOrQueue(buffer->data() + total, buffer->size() - total);
+    if (ret != 2 && isTimeout){
+      /* the data that has not been written stays queued, the same as waitOutputQueue does */
+      ret = 2;
+    }
+    else if (ret != 2){
+      ret = (this->isNonBlockingSend ? 0 : this->waitOutputQueue());
+    }
+  }
+  pthread_mutex_unlock(&(this->wmtx));
+  this->dispatchWriteWatermark();
+  return ret;
+}
+
+/**
+ * @brief Writes the queued output data without blocking.
+ *
+ * This method should be called when the socket becomes writable (for example, when `select` reports the socket in its write set).
+ *
+ * @return `0` if the output queue is empty.
+ * @return `1` if the port is not open.
+ * @return `2` if the data write operation fails.
+ * @return `3` if data is still queued because the socket send buffer is full.
+ */
+int Socket::flushOutputQueue(){
+  int ret = 0;
+  pthread_mutex_lock(&(this->wmtx));
+  if (this->sockFd <= 0){
+    pthread_mutex_unlock(&(this->wmtx));
+    return 1;
+  }
+  this->readZeroCopyCompletions();
+  ret = this->writeOutputQueue();
+  pthread_mutex_unlock(&(this->wmtx));
+  this->dispatchWriteWatermark();
+  return ret;
+}
+
+/**
+ * @brief Gets the number of queued bytes that have not been sent.
+ *
+ * @return The size of the output queue in bytes.
+ */
+size_t Socket::getOutputQueueSize(){
+  return this->outputQueueSize;
+}
+
+/**
+ * @brief Sets the send mode.
+ *
+ * In non-blocking send mode, `sendData` never waits for the socket to become writable. The data that cannot be written immediately is queued and must be
+ * written by calling `Socket::flushOutputQueue` on write-readiness. The clients of `TCPServer` use this mode.
+ *
+ * @param[in] isNonBlockingSend `true` to enable the non-blocking send mode.
+ * @return `true` when success.
+ */
+bool Socket::setNonBlockingSend(bool isNonBlockingSend){
+  pthread_mutex_lock(&(this->wmtx));
+  this->isNonBlockingSend = isNonBlockingSend;
+  pthread_mutex_unlock(&(this->wmtx));
+  return true;
+}
+
+/**
+ * @brief Sets the output queue watermarks.
+ *
+ * When the output queue grows to `high` bytes the write blocked handler is called, so the producer can stop sending to this connection. When
+ * the queue has been written down to `low` bytes afterwards the write drained handler is called, so the producer can resume. The output queue
+ * itself is not bounded, data sent while blocked is still queued. The clients accepted by `TCPServer` inherit the watermarks and the handlers
+ * of the server.
+ *
+ * @param[in] low The low watermark in bytes.
+ * @param[in] high The high watermark in bytes (`0` disables the watermark handlers).
+ * @return `true` when success.
+ * @return `false` if `high` is not `0` and not greater than `low`.
+ */
+bool Socket::setWriteWatermarks(size_t low, size_t high){
+  if (high != 0 && high <= low) return false;
+  pthread_mutex_lock(&(this->wmtx));
+  this->writeLowWatermark = low;
+  this->writeHighWatermark = high;
+  if (high == 0) this->isWriteBlocked = false;
+  pthread_mutex_unlock(&(this->wmtx));
+  return true;
+}
+
+/**
+ * @brief Gets the low watermark of the output queue.
+ *
+ * @return The low watermark in bytes.
+ */
+size_t Socket::getWriteLowWatermark(){
+  return this->writeLowWatermark;
+}
+
+/**
+ * @brief Gets the high watermark of the output queue.
+ *
+ * @return The high watermark in bytes (`0` means disabled).
+ */
+size_t Socket::getWriteHighWatermark(){
+  return this->writeHighWatermark;
+}
+
+/**
+ * @brief Checks whether the output queue has reached the high watermark and has not been drained to the low watermark yet.
+ *
+ * @return `true` if the connection is write blocked.
+ */
+bool Socket::getIsWriteBlocked(){
+  return this->isWriteBlocked;
+}
+
+/**
+ * @brief Sets the handler that is called when the output queue reaches the high watermark.
+ *
+ * The handler is called without holding any lock of the connection, from the thread that performs the send. It may call `sendData`.
+ *
+ * @param[in] func callback function that has 2 parameters. `Socket &` is the connection. `void *` is a pointer that will connect directly to `void *param`.
+ * @param[in] param callback function parameter.
+ */
+void Socket::setWriteBlockedHandler(void (*func)(Socket &, void *), void *param){
+  pthread_mutex_lock(&(this->wmtx));
+  this->writeBlockedCallbackFunction = (const void *) func;
+  this->writeBlockedCallbackParam = param;
+  pthread_mutex_unlock(&(this->wmtx));
+}
+
+/**
+ * @brief Sets the handler that is called when the output queue has been written down to the low watermark after a write blocked event.
+ *
+ * The handler is called without holding any lock of the connection, from the thread that writes the queue (for `TCPServer` clients this is the
+ * thread that calls `TCPServer::eventCheck`, so the handler must not call methods of the server). It may call `sendData`.
+ *
+ * @param[in] func callback function that has 2 parameters. `Socket &` is the connection. `void *` is a pointer that will connect directly to `void *param`.
+ * @param[in] param callback function parameter.
+ */
+void Socket::setWriteDrainedHandler(void (*func)(Socket &, void *), void *param){
+  pthread_mutex_lock(&(this->wmtx));
+  this->writeDrainedCallbackFunction = (const void *) func;
+  this->writeDrainedCallbackParam = param;
+  pthread_mutex_unlock(&(this->wmtx));
+}
+
+/**
+ * @brief Sets the handler that is called when data is queued in the empty output queue.
+ *
+ * In non-blocking send mode `sendData` returns `0` as soon as the data is queued, the queue is written later by `Socket::flushOutputQueue`.
+ * The handler lets the event loop that flushes the queue wake up (`TCPServer` sets it for its clients, so `TCPServer::eventCheck` does not
+ * wait for its timeout). The handler is called without holding any lock of the connection, from the thread that performs the send.
+ *
+ * @param[in] func callback function that has 2 parameters. `Socket &` is the connection. `void *` is a pointer that will connect directly to `void *param`.
+ * @param[in] param callback function parameter.
+ */
+void Socket::setOutputQueuedHandler(void (*func)(Socket &, void *), void *param){
+  pthread_mutex_lock(&(this->wmtx));
+  this->outputQueuedCallbackFunction = (const void *) func;
+  this->outputQueuedCallbackParam = param;
+  pthread_mutex_unlock(&(this->wmtx));
+}
+
+/**
+ * @brief Sets the `TCP_NODELAY` option.
+ *
+ * Disabling the Nagle algorithm sends small segments immediately, which lowers the latency of request/response traffic. Keep it enabled (the
+ * default) for throughput oriented connections. The option is applied immediately if the socket is open, and otherwise when it is opened. The clients
+ * accepted by `TCPServer` inherit the option of the server.
+ *
+ * @param[in] isNoDelay `true` to disable the Nagle algorithm.
+ * @return `true` when success.
+ * @return `false` if the option can not be applied to the open socket.
+ */
+bool Socket::setNoDelay(bool isNoDelay){
+  int value = (isNoDelay ? 1 : 0);
+  pthread_mutex_lock(&(this->wmtx));
+  if (this->sockFd > 0 && setsockopt(this->sockFd, IPPROTO_TCP, TCP_NODELAY, &value, sizeof(value)) != 0){
+    pthread_mutex_unlock(&(this->wmtx));
+    return false;
+  }
+  this->isNoDelay = isNoDelay;
+  pthread_mutex_unlock(&(this->wmtx));
+  return true;
+}
+
+/**
+ * @brief Gets the `TCP_NODELAY` option.
+ *
+ * @return `true` if the Nagle algorithm is disabled.
+ */
+bool Socket::getNoDelay(){
+  return this->isNoDelay;
+}
+
+/**
+ * @brief Sets the corked send mode.
+ *
+ * In corked send mode, `sendData` appends the data to a userspace cork buffer instead of writing it, so many small writes of one logical message
+ * leave the process as a single write. The cork buffer is flushed by `Socket::flush`, automatically when it reaches `maxSize` bytes, and when
+ * its oldest byte has waited `deadlineMs` (checked on every send, and on every `TCPServer::eventCheck` for the clients of the server). Disabling
+ * the corked send mode flushes the cork buffer. A receive operation that waits for the peer flushes the cork buffer first, as the peer usually
+ * waits for that data (for example a request) before it answers.
+ *
+ * @param[in] isCorked `true` to enable the corked send mode.
+ * @param[in] maxSize The size of the cork buffer that triggers an automatic flush.
+ * @param[in] deadlineMs The maximum time in milliseconds the data stays in the cork buffer (`0` means no deadline).
+ * @return `true` when success.
+ * @return `false` if `maxSize` is `0` or flushing the cork buffer fails.
+ */
+bool Socket::setCork(bool isCorked, size_t maxSize, unsigned int deadlineMs){
+  if (maxSize == 0) return false;
+  pthread_mutex_lock(&(this->wmtx));
+  this->corkMaxSize = maxSize;
+  this->corkDeadlineMs = deadlineMs;
+  pthread_mutex_unlock(&(this->wmtx));
+  return this->setCork(isCorked);
+}
+
+/**
+ * @brief Method overloading of `setCork` that keeps the current flush size and deadline (`16384` bytes and `200` ms by default).
+ *
+ * @param[in] isCorked `true` to enable the corked send mode.
+ * @return `true` when success.
+ * @return `false` if flushing the cork buffer fails.
+ */
+bool Socket::setCork(bool isCorked){
+  int ret = 0;
+  pthread_mutex_lock(&(this->wmtx));
+  this->isCorked = isCorked;
+  if (isCorked == false && this->sockFd > 0){
+    ret = this->writeCorkBuffer();
+  }
+  pthread_mutex_unlock(&(this->wmtx));
+  this->dispatchWriteWatermark();
+  return (ret == 0);
+}
+
+/**
+ * @brief Gets the corked send mode.
+ *
+ * @return `true` if the corked send mode is enabled.
+ */
+bool Socket::getCork(){
+  return this->isCorked;
+}
+
+/**
+ * @brief Writes the data coalesced in the cork buffer.
+ *
+ * In the default (blocking) send mode the method also waits (up to the timeout) until the output queue has been written.
+ *
+ * @return `0` if the operation is successful.
+ * @return `1` if the port is not open.
+ * @return `2` if the data write operation fails.
+ */
+int Socket::flush(){
+  int ret = 0;
+  pthread_mutex_lock(&(this->wmtx));
+  if (this->sockFd <= 0){
+    pthread_mutex_unlock(&(this->wmtx));
+    return 1;
+  }
+  ret = this->writeCorkBuffer();
+  pthread_mutex_unlock(&(this->wmtx));
+  this->dispatchWriteWatermark();
+  return ret;
+}
+
+/**
+ * @brief Flushes the cork buffer if the data in it has reached the flush deadline.
+ *
+ * This method is called by `TCPServer::eventCheck` for its clients. Applications that drive a corked connection from their own loop can call it
+ * periodically.
+ *
+ * @return `0` if nothing has to be flushed or the operation is successful.
+ * @return `2` if the data write operation fails.
+ */
+int Socket::flushIfDeadlineExpired(){
+  int ret = 0;
+  pthread_mutex_lock(&(this->wmtx));
+  if (this->sockFd > 0 && this->corkBuffer.size() > 0 && isDeadlineExpired(&(this->corkSince), this->corkDeadlineMs)){
+    ret = this->writeCorkBuffer();
+  }
+  pthread_mutex_unlock(&(this->wmtx));
+  this->dispatchWriteWatermark();
+  return ret;
+}
+
+/**
+ * @brief Gets the time left before the data in the cork buffer reaches the flush deadline.
+ *
+ * `TCPServer::eventCheck` waits at most this time, so the cork buffers of its clients are flushed on time. Applications that drive a corked
+ * connection from their own loop can use it as the timeout of their wait.
+ *
+ * @return the time left in milliseconds (`0` if the deadline has been reached).
+ * @return `-1` if the cork buffer is empty or there is no deadline.
+ */
+long Socket::getCorkTimeLeft(){
+  struct timeval now;
+  long diffTime = 0;
+  long ret = -1;
+  pthread_mutex_lock(&(this->wmtx));
+  if (this->corkBuffer.size() > 0 && this->corkDeadlineMs > 0){
+    gettimeofday(&now, nullptr);
+    diffTime = (now.tv_sec - this->corkSince.tv_sec) * 1000 + (now.tv_usec - this->corkSince.tv_usec) / 1000;
+    ret = (diffTime >= static_cast<long>(this->corkDeadlineMs) ? 0 : static_cast<long>(this->corkDeadlineMs) - diffTime);
+  }
+  pthread_mutex_unlock(&(this->wmtx));
+  return ret;
+}
+
+/**
+ * @brief Method overloading of `sendData` with input as `const std::vector`.
+ *
+ * This method sends the specified data to the Socket port. This overload allows the data to be passed as a `const std::vector`.
+ *
+ * @param[in] buffer Data to be written.
+ * @return `0` if the operation is successful.
+ * @return `1` if the port is not open.
+ * @return `2` if the data write operation fails.
+ */
+int Socket::sendData(const std::vector <unsigned char> &buffer){
+  return this->sendData(buffer.data(), buffer.size());
+}
+
+/**
+ * @brief Method overloading of `sendData` that takes the ownership of a `std::vector`.
+ *
+ * This method sends the specified data to the Socket port. In non-blocking send mode the part of the data that cannot be written immediately
+ * is moved into the output queue instead of being copied. The corked send mode and SSL connections copy the data like `sendData(const std::vector &)`.
+ *
+ * @param[in] buffer Data to be written (moved from).
+ * @return `0` if the operation is successful.
+ * @return `1` if the port is not open.
+ * @return `2` if the data write operation fails.
+ */
+int Socket::sendData(std::vector <unsigned char> &&buffer){
+  pthread_mutex_lock(&(this->wmtx));
+  int ret = 0;
+  if (this->sockFd <= 0){
+    pthread_mutex_unlock(&(this->wmtx));
+    return 1;
+  }
+#ifdef __STCP_SSL__
+  if (this->isCorked || this->useSSL){
+#else
+  if (this->isCorked){
+#endif
+    pthread_mutex_unlock(&(this->wmtx));
+    return this->sendData(buffer.data(), buffer.size());
+  }
+  ret = this->writeOrQueue(std::move(buffer));
+  if (ret != 2){
+    ret = (this->isNonBlockingSend ? 0 : this->waitOutputQueue());
+  }
+  pthread_mutex_unlock(&(this->wmtx));
+  this->dispatchWriteWatermark();
+  return ret;
+}
+
+/**
+ * @brief Method overloading of `sendData` with input as `const char*`.
+ *
+ * This method sends the specified data to the Socket port. This overload allows the data to be passed as a `const char*`.
+ *
+ * @param[in] buffer Data to be written.
+ * @return `0` if the operation is successful.
+ * @return `1` if the port is not open.
+ * @return `2` if the data write operation fails.
+ */
+int Socket::sendData(const char *buffer){
+  return this->sendData((const unsigned char *) buffer, strlen(buffer));
+}
+
+/**
+ * @brief Method overloading of `sendData` with input as `std::string_view`.
+ *
+ * This method sends the specified data to the Socket port. This overload allows the data to be passed as a `std::string_view` (a `std::string` is passed without copying).
+ *
+ * @param[in] buffer Data to be written.
+ * @return `0` if the operation is successful.
+ * @return `1` if the port is not open.
+ * @return `2` if the data write operation fails.
+ */
+int Socket::sendData(std::string_view buffer){
+  return this->sendData((const unsigned char *) buffer.data(), buffer.length());
+}
+
+/**
+ * @brief Sets the zero-copy send mode.
+ *
+ * In zero-copy send mode, buffers passed to `sendData(std::shared_ptr <const std::vector <unsigned char>>)` of at least `threshold` bytes are sent
+ * with `MSG_ZEROCOPY`: the kernel transmits directly from the buffer instead of copying it. The connection keeps a reference to the buffer until the
+ * kernel reports the completion on the socket error queue. Smaller buffers, SSL connections, the corked send mode and the other `sendData`
+ * overloads keep the copy path. Zero-copy pays off for buffers of about 16 KB and more.
+ *
+ * @param[in] isZeroCopy `true` to enable the zero-copy send mode.
+ * @param[in] threshold The minimum buffer size that is sent with `MSG_ZEROCOPY`.
+ * @return `true` when success.
+ * @return `false` if the kernel does not support `SO_ZEROCOPY`.
+ */
+bool Socket::setZeroCopy(bool isZeroCopy, size_t threshold){
+  pthread_mutex_lock(&(this->wmtx));
+  this->zeroCopyThreshold = threshold;
+  pthread_mutex_unlock(&(this->wmtx));
+  return this->setZeroCopy(isZeroCopy);
+}
+
+/**
+ * @brief Method overloading of `setZeroCopy` that keeps the current threshold (`16384` bytes by default).
+ *
+ * @param[in] isZeroCopy `true` to enable the zero-copy send mode.
+ * @return `true` when success.
+ * @return `false` if the kernel does not support `SO_ZEROCOPY`.
+ */
+bool Socket::setZeroCopy(bool isZeroCopy){
+  int value = 1;
+  pthread_mutex_lock(&(this->wmtx));
+  if (isZeroCopy && this->sockFd > 0 && setsockopt(this->sockFd, SOL_SOCKET, SO_ZEROCOPY, &value, sizeof(value)) != 0){
+    this->isZeroCopy = false;
+    pthread_mutex_unlock(&(this->wmtx));
+    return false;
+  }
+  this->isZeroCopy = isZeroCopy;
+  pthread_mutex_unlock(&(this->wmtx));
+  return true;
+}
+
+/**
+ * @brief Gets the zero-copy send mode.
+ *
+ * @return `true` if the zero-copy send mode is enabled.
+ */
+bool Socket::getZeroCopy(){
+  return this->isZeroCopy;
+}
+
+/**
+ * @brief Reads the zero-copy completion notifications and releases the buffers the kernel no longer references.
+ *
+ * This method is called by every send and by `TCPServer::eventCheck` for its clients. Applications that drive a connection from their own loop
+ * can call it when the socket reports an error condition (`POLLERR`). The error queue is drained even if no buffer is pending, so late completions are consumed.
+ *
+ * @return The number of completion notifications that have been read.
+ */
+int Socket::processZeroCopyCompletions(){
+  int ret = 0;
+  pthread_mutex_lock(&(this->wmtx));
+  ret = this->readZeroCopyCompletions();
+  pthread_mutex_unlock(&(this->wmtx));
+  return ret;
+}
+
+/**
+ * @brief Gets the number of bytes of the buffers that are still referenced by the kernel.
+ *
+ * @return The size of the buffers waiting for a zero-copy completion in bytes.
+ */
+size_t Socket::getZeroCopyPendingSize(){
+  return this->zeroCopyPendingSize;
+}
+
+/**
+ * @brief Sends the content of a file.
+ *
+ * This method sends `length` bytes of the file starting at `offset` (a `length` of `0` sends the file up to its end). Plain sockets use `sendfile`,
+ * so the file data is never copied into userspace. SSL connections fall back to reading the file in 64 KB chunks and writing them with `SSL_write`.
+ * The transfer is performed in chunks and `wmtx` is only held while a chunk is written, so other threads are not blocked for the whole transfer
+ * (their data is written between two chunks). Data queued by the corked send mode or the output queue is written before the file. The method
+ * waits (up to the timeout) for the socket to become writable before each chunk, regardless of the send mode.
+ *
+ * @param[in] fd The file descriptor of the file (the file offset of the descriptor is not changed).
+ * @param[in] offset The offset of the first byte in the file.
+ * @param[in] length The number of bytes to send.
+ * @return `0` if the operation is successful.
+ * @return `1` if the port is not open.
+ * @return `2` if the data write operation fails or a timeout occurs.
+ * @return `3` if the file can not be read or the requested range is beyond the end of the file.
+ */
+int Socket::sendFile(int fd, off_t offset, size_t length){
+  return this->sendFile(fd, offset, length, nullptr, nullptr);
+}
+
+/**
+ * @brief Method overloading of `sendFile` with a progress handler.
+ *
+ * This method sends `length` bytes of the file starting at `offset` (a `length` of `0` sends the file up to its end). Plain sockets use `sendfile`,
+ * so the file data is never copied into userspace. SSL connections fall back to reading the file in 64 KB chunks and writing them with `SSL_write`.
+ * The transfer is performed in chunks and `wmtx` is only held while a chunk is written, so other threads are not blocked for the whole transfer
+ * (their data is written between two chunks). Data queued by the corked send mode or the output queue is written before the file. The method
+ * waits (up to the timeout) for the socket to become writable before each chunk, regardless of the send mode.
+ *
+ * @param[in] fd The file descriptor of the file (the file offset of the descriptor is not changed).
+ * @param[in] offset The offset of the first byte in the file.
+ * @param[in] length The number of bytes to send.
+ * @param[in] func callback function that is called after every chunk (without holding any lock). `Socket &` is the connection, followed by the
+ *                 number of bytes that have been sent and the total number of bytes to send. `void *` is a pointer that will connect directly
+ *                 to `void *param`.
+ * @param[in] param callback function parameter.
+ * @return `0` if the operation is successful.
+ * @return `1` if the port is not open.
+ * @return `2` if the data write operation fails or a timeout occurs.
+ * @return `3` if the file can not be read or the requested range is beyond the end of the file.
+ */
+int Socket::sendFile(int fd, off_t offset, size_t length, void (*func)(Socket &, size_t, size_t, void *), void *param){
+  struct stat st;
+  fd_set writefds;
+  struct timeval tvTmout;
+  std::vector <unsigned char> chunkBuffer;
+  size_t total = 0;
+  size_t chunk = 0;
+  ssize_t bytes = 0;
+  off_t pos = 0;
+  int sockFd = 0;
+  int ret = 0;
+  pthread_mutex_lock(&(this->wmtx));
+  sockFd = this->sockFd;
+  pthread_mutex_unlock(&(this->wmtx));
+  if (sockFd <= 0) return 1;
+  if (fd < 0 || offset < 0 || fstat(fd, &st) != 0) return 3;
+  if (S_ISREG(st.st_mode)){
+    if (offset > st.st_size) return 3;
+    if (length == 0) length = static_cast<size_t>(st.st_size - offset);
+    if (length > static_cast<size_t>(st.st_size - offset)) return 3;
+  }
+#ifdef __STCP_SSL__
+  if (this->useSSL) chunkBuffer.resize(SEND_FILE_SSL_CHUNK_SIZE);
+#endif
+  while (total < length){
+    FD_ZERO(&writefds);
+    FD_SET(sockFd, &writefds);
+    tvTmout.tv_sec = this->tvTimeout.tv_sec;
+    tvTmout.tv_usec = this->tvTimeout.tv_usec;
+    ret = select(sockFd + 1, nullptr, &writefds, nullptr, &tvTmout);
+    if (ret < 0 && errno == EINTR) continue;
+    if (ret <= 0) return 2;
+    pthread_mutex_lock(&(this->wmtx));
+    if (this->sockFd != sockFd){
+      pthread_mutex_unlock(&(this->wmtx));
+      return 1;
+    }
+    /* the data sent before (or between two chunks) must not be overtaken by the file */
+    if (this->corkBuffer.size() > 0 && this->writeCorkBuffer() != 0){
+      pthread_mutex_unlock(&(this->wmtx));
+      return 2;
+    }
+    ret = this->writeOutputQueue();
+    if (ret != 0){
+      pthread_mutex_unlock(&(this->wmtx));
+      this->dispatchWriteWatermark();
+      if (ret == 2) return 2;
+      continue;
+    }
+    chunk = length - total;
+#ifdef __STCP_SSL__
+    if (this->useSSL){
+      if (chunk > chunkBuffer.size()) chunk = chunkBuffer.size();
+      bytes = pread(fd, chunkBuffer.data(), chunk, offset + total);
+      if (bytes <= 0){
+        pthread_mutex_unlock(&(this->wmtx));
+        return 3;
+      }
+      if (this->writeSSL(chunkBuffer.data(), bytes) != 0){
+        pthread_mutex_unlock(&(this->wmtx));
+        return 2;
+      }
+    }
+    else
+#endif
+    {
+      if (chunk > SEND_FILE_CHUNK_SIZE) chunk = SEND_FILE_CHUNK_SIZE;
+      pos = offset + total;
+      bytes = sendfile(this->sockFd, fd, &pos, chunk);
+      if (bytes < 0 && (errno == EINTR || errno == EAGAIN)){
+        pthread_mutex_unlock(&(this->wmtx));
+        continue;
+      }
+      if (bytes <= 0){
+        pthread_mutex_unlock(&(this->wmtx));
+        return (bytes == 0 || errno == EINVAL || errno == EIO ? 3 : 2);
+      }
+    }
+    pthread_mutex_unlock(&(this->wmtx));
+    this->dispatchWriteWatermark();
+    total += bytes;
+    if (func != nullptr) func(*this, total, length, param);
+  }
+  return 0;
+}
+
+/**
+ * @brief Method overloading of `sendFile` with input as a file path.
+ *
+ * @param[in] path The path of the file.
+ * @param[in] offset The offset of the first byte in the file.
+ * @param[in] length The number of bytes to send (`0` sends the file up to its end).
+ * @return `0` if the operation is successful.
+ * @return `1` if the port is not open.
+ * @return `2` if the data write operation fails or a timeout occurs.
+ * @return `3` if the file can not be opened or read, or the requested range is beyond the end of the file.
+ */
+int Socket::sendFile(const std::string &path, off_t offset, size_t length){
+  return this->sendFile(path, offset, length, nullptr, nullptr);
+}
+
+/**
+ * @brief Method overloading of `sendFile` with input as a file path and a progress handler.
+ *
+ * @param[in] path The path of the file.
+ * @param[in] offset The offset of the first byte in the file.
+ * @param[in] length The number of bytes to send (`0` sends the file up to its end).
+ * @param[in] func callback function that is called after every chunk (see `sendFile(int, off_t, size_t, void (*)(Socket &, size_t, size_t, void *), void *)`).
+ * @param[in] param callback function parameter.
+ * @return `0` if the operation is successful.
+ * @return `1` if the port is not open.
+ * @return `2` if the data write operation fails or a timeout occurs.
+ * @return `3` if the file can not be opened or read, or the requested range is beyond the end of the file.
+ */
+int Socket::sendFile(const std::string &path, off_t offset, size_t length, void (*func)(Socket &, size_t, size_t, void *), void *param){
+  int ret = 0;
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) return 3;
+  ret = this->sendFile(fd, offset, length, func, param);
+  close(fd);
+  return ret;
+}
+
+/**
+ * @brief Closes the Socket connection between client and server.
+ *
+ * This function is used to close the currently Socket connection between client and server,
+ * ensuring that the port is no longer in use and that any associated system resources
+ * are released.
+ *
+ * Data left in the cork buffer is written before the connection is closed.
+ */
+void Socket::closeConnection(){
   pthread_mutex_lock(&(this->mtx));
   pthread_mutex_lock(&(this->wmtx));
+  if (this->sockFd > 0 && this->corkBuffer.size() > 0){
+    this->writeCorkBuffer();
+  }
+  this->readZeroCopyCompletions();
 #ifdef __STCP_SSL__
   if (this->sslConn != nullptr && this->useSSL){
     if (this->sockFd > 0){
@@ -1515,6 +3205,14 @@ void Socket::closeConnection(){
       this->sockFd = -1;
     }
   }
+  this->outputQueue.clear();
+  this->outputQueueOffset = 0;
+  this->outputQueueSize = 0;
+  this->corkBuffer.clear();
+  this->zeroCopyPending.clear();
+  this->zeroCopyPendingSize = 0;
+  this->isWriteBlocked = false;
+  this->pendingWriteEvents.clear();
   pthread_mutex_unlock(&(this->mtx));
   pthread_mutex_unlock(&(this->wmtx));
 }
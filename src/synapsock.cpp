@@ -23,8 +23,24 @@
 
 #include <iostream>
 #include <string.h>
+#include <stdint.h>
 #include "synapsock.hpp"
 
+/* number of bytes of a fixed-width length field, 0 for a varint */
+static size_t getLengthWidth(unsigned char encoding){
+    if (encoding == SynapSock::LENGTH_ENCODING_UINT8) return 1;
+    if (encoding == SynapSock::LENGTH_ENCODING_UINT16_BE || encoding == SynapSock::LENGTH_ENCODING_UINT16_LE) return 2;
+    if (encoding == SynapSock::LENGTH_ENCODING_UINT32_BE || encoding == SynapSock::LENGTH_ENCODING_UINT32_LE) return 4;
+    if (encoding == SynapSock::LENGTH_ENCODING_UINT64_BE || encoding == SynapSock::LENGTH_ENCODING_UINT64_LE) return 8;
+    return 0;
+}
+
+static bool isLengthBigEndian(unsigned char encoding){
+    return (encoding == SynapSock::LENGTH_ENCODING_UINT16_BE ||
+            encoding == SynapSock::LENGTH_ENCODING_UINT32_BE ||
+            encoding == SynapSock::LENGTH_ENCODING_UINT64_BE);
+}
+
 /**
  * @brief Default constructor.
  *
@@ -37,7 +53,14 @@
  */
 SynapSock::SynapSock(){
     this->isFormatValid = true;
-    this->frameFormat = nullptr;
+    this->schema = std::make_shared<FrameSchema>();
+    this->isSchemaShared = false;
+    pthread_mutex_init(&(this->formatMtx), nullptr);
+    this->parseCursorDataSize = 0;
+    this->resetParseCursor(0);
+    this->isResync = false;
+    this->skippedBytes = 0;
+    this->invalidFrames = 0;
 }
 
 /**
@@ -52,7 +75,14 @@ SynapSock::SynapSock(){
  */
 SynapSock::SynapSock(const unsigned char *address) : Socket(address){
     this->isFormatValid = true;
-    this->frameFormat = nullptr;
+    this->schema = std::make_shared<FrameSchema>();
+    this->isSchemaShared = false;
+    pthread_mutex_init(&(this->formatMtx), nullptr);
+    this->parseCursorDataSize = 0;
+    this->resetParseCursor(0);
+    this->isResync = false;
+    this->skippedBytes = 0;
+    this->invalidFrames = 0;
 }
 
 /**
@@ -67,7 +97,14 @@ SynapSock::SynapSock(const unsigned char *address) : Socket(address){
  */
 SynapSock::SynapSock(const unsigned char *address, int port) : Socket(address, port){
     this->isFormatValid = true;
-    this->frameFormat = nullptr;
+    this->schema = std::make_shared<FrameSchema>();
+    this->isSchemaShared = false;
+    pthread_mutex_init(&(this->formatMtx), nullptr);
+    this->parseCursorDataSize = 0;
+    this->resetParseCursor(0);
+    this->isResync = false;
+    this->skippedBytes = 0;
+    this->invalidFrames = 0;
 }
 
 /**
@@ -80,9 +117,16 @@ SynapSock::SynapSock(const unsigned char *address, int port) : Socket(address, p
  * - Initializes the mutex for thread safety.
  * @param[in] address The address is in the form of an IP address with a size of 4 bytes.
  */
-SynapSock::SynapSock(const std::vector <unsigned char> address) : Socket(address){
+SynapSock::SynapSock(const std::vector <unsigned char> &address) : Socket(address){
     this->isFormatValid = true;
-    this->frameFormat = nullptr;
+    this->schema = std::make_shared<FrameSchema>();
+    this->isSchemaShared = false;
+    pthread_mutex_init(&(this->formatMtx), nullptr);
+    this->parseCursorDataSize = 0;
+    this->resetParseCursor(0);
+    this->isResync = false;
+    this->skippedBytes = 0;
+    this->invalidFrames = 0;
 }
 
 /**
@@ -95,9 +139,16 @@ SynapSock::SynapSock(const std::vector <unsigned char> address) : Socket(address
  * @param[in] address The address is in the form of an IP address with a size of 4 bytes.
  * @param[in] port The port of Socket interface.
  */
-SynapSock::SynapSock(const std::vector <unsigned char> address, int port) : Socket(address, port){
+SynapSock::SynapSock(const std::vector <unsigned char> &address, int port) : Socket(address, port){
     this->isFormatValid = true;
-    this->frameFormat = nullptr;
+    this->schema = std::make_shared<FrameSchema>();
+    this->isSchemaShared = false;
+    pthread_mutex_init(&(this->formatMtx), nullptr);
+    this->parseCursorDataSize = 0;
+    this->resetParseCursor(0);
+    this->isResync = false;
+    this->skippedBytes = 0;
+    this->invalidFrames = 0;
 }
 
 /**
@@ -112,7 +163,14 @@ SynapSock::SynapSock(const std::vector <unsigned char> address, int port) : Sock
  */
 SynapSock::SynapSock(const char *address) : Socket(address){
     this->isFormatValid = true;
-    this->frameFormat = nullptr;
+    this->schema = std::make_shared<FrameSchema>();
+    this->isSchemaShared = false;
+    pthread_mutex_init(&(this->formatMtx), nullptr);
+    this->parseCursorDataSize = 0;
+    this->resetParseCursor(0);
+    this->isResync = false;
+    this->skippedBytes = 0;
+    this->invalidFrames = 0;
 }
 
 /**
@@ -127,7 +185,14 @@ SynapSock::SynapSock(const char *address) : Socket(address){
  */
 SynapSock::SynapSock(const char *address, int port) : Socket(address, port){
     this->isFormatValid = true;
-    this->frameFormat = nullptr;
+    this->schema = std::make_shared<FrameSchema>();
+    this->isSchemaShared = false;
+    pthread_mutex_init(&(this->formatMtx), nullptr);
+    this->parseCursorDataSize = 0;
+    this->resetParseCursor(0);
+    this->isResync = false;
+    this->skippedBytes = 0;
+    this->invalidFrames = 0;
 }
 
 /**
@@ -140,9 +205,16 @@ SynapSock::SynapSock(const char *address, int port) : Socket(address, port){
  * - Initializes the mutex for thread safety.
  * @param[in] address The address in the form of an IP address or domain (string).
  */
-SynapSock::SynapSock(const std::string address) : Socket(address){
+SynapSock::SynapSock(const std::string &address) : Socket(address){
     this->isFormatValid = true;
-    this->frameFormat = nullptr;
+    this->schema = std::make_shared<FrameSchema>();
+    this->isSchemaShared = false;
+    pthread_mutex_init(&(this->formatMtx), nullptr);
+    this->parseCursorDataSize = 0;
+    this->resetParseCursor(0);
+    this->isResync = false;
+    this->skippedBytes = 0;
+    this->invalidFrames = 0;
 }
 
 /**
@@ -155,9 +227,16 @@ SynapSock::SynapSock(const std::string address) : Socket(address){
  * @param[in] address The address in the form of an IP address or domain (string).
  * @param[in] port The port of Socket interface.
  */
-SynapSock::SynapSock(const std::string address, int port) : Socket(address, port){
+SynapSock::SynapSock(const std::string &address, int port) : Socket(address, port){
     this->isFormatValid = true;
-    this->frameFormat = nullptr;
+    this->schema = std::make_shared<FrameSchema>();
+    this->isSchemaShared = false;
+    pthread_mutex_init(&(this->formatMtx), nullptr);
+    this->parseCursorDataSize = 0;
+    this->resetParseCursor(0);
+    this->isResync = false;
+    this->skippedBytes = 0;
+    this->invalidFrames = 0;
 }
 
 /**
@@ -166,34 +245,332 @@ SynapSock::SynapSock(const std::string address, int port) : Socket(address, port
  * Releases any allocated memory.
  */
 SynapSock::~SynapSock(){
+    pthread_mutex_destroy(&(this->formatMtx));
+}
+
+/**
+ * @brief Default constructor, creates an empty schema.
+ */
+SynapSock::FrameSchema::FrameSchema(){
+    this->frameFormat = nullptr;
+}
+
+/**
+ * @brief Destructor, releases the fields of the frame format.
+ */
+SynapSock::FrameSchema::~FrameSchema(){
     if (this->frameFormat != nullptr){
         delete this->frameFormat;
         this->frameFormat = nullptr;
     }
 }
 
+/**
+ * @brief Gets the number of fields of the frame format.
+ *
+ * @return the number of fields.
+ */
+size_t SynapSock::FrameSchema::getFieldCount() const {
+    return this->parsePlan.size();
+}
+
+/**
+ * @brief Checks if a field of the frame format has an execute function, a post-execute function or a handler.
+ *
+ * @return `true` if a function is called while parsing.
+ */
+bool SynapSock::FrameSchema::hasCallbacks() const {
+    for (size_t i = 0; i < this->parsePlan.size(); i++){
+        if (this->parsePlan[i].execute || this->parsePlan[i].postExecute) return true;
+        if (this->parsePlan[i].node->getExecuteFunction() != nullptr) return true;
+        if (this->parsePlan[i].node->getPostExecuteFunction() != nullptr) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Gets the number of bytes of a field of the frame encoded from `fields`.
+ *
+ * @param[in] idx The index of the field.
+ * @param[in] fields The value of every field.
+ * @return the number of bytes of the field (`0` for a length field if the size of its bound field cannot be encoded, see `encodeLength`).
+ */
+size_t SynapSock::FrameSchema::getEncodedSize(size_t idx, const FieldView *fields) const {
+    const PARSE_STEP_t &step = this->parsePlan[idx];
+    unsigned char length[10];
+    if (step.op == SynapSock::PARSE_OP_START_BYTES || step.op == SynapSock::PARSE_OP_STOP_BYTES) return step.delimiter.size();
+    if (step.op == SynapSock::PARSE_OP_LENGTH) return SynapSock::encodeLength(length, step, fields[step.lengthTarget].getSize());
+    if (step.op == SynapSock::PARSE_OP_VALIDATOR) return Checksum::getSize(static_cast<Checksum::ALGORITHM_t>(step.checksumAlgorithm));
+    return fields[idx].getSize();
+}
+
+/**
+ * @brief Gets the offset of a field in the frame encoded from `fields`.
+ *
+ * @param[in] idx The index of the field (the number of fields for the size of the frame).
+ * @param[in] fields The value of every field.
+ * @return the offset of the field.
+ */
+size_t SynapSock::FrameSchema::getEncodedOffset(size_t idx, const FieldView *fields) const {
+    size_t offset = 0;
+    for (size_t i = 0; i < idx; i++){
+        offset += this->getEncodedSize(i, fields);
+    }
+    return offset;
+}
+
+/**
+ * @brief Encodes a frame from the values of its fields.
+ *
+ * The frame is written into `buffer` (its capacity is kept) in one pass over the fields: the start and stop bytes come from the frame format,
+ * the declared length fields are encoded from the size of the field they size and the declared checksum fields are computed over the
+ * bytes that have just been written. The frame format is only read, so the same schema can encode frames from any number of threads.
+ *
+ * @param[in] fields The value of every field, indexed as the frame format (the values of the start bytes, stop bytes, declared length and
+ * checksum fields are ignored).
+ * @param[in] count The number of values, it must be the number of fields of the frame format.
+ * @param[out] buffer A variable that holds the encoded frame.
+ * @return `0` on success.
+ * @return `1` if the frame format is not set up, the number of values is invalid or the size of a bound field does not fit in its length field (or exceeds its maximum size), or if a value does not match its field (a fixed size field with a value of another size, or a delimited field whose value contains its stop bytes).
+ */
+int SynapSock::FrameSchema::encode(const FieldView *fields, size_t count, std::vector <unsigned char> &buffer) const {
+    size_t pos = 0;
+    size_t begin = 0;
+    size_t end = 0;
+    size_t sz = 0;
+    if (this->frameFormat == nullptr || fields == nullptr || count != this->parsePlan.size()) return 1;
+    /* the length fields are checked while the size of the frame is computed, nothing is written if a size cannot be encoded */
+    for (size_t i = 0; i < count; i++){
+        const PARSE_STEP_t &step = this->parsePlan[i];
+        size_t fieldSize = this->getEncodedSize(i, fields);
+        if (fieldSize == 0 && step.op == SynapSock::PARSE_OP_LENGTH) return 1;
+        if (step.op == SynapSock::PARSE_OP_FIELD && step.isSizeBound == false){
+            /* the value must be parsed back as the same field, as the parser reads it (see `parseFrame`) */
+            if (step.node->getSize() > 0){
+                if (fieldSize != step.node->getSize()) return 1;
+            }
+            else if (step.delimiter.size() > 0){
+                if (fieldSize > 0 && ByteSearch::find(fields[i].getData(), fieldSize, step.delimiter.data(), step.delimiter.size()) != ByteSearch::NOT_FOUND) return 1;
+            }
+            else {
+                return 1;
+            }
+        }
+        sz += fieldSize;
+    }
+    buffer.resize(sz);
+    for (size_t i = 0; i < count; i++){
+        const PARSE_STEP_t &step = this->parsePlan[i];
+        if (step.op == SynapSock::PARSE_OP_START_BYTES || step.op == SynapSock::PARSE_OP_STOP_BYTES){
+            memcpy(buffer.data() + pos, step.delimiter.data(), step.delimiter.size());
+            pos += step.delimiter.size();
+        }
+        else if (step.op == SynapSock::PARSE_OP_LENGTH){
+            pos += SynapSock::encodeLength(buffer.data() + pos, step, fields[step.lengthTarget].getSize());
+        }
+        else if (step.op == SynapSock::PARSE_OP_VALIDATOR){
+            /* the covered fields have just been written, the checksum is computed over the output buffer */
+            Checksum::ALGORITHM_t algorithm = static_cast<Checksum::ALGORITHM_t>(step.checksumAlgorithm);
+            begin = this->getEncodedOffset(step.checksumBegin, fields);
+            end = begin;
+            for (size_t j = step.checksumBegin; j <= step.checksumEnd; j++) end += this->getEncodedSize(j, fields);
+            SynapSock::encodeChecksum(buffer.data() + pos, step, Checksum::update(algorithm, Checksum::init(algorithm), buffer.data() + begin, end - begin));
+            pos += Checksum::getSize(algorithm);
+        }
+        else if (fields[i].getSize() > 0){
+            memcpy(buffer.data() + pos, fields[i].getData(), fields[i].getSize());
+            pos += fields[i].getSize();
+        }
+    }
+    return 0;
+}
+
 /**
  * @brief Retrieves the memory address of the frame format.
  *
- * This function returns the address of the `frameFormat` data member.
+ * This function returns the address of the `frameFormat` data member. The fields may be modified through this pointer, but fields must only be
+ * added or removed with the operators of this class, so the compiled parse plan stays in sync with the frame format. The parse plan keeps a
+ * copy of the start bytes and stop bytes, so `refreshFormat` must be called after a delimiter has been modified through this pointer (or
+ * through `operator[]`). The fields of a shared frame format (see `shareFormat`) must not be modified.
  *
  * @return The memory address of the `frameFormat`.
  */
 DataFrame *SynapSock::getFormat(){
-    return this->frameFormat;
+    return this->schema->frameFormat;
+}
+
+/**
+ * @brief Compiles the frame format again after its fields have been modified in place.
+ *
+ * The data of the fields is read while sending and receiving, but the start bytes and stop bytes are copied into the parse plan when the frame
+ * format is set. This method must be called after a delimiter has been modified through `getFormat` or `operator[]`, the parse state of a
+ * partially received frame is discarded.
+ */
+void SynapSock::refreshFormat(){
+    this->compileFormat();
 }
 
 /**
  * @brief Release and destroy frame format pointer.
  *
- * This function will release memory previously allocated for `frameFormat`.
+ * This function will release memory previously allocated for `frameFormat`. A shared frame format is only released by the last connection that uses it.
  *
  */
 void SynapSock::destroyFormat(){
-    if (this->frameFormat != nullptr){
-        delete this->frameFormat;
-        this->frameFormat = nullptr;
+    this->schema = std::make_shared<FrameSchema>();
+    this->isSchemaShared = false;
+    this->stepStates.clear();
+    this->resetParseCursor(0);
+    this->parseCursorDataSize = 0;
+    this->resetSharedFormat();
+}
+
+/**
+ * @brief Shares the frame format of this connection.
+ *
+ * The returned schema is a read-only snapshot of the frame format, it can be given to other connections with `setFormat`, so they parse
+ * with the same fields and parse plan instead of a copy each. This connection keeps its own frame format and parses as before. The snapshot
+ * is taken once and returned again until the frame format of this connection is changed.
+ *
+ * @return the shared frame format (`nullptr` if the frame format is not set up).
+ */
+SynapSock::SHARED_FORMAT_t SynapSock::shareFormat(){
+    SHARED_FORMAT_t format;
+    pthread_mutex_lock(&(this->formatMtx));
+    if (this->schema->frameFormat != nullptr){
+        if (this->sharedSchema == nullptr) this->sharedSchema = SynapSock::copySchema(*(this->schema));
+        format = this->sharedSchema;
+    }
+    pthread_mutex_unlock(&(this->formatMtx));
+    return format;
+}
+
+/**
+ * @brief Uses a shared frame format.
+ *
+ * The frame format is not copied, this connection only keeps the state of the frame being parsed. A shared frame format is read-only:
+ * the fields are not written while parsing (use `getFieldView` to read the received fields) and `receiveFramedData` always resynchronizes
+ * as in resync mode, so the size of a field must be fixed, declared with `setLengthField`, or given by the stop bytes that follow it.
+ * A frame format with an execute function, a post-execute function or a handler is not shared: this connection gets its own copy,
+ * so the functions are called and the fields are written for this connection. Changing the frame format of a connection (with the
+ * operators, `setLengthField`, `setValidator` or a handler) also gives the connection its own copy.
+ *
+ * @param[in] format The shared frame format, returned by `shareFormat`.
+ * @return `0` on success.
+ * @return `1` if the frame format is `nullptr`.
+ */
+int SynapSock::setFormat(const SHARED_FORMAT_t &format){
+    if (format == nullptr) return 1;
+    if (format->hasCallbacks()){
+        this->schema = SynapSock::copySchema(*format);
+        this->isSchemaShared = false;
+    }
+    else {
+        this->schema = format;
+        this->isSchemaShared = true;
+    }
+    this->stepStates.assign(this->schema->parsePlan.size(), STEP_STATE_t{0, 0, 0, 0});
+    this->resetParseCursor(0);
+    this->parseCursorDataSize = 0;
+    this->resetSharedFormat();
+    return 0;
+}
+
+/**
+ * @brief Checks if the frame format is shared with other connections.
+ *
+ * @return `true` if the frame format is shared.
+ */
+bool SynapSock::isFormatShared(){
+    return this->isSchemaShared;
+}
+
+/**
+ * @brief Gives this connection its own copy of a shared frame format before it is modified.
+ *
+ * The fields, the declared length fields, checksum fields and handlers are copied. Nothing is done if the frame format is not shared.
+ * The shared frame format is always copied, other connections may still hold it.
+ */
+void SynapSock::detachFormat(){
+    if (this->isSchemaShared == false) return;
+    this->schema = SynapSock::copySchema(*(this->schema));
+    this->isSchemaShared = false;
+    this->stepStates.assign(this->schema->parsePlan.size(), STEP_STATE_t{0, 0, 0, 0});
+    this->resetParseCursor(0);
+    this->parseCursorDataSize = 0;
+}
+
+/**
+ * @brief Copies a list of fields.
+ *
+ * @param[in] obj The first field of the list.
+ * @return the first field of the copy.
+ */
+DataFrame *SynapSock::copyFrames(const DataFrame &obj){
+    DataFrame &ncObj = const_cast<DataFrame&>(obj);
+    std::vector <unsigned char> ref;
+    ncObj.getReference(ref);
+    DataFrame *frames = new DataFrame(
+     static_cast<DataFrame::FRAME_TYPE_t>(ncObj.getType()),
+      ncObj.getSize(),
+      ref.data(),
+      ncObj.getExecuteFunction(),
+      ncObj.getExecuteFunctionParam(),
+      ncObj.getPostExecuteFunction(),
+      ncObj.getPostExecuteFunctionParam()
+    );
+    if (frames != nullptr){
+        if (ncObj.getNext() != nullptr)
+            *frames += *(ncObj.getNext());
+    }
+    return frames;
+}
+
+/**
+ * @brief Copies a schema.
+ *
+ * The fields, the declared length fields, checksum fields and handlers are copied, then the copy is compiled.
+ *
+ * @param[in] format The schema to be copied.
+ * @return the copy of the schema.
+ */
+SynapSock::SHARED_FORMAT_t SynapSock::copySchema(const FrameSchema &format){
+    SHARED_FORMAT_t copy = std::make_shared<FrameSchema>();
+    if (format.frameFormat == nullptr) return copy;
+    copy->frameFormat = SynapSock::copyFrames(*(format.frameFormat));
+    DataFrame *tmp = copy->frameFormat;
+    std::vector <DataFrame *> nodes;
+    while (tmp != nullptr){
+        nodes.push_back(tmp);
+        tmp = tmp->getNext();
     }
+    /* the fields of the copy have the same indexes as the fields of the copied frame format */
+    auto getNode = [&format, &nodes](const DataFrame *node) -> DataFrame * {
+        for (size_t i = 0; i < format.parsePlan.size() && i < nodes.size(); i++){
+            if (format.parsePlan[i].node == node) return nodes[i];
+        }
+        return nullptr;
+    };
+    for (size_t i = 0; i < format.lengthBindings.size(); i++){
+        LENGTH_BINDING_t binding = format.lengthBindings[i];
+        binding.lengthNode = getNode(binding.lengthNode);
+        binding.targetNode = getNode(binding.targetNode);
+        copy->lengthBindings.push_back(binding);
+    }
+    for (size_t i = 0; i < format.validatorBindings.size(); i++){
+        VALIDATOR_BINDING_t binding = format.validatorBindings[i];
+        binding.validatorNode = getNode(binding.validatorNode);
+        binding.beginNode = getNode(binding.beginNode);
+        binding.endNode = getNode(binding.endNode);
+        copy->validatorBindings.push_back(binding);
+    }
+    for (size_t i = 0; i < format.hookBindings.size(); i++){
+        HOOK_BINDING_t binding = format.hookBindings[i];
+        binding.node = getNode(binding.node);
+        copy->hookBindings.push_back(binding);
+    }
+    SynapSock::compileSchema(*copy);
+    return copy;
 }
 
 /**
@@ -207,11 +584,190 @@ void SynapSock::trigInvDataIndicator(){
     this->isFormatValid = false;
 }
 
+/**
+ * @brief Sets the resync mode of `receiveFramedData`.
+ *
+ * In resync mode, `receiveFramedData` parses the frames in the receive buffer with the resumable parser. When a frame is invalid, the search
+ * for the start bytes resumes one byte past the start of the invalid frame inside the same buffer, no field data is copied or pushed back
+ * to the remaining buffer, and the method only returns when a valid frame is received or on timeout. The invalid data is counted by
+ * `getSkippedBytes` and `getInvalidFrames`.
+ *
+ * @param[in] isResync `true` to enable the resync mode.
+ */
+void SynapSock::setResync(bool isResync){
+    this->isResync = isResync;
+}
+
+/**
+ * @brief Gets the resync mode of `receiveFramedData`.
+ *
+ * @return `true` if the resync mode is enabled.
+ */
+bool SynapSock::getResync(){
+    return this->isResync;
+}
+
+/**
+ * @brief Gets the number of bytes discarded by the frame parser (the data before the start bytes and the data of invalid frames).
+ *
+ * The counter is updated by `receiveFramedDataBatch`, `pollFramedData` and by `receiveFramedData` in resync mode.
+ *
+ * @return the number of skipped bytes since the counters were reset.
+ */
+size_t SynapSock::getSkippedBytes(){
+    return this->skippedBytes;
+}
+
+/**
+ * @brief Gets the number of frames rejected by the frame parser (invalid format, length or checksum).
+ *
+ * @return the number of invalid frames since the counters were reset.
+ */
+size_t SynapSock::getInvalidFrames(){
+    return this->invalidFrames;
+}
+
+/**
+ * @brief Resets the skipped bytes and invalid frames counters.
+ */
+void SynapSock::resetResyncCounters(){
+    this->skippedBytes = 0;
+    this->invalidFrames = 0;
+}
+
+/**
+ * @brief Binds a length field to the field it sizes.
+ *
+ * The length is decoded by the parser while receiving, and the size of the bound field is set from it, so no post-execute function is
+ * needed to size the field. When a frame is sent with `sendFramedData`, the length field is encoded from the size of the bound field.
+ * The size of a fixed-width length field is set to the width of the encoding, a varint length field has a variable size.
+ *
+ * @param[in] lengthIdx The index of the length field in the frame format (usually a `FRAME_TYPE_CONTENT_LENGTH` field).
+ * @param[in] targetIdx The index of the field sized by the length (usually a `FRAME_TYPE_DATA` field), it must come after the length field.
+ * @param[in] encoding The encoding of the length field.
+ * @return `0` on success.
+ * @return `1` if the frame format is not set up or an index is invalid.
+ */
+int SynapSock::setLengthField(int lengthIdx, int targetIdx, LENGTH_ENCODING_t encoding){
+    return this->setLengthField(lengthIdx, targetIdx, encoding, 0, 0);
+}
+
+/**
+ * @brief Overloaded method of `setLengthField` with an adjustment and a maximum size.
+ *
+ * @param[in] lengthIdx The index of the length field in the frame format (usually a `FRAME_TYPE_CONTENT_LENGTH` field).
+ * @param[in] targetIdx The index of the field sized by the length (usually a `FRAME_TYPE_DATA` field), it must come after the length field.
+ * @param[in] encoding The encoding of the length field.
+ * @param[in] adjustment The value added to the decoded length to get the size of the bound field (for example `-2` if the length also counts a 2 bytes checksum).
+ * @param[in] maxSize The maximum size of the bound field, a frame with a larger length is invalid (`0` for no limit).
+ * @return `0` on success.
+ * @return `1` if the frame format is not set up or an index is invalid.
+ */
+int SynapSock::setLengthField(int lengthIdx, int targetIdx, LENGTH_ENCODING_t encoding, long adjustment, size_t maxSize){
+    this->detachFormat();
+    DataFrame *lengthNode = (*this)[lengthIdx];
+    DataFrame *targetNode = (*this)[targetIdx];
+    if (lengthNode == nullptr || targetNode == nullptr || lengthIdx >= targetIdx || encoding > SynapSock::LENGTH_ENCODING_VARINT) return 1;
+    if (this->schema->parsePlan[lengthIdx].op != SynapSock::PARSE_OP_FIELD && this->schema->parsePlan[lengthIdx].op != SynapSock::PARSE_OP_LENGTH) return 1;
+    if (this->schema->parsePlan[targetIdx].op != SynapSock::PARSE_OP_FIELD) return 1;
+    for (size_t i = 0; i < this->schema->lengthBindings.size(); i++){
+        if (this->schema->lengthBindings[i].lengthNode == lengthNode || this->schema->lengthBindings[i].targetNode == targetNode){
+            this->schema->lengthBindings.erase(this->schema->lengthBindings.begin() + i);
+            i--;
+        }
+    }
+    this->schema->lengthBindings.push_back({lengthNode, targetNode, static_cast<unsigned char>(encoding), adjustment, maxSize});
+    lengthNode->setSize(getLengthWidth(encoding));
+    this->compileFormat();
+    return 0;
+}
+
+/**
+ * @brief Declares a built-in checksum validator on the frame format.
+ *
+ * The checksum is computed incrementally over the covered fields as they are parsed (the bytes are not copied), and compared with the
+ * checksum field when it is received. A frame with an invalid checksum is handled as an invalid frame, so no post-execute function is
+ * needed to validate it. When a frame is sent with `sendFramedData`, the checksum field is computed from the covered fields.
+ * The size of the checksum field is set to the size of the checksum, which is stored with the default byte order of the algorithm.
+ *
+ * @param[in] validatorIdx The index of the checksum field in the frame format (usually a `FRAME_TYPE_VALIDATOR` field).
+ * @param[in] beginIdx The index of the first field covered by the checksum.
+ * @param[in] endIdx The index of the last field covered by the checksum, it must come before the checksum field.
+ * @param[in] algorithm The validation algorithm.
+ * @return `0` on success.
+ * @return `1` if the frame format is not set up or an index is invalid.
+ */
+int SynapSock::setValidator(int validatorIdx, int beginIdx, int endIdx, Checksum::ALGORITHM_t algorithm){
+    return this->setValidator(validatorIdx, beginIdx, endIdx, algorithm, Checksum::isBigEndian(algorithm));
+}
+
+/**
+ * @brief Overloaded method of `setValidator` with the byte order of the checksum.
+ *
+ * @param[in] validatorIdx The index of the checksum field in the frame format (usually a `FRAME_TYPE_VALIDATOR` field).
+ * @param[in] beginIdx The index of the first field covered by the checksum.
+ * @param[in] endIdx The index of the last field covered by the checksum, it must come before the checksum field.
+ * @param[in] algorithm The validation algorithm.
+ * @param[in] isBigEndian `true` if the checksum is stored big-endian, `false` if it is stored little-endian.
+ * @return `0` on success.
+ * @return `1` if the frame format is not set up or an index is invalid.
+ */
+int SynapSock::setValidator(int validatorIdx, int beginIdx, int endIdx, Checksum::ALGORITHM_t algorithm, bool isBigEndian){
+    this->detachFormat();
+    DataFrame *validatorNode = (*this)[validatorIdx];
+    DataFrame *beginNode = (*this)[beginIdx];
+    DataFrame *endNode = (*this)[endIdx];
+    if (validatorNode == nullptr || beginNode == nullptr || endNode == nullptr) return 1;
+    if (beginIdx > endIdx || endIdx >= validatorIdx || algorithm > Checksum::CHECKSUM_XOR8) return 1;
+    if (this->schema->parsePlan[validatorIdx].op != SynapSock::PARSE_OP_FIELD && this->schema->parsePlan[validatorIdx].op != SynapSock::PARSE_OP_VALIDATOR) return 1;
+    for (size_t i = 0; i < this->schema->validatorBindings.size(); i++){
+        if (this->schema->validatorBindings[i].validatorNode == validatorNode){
+            this->schema->validatorBindings.erase(this->schema->validatorBindings.begin() + i);
+            break;
+        }
+    }
+    this->schema->validatorBindings.push_back({validatorNode, beginNode, endNode, static_cast<unsigned char>(algorithm), isBigEndian});
+    validatorNode->setSize(Checksum::getSize(algorithm));
+    this->compileFormat();
+    return 0;
+}
+
+/**
+ * @brief Sets the handler that is called before a field of the frame format is parsed.
+ *
+ * The handler (lambda, `std::function` or function object) is stored inline in the compiled frame format without allocation and
+ * replaces the execute function of the field for this connection, so it can carry per-connection state instead of a `void *` parameter.
+ *
+ * @param[in] idx The index of the field in the frame format.
+ * @param[in] func The handler, called with the field (an empty handler restores the execute function of the field).
+ * @return `0` on success.
+ * @return `1` if the frame format is not set up or the index is invalid.
+ */
+int SynapSock::setExecuteHandler(int idx, const FRAME_HOOK_t &func){
+    return this->setFieldHandler(idx, func, false);
+}
+
+/**
+ * @brief Sets the handler that is called after a field of the frame format is parsed.
+ *
+ * The handler (lambda, `std::function` or function object) is stored inline in the compiled frame format without allocation and
+ * replaces the post-execute function of the field for this connection, for example to size the next field or to validate the field.
+ *
+ * @param[in] idx The index of the field in the frame format.
+ * @param[in] func The handler, called with the field (an empty handler restores the post-execute function of the field).
+ * @return `0` on success.
+ * @return `1` if the frame format is not set up or the index is invalid.
+ */
+int SynapSock::setPostExecuteHandler(int idx, const FRAME_HOOK_t &func){
+    return this->setFieldHandler(idx, func, true);
+}
+
 /**
  * @brief Performs socket data receive operations with a custom frame format.
  *
  * This function executes socket data receiving operations using a specific frame format.
  * The receive socket data can be retrieved using the `__Serial::getBuffer__` method.
+ * In resync mode (see `setResync`), or with a shared frame format (see `setFormat`), invalid data is skipped inside the receive buffer and `4` is never returned.
  *
  * @return 0 on success.
  * @return 1 if the port is not open.
@@ -220,74 +776,99 @@ void SynapSock::trigInvDataIndicator(){
  * @return 4 if the frame data format is invalid.
  */
 int SynapSock::receiveFramedData(){
-    if (this->frameFormat == nullptr){
+    if (this->schema->frameFormat == nullptr){
         this->receiveData();
         return 3;
     }
-    DataFrame *tmp = this->frameFormat;
+    /* the fields of a shared frame format are not written, so the frame is parsed in the receive buffer */
+    if (this->isResync || this->isSchemaShared) return this->receiveFrameResync();
+    DataFrame *tmp = nullptr;
     std::vector <unsigned char> vecUC;
+    size_t fieldSize = 0;
+    size_t length = 0;
+    const unsigned char *stepData = nullptr;
+    size_t stepSize = 0;
     int ret = 0;
-    void (*callback)(DataFrame &, void *) = nullptr;
     this->isFormatValid = true;
-    while (tmp != nullptr){
-        if (tmp->getExecuteFunction() != nullptr){
-            callback = (void (*)(DataFrame &, void *))tmp->getExecuteFunction();
-            callback(*tmp, tmp->getExecuteFunctionParam());
+    /* the fields are appended to one contiguous block as they are received, so the frame does not have to be rebuilt from the fields */
+    this->frameData.clear();
+    for (size_t i = 0; i < this->schema->parsePlan.size(); i++){
+        const PARSE_STEP_t &step = this->schema->parsePlan[i];
+        tmp = step.node;
+        this->executeStep(step);
+        if (step.op == SynapSock::PARSE_OP_START_BYTES){
+            if (this->receiveStartBytes(step.delimiter.data(), step.delimiter.size())){
+                ret = 2;
+                break;
+            }
+            stepData = step.delimiter.data();
+            stepSize = step.delimiter.size();
         }
-        if (tmp->getType() == DataFrame::FRAME_TYPE_START_BYTES && tmp->getReference(vecUC) > 0){
-            if (this->receiveStartBytes(vecUC.data(), vecUC.size())){
+        else if (step.op == SynapSock::PARSE_OP_STOP_BYTES){
+            if (this->receiveStopBytes(step.delimiter.data(), step.delimiter.size())){
                 ret = 2;
                 break;
             }
+            stepData = step.delimiter.data();
+            stepSize = step.delimiter.size();
         }
-        else if (tmp->getType() == DataFrame::FRAME_TYPE_STOP_BYTES && tmp->getReference(vecUC) > 0){
-            if (this->receiveStopBytes(vecUC.data(), vecUC.size())){
+        else if (step.op == SynapSock::PARSE_OP_LENGTH){
+            size_t chunk = getLengthWidth(step.lengthEncoding);
+            int status = 2;
+            this->data.clear();
+            /* a varint is received byte by byte up to its last byte */
+            if (chunk == 0) chunk = 1;
+            while (status == 2){
+                this->data.resize(this->data.size() + chunk);
+                if (this->receiveNBytes(this->data.data() + this->data.size() - chunk, chunk) != 0) break;
+                status = SynapSock::decodeLength(this->data.data(), this->data.size(), step, &fieldSize, &length);
+                chunk = 1;
+            }
+            if (status == 2){
                 ret = 2;
                 break;
             }
+            tmp->setData(this->data);
+            if (status != 0){
+                ret = 4;
+                break;
+            }
+            this->stepStates[step.lengthTarget].boundSize = length;
+            this->schema->parsePlan[step.lengthTarget].node->setSize(length);
+            stepData = this->data.data();
+            stepSize = this->data.size();
         }
-        else if (tmp->getType() == DataFrame::FRAME_TYPE_CONTENT_LENGTH ||
-                 tmp->getType() == DataFrame::FRAME_TYPE_DATA ||
-                 tmp->getType() == DataFrame::FRAME_TYPE_VALIDATOR ||
-                 tmp->getType() == DataFrame::FRAME_TYPE_COMMAND
-        ){
-            if (tmp->getSize() > 0){
-                if (this->receiveNBytes(tmp->getSize()) == 0){
-                    if (this->getBuffer(vecUC) > 0){
-                        tmp->setData(vecUC);
-                    }
-                    else {
-                        ret = 2;
-                        break;
-                    }
+        else if (step.op == SynapSock::PARSE_OP_FIELD){
+            if (step.isSizeBound || tmp->getSize() > 0){
+                this->data.resize(step.isSizeBound ? this->stepStates[i].boundSize : tmp->getSize());
+                if (this->receiveNBytes(this->data.data(), this->data.size()) == 0){
+                    tmp->setData(this->data);
                 }
+                stepData = this->data.data();
+                stepSize = this->data.size();
             }
-            else if (tmp->getNext() != nullptr) {
-                if (tmp->getNext()->getType() == DataFrame::FRAME_TYPE_STOP_BYTES &&
-                    tmp->getNext()->getReference(vecUC) > 0
-                ){
-                    if (this->receiveUntillStopBytes(vecUC.data(), vecUC.size()) == 0){
-                        if (this->getBuffer(vecUC) > 0){
-                            size_t sz = vecUC.size() - tmp->getNext()->getSize();
-                            tmp->setData(vecUC.data(), sz);
-                            if (tmp->getPostExecuteFunction() != nullptr){
-                                callback = (void (*)(DataFrame &, void *))tmp->getPostExecuteFunction();
-                                callback(*tmp, tmp->getPostExecuteFunctionParam());
-                            }
-                            tmp = tmp->getNext();
-                            if (tmp->getExecuteFunction() != nullptr){
-                                callback = (void (*)(DataFrame &, void *))tmp->getExecuteFunction();
-                                callback(*tmp, tmp->getExecuteFunctionParam());
-                            }
-                        }
-                    }
-                    else {
-                        ret = 2;
-                        break;
+            else if (step.delimiter.size() > 0){
+                if (this->receiveUntillStopBytes(step.delimiter.data(), step.delimiter.size()) == 0){
+                    if (this->data.size() > 0){
+                        size_t sz = this->data.size() - step.delimiter.size();
+                        tmp->setData(this->data.data(), sz);
+                        this->stepStates[i].fieldOffset = this->frameData.size();
+                        this->stepStates[i].fieldSize = sz;
+                        this->frameData.insert(this->frameData.end(), this->data.begin(), this->data.begin() + sz);
+                        if (!this->schema->validatorSteps.empty()) this->updateValidators(i, this->data.data(), sz);
+                        this->postExecuteStep(step);
+                        /* the stop bytes have been received with the field */
+                        i++;
+                        tmp = this->schema->parsePlan[i].node;
+                        stepData = step.delimiter.data();
+                        stepSize = step.delimiter.size();
+                        this->executeStep(this->schema->parsePlan[i]);
                     }
                 }
                 else {
-                    ret = 4;
+                    /* the bytes received so far are handed back with the failed frame */
+                    this->takeStopBytesPending();
+                    ret = 2;
                     break;
                 }
             }
@@ -296,28 +877,47 @@ int SynapSock::receiveFramedData(){
                 break;
             }
         }
+        else if (step.op == SynapSock::PARSE_OP_VALIDATOR){
+            this->data.resize(Checksum::getSize(static_cast<Checksum::ALGORITHM_t>(step.checksumAlgorithm)));
+            if (this->receiveNBytes(this->data.data(), this->data.size()) != 0){
+                ret = 2;
+                break;
+            }
+            tmp->setData(this->data);
+            if (SynapSock::isChecksumValid(step, this->stepStates[i].checksumValue, this->data.data()) == false){
+                ret = 4;
+                break;
+            }
+            stepData = this->data.data();
+            stepSize = this->data.size();
+        }
         else {
             ret = 4;
             break;
         }
-        if (tmp->getPostExecuteFunction() != nullptr){
-            callback = (void (*)(DataFrame &, void *))tmp->getPostExecuteFunction();
-            callback(*tmp, tmp->getPostExecuteFunctionParam());
-        }
+        this->stepStates[i].fieldOffset = this->frameData.size();
+        this->stepStates[i].fieldSize = stepSize;
+        if (stepSize > 0) this->frameData.insert(this->frameData.end(), stepData, stepData + stepSize);
+        if (!this->schema->validatorSteps.empty()) this->updateValidators(i, stepData, stepSize);
+        this->postExecuteStep(this->schema->parsePlan[i]);
         if (this->isFormatValid == false){
             ret = 4;
             break;
         }
-        tmp = tmp->getNext();
         this->data.clear();
     }
+    if (ret != 0){
+        /* the data of the failed frame is handed back below, so the stop bytes search must not keep it pending */
+        this->resetStopBytesMatcher();
+    }
     if (ret == 0){
-        this->frameFormat->getAllData(this->data);
+        /* the previous receive buffer becomes the scratch space of the next frame */
+        this->data.swap(this->frameData);
     }
-    else if (ret != 4 && this->frameFormat != tmp && tmp->getType() == DataFrame::FRAME_TYPE_STOP_BYTES){
+    else if (ret != 4 && this->schema->frameFormat != tmp && tmp->getType() == DataFrame::FRAME_TYPE_STOP_BYTES){
         DataFrame *fail = tmp;
         std::vector <unsigned char> dataFail;
-        tmp = this->frameFormat;
+        tmp = this->schema->frameFormat;
         while (tmp != fail && tmp != nullptr){
             tmp->getData(vecUC);
             if (vecUC.size() > 0) dataFail.insert(dataFail.end(), vecUC.begin(), vecUC.end());
@@ -333,7 +933,7 @@ int SynapSock::receiveFramedData(){
     else if (tmp != nullptr){
         DataFrame *fail = tmp;
         std::vector <unsigned char> dataFail;
-        tmp = this->frameFormat;
+        tmp = this->schema->frameFormat;
         while (tmp != fail && tmp != nullptr){
             tmp->getData(vecUC);
             if (vecUC.size() > 0) dataFail.insert(dataFail.end(), vecUC.begin(), vecUC.end());
@@ -341,85 +941,1129 @@ int SynapSock::receiveFramedData(){
         }
         if (dataFail.size() > 0) this->data.insert(this->data.begin(), dataFail.begin(), dataFail.end());
     }
+    this->updateReceiveUsage();
     return ret;
 }
 
 /**
- * @brief Performs socket data send operations with a custom frame format.
+ * @brief Parses one frame from a buffer with the frame format, resuming from the parse state.
  *
- * This function executes socket data send operations using a specific frame format.
+ * This method runs the parse plan over the buffer without performing any read operation. The data of each field is stored in the frame format
+ * and the execute and post-execute functions are called, the same as `receiveFramedData` does (except for a shared frame format, which is only read). If the buffer ends inside the frame, the parse
+ * state is kept so the next call continues with the field (and the delimiter search) where this one stopped, every field is parsed and every
+ * execute function is called only once per frame.
  *
- * @return 0 on success.
- * @return 1 if the port is not open.
- * @return 2 if a timeout occurs.
- * @return 3 if there is no data to send.
+ * @param[in] buffer The buffer that holds the received data.
+ * @param[in] sz The size of the buffer.
+ * @param[in,out] cursor The parse state. When a frame is complete, `begin` and `pos` delimit the frame (the data before the start bytes is skipped).
+ * @return `0` if a complete frame has been parsed.
+ * @return `2` if the buffer does not hold a complete frame yet.
+ * @return `4` if the frame data format is invalid.
  */
-int SynapSock::sendFramedData(){
-    std::vector <unsigned char> buffer;
-    if (this->frameFormat->getAllData(buffer) > 0){
-        return this->sendData(buffer);
+int SynapSock::parseFrame(const unsigned char *buffer, size_t sz, PARSE_CURSOR_t &cursor){
+    DataFrame *tmp = nullptr;
+    size_t from = 0;
+    size_t idx = 0;
+    size_t fieldSize = 0;
+    size_t length = 0;
+    size_t stepBegin = 0;
+    int ret = 0;
+    if (cursor.step == 0 && cursor.isExecuted == false) this->isFormatValid = true;
+    while (cursor.step < this->schema->parsePlan.size()){
+        const PARSE_STEP_t &step = this->schema->parsePlan[cursor.step];
+        tmp = step.node;
+        if (cursor.isExecuted == false){
+            this->executeStep(step);
+            cursor.isExecuted = true;
+        }
+        /* the delimiter search continues after the data that has already been scanned */
+        from = (cursor.scanned > cursor.pos ? cursor.scanned : cursor.pos);
+        stepBegin = cursor.pos;
+        if (step.op == SynapSock::PARSE_OP_START_BYTES){
+            idx = ByteSearch::find(buffer + from, sz - from, step.delimiter.data(), step.delimiter.size());
+            if (idx == ByteSearch::NOT_FOUND){
+                /* only the tail may hold the beginning of the start bytes */
+                cursor.scanned = (sz - from >= step.delimiter.size() ? sz - (step.delimiter.size() - 1) : from);
+                if (cursor.step == 0) cursor.begin = cursor.pos = cursor.scanned;
+                return 2;
+            }
+            if (cursor.step == 0) cursor.begin = from + idx;
+            stepBegin = from + idx;
+            cursor.pos = from + idx + step.delimiter.size();
+        }
+        else if (step.op == SynapSock::PARSE_OP_STOP_BYTES){
+            if (sz - cursor.pos < step.delimiter.size()) return 2;
+            if (memcmp(buffer + cursor.pos, step.delimiter.data(), step.delimiter.size()) != 0) return 4;
+            cursor.pos += step.delimiter.size();
+        }
+        else if (step.op == SynapSock::PARSE_OP_LENGTH){
+            ret = SynapSock::decodeLength(buffer + cursor.pos, sz - cursor.pos, step, &fieldSize, &length);
+            if (ret == 2) return 2;
+            if (this->isSchemaShared == false) tmp->setData(buffer + cursor.pos, fieldSize);
+            if (ret != 0) return 4;
+            this->stepStates[step.lengthTarget].boundSize = length;
+            if (this->isSchemaShared == false) this->schema->parsePlan[step.lengthTarget].node->setSize(length);
+            cursor.pos += fieldSize;
+        }
+        else if (step.op == SynapSock::PARSE_OP_FIELD){
+            if (step.isSizeBound || tmp->getSize() > 0){
+                fieldSize = (step.isSizeBound ? this->stepStates[cursor.step].boundSize : tmp->getSize());
+                if (sz - cursor.pos < fieldSize) return 2;
+                if (this->isSchemaShared == false) tmp->setData(buffer + cursor.pos, fieldSize);
+                cursor.pos += fieldSize;
+            }
+            else if (step.delimiter.size() > 0){
+                idx = ByteSearch::find(buffer + from, sz - from, step.delimiter.data(), step.delimiter.size());
+                if (idx == ByteSearch::NOT_FOUND){
+                    cursor.scanned = (sz - from >= step.delimiter.size() ? sz - (step.delimiter.size() - 1) : from);
+                    return 2;
+                }
+                idx += from - cursor.pos;
+                if (this->isSchemaShared == false) tmp->setData(buffer + cursor.pos, idx);
+                this->stepStates[cursor.step].fieldOffset = cursor.pos - cursor.begin;
+                this->stepStates[cursor.step].fieldSize = idx;
+                if (!this->schema->validatorSteps.empty()) this->updateValidators(cursor.step, buffer + cursor.pos, idx);
+                this->postExecuteStep(step);
+                /* the stop bytes are consumed with the field */
+                cursor.step++;
+                tmp = this->schema->parsePlan[cursor.step].node;
+                this->executeStep(this->schema->parsePlan[cursor.step]);
+                stepBegin = cursor.pos + idx;
+                cursor.pos += idx + step.delimiter.size();
+            }
+            else {
+                return 4;
+            }
+        }
+        else if (step.op == SynapSock::PARSE_OP_VALIDATOR){
+            fieldSize = Checksum::getSize(static_cast<Checksum::ALGORITHM_t>(step.checksumAlgorithm));
+            if (sz - cursor.pos < fieldSize) return 2;
+            if (this->isSchemaShared == false) tmp->setData(buffer + cursor.pos, fieldSize);
+            if (SynapSock::isChecksumValid(step, this->stepStates[cursor.step].checksumValue, buffer + cursor.pos) == false) return 4;
+            cursor.pos += fieldSize;
+        }
+        else {
+            return 4;
+        }
+        this->stepStates[cursor.step].fieldOffset = stepBegin - cursor.begin;
+        this->stepStates[cursor.step].fieldSize = cursor.pos - stepBegin;
+        if (!this->schema->validatorSteps.empty()) this->updateValidators(cursor.step, buffer + stepBegin, cursor.pos - stepBegin);
+        this->postExecuteStep(this->schema->parsePlan[cursor.step]);
+        cursor.step++;
+        cursor.scanned = cursor.pos;
+        cursor.isExecuted = false;
+        if (this->isFormatValid == false) return 4;
     }
-    return 3;
+    return 0;
 }
 
 /**
- * @brief Retrieves a buffer of data receive and stored in the Framed Data within a specified range.
- *
- * This method extracts data from the buffer that has been successfully receive and stored in the Framed Data
- * within the specified range. This version is suitable for data with unique Frame Formats in each frame
- * (no duplicate Frame Types).
+ * @brief Calls the execute handler of a parse step, or the execute function of its field if no handler is declared.
  *
- * @param begin Reference to the starting point for data extraction.
- * @param end Reference to the ending point for data extraction.
- * @return A vector containing the data.
+ * @param[in] step The parse step.
  */
-std::vector <unsigned char> SynapSock::getSpecificBufferAsVector(DataFrame::FRAME_TYPE_t begin, DataFrame::FRAME_TYPE_t end){
-    DataFrame *tmpBegin = (*this)[begin];
-    DataFrame *tmpEnd = (*this)[end];
-    return this->frameFormat->getSpecificDataAsVector(tmpBegin, tmpEnd);
+void SynapSock::executeStep(const PARSE_STEP_t &step){
+    if (this->isSchemaShared) return;
+    if (step.execute){
+        step.execute(*(step.node));
+    }
+    else if (step.node->getExecuteFunction() != nullptr){
+        void (*callback)(DataFrame &, void *) = (void (*)(DataFrame &, void *))step.node->getExecuteFunction();
+        callback(*(step.node), step.node->getExecuteFunctionParam());
+    }
 }
 
 /**
- * @brief Overloaded method of __getSpecificBufferAsVector__.
- *
- * This method performs the same data extraction operation as the other overload but is designed to handle
- * cases where duplicate Frame Formats exist within the Framed Data. It retrieves data from the buffer
- * that has been successfully receive and stored within the specified range.
+ * @brief Calls the post-execute handler of a parse step, or the post-execute function of its field if no handler is declared.
  *
- * @param begin Pointer to the starting point for data extraction.
- * @param end Pointer to the ending point for data extraction.
- * @return A vector containing the data.
+ * @param[in] step The parse step.
+ */
+void SynapSock::postExecuteStep(const PARSE_STEP_t &step){
+    if (this->isSchemaShared) return;
+    if (step.postExecute){
+        step.postExecute(*(step.node));
+    }
+    else if (step.node->getPostExecuteFunction() != nullptr){
+        void (*callback)(DataFrame &, void *) = (void (*)(DataFrame &, void *))step.node->getPostExecuteFunction();
+        callback(*(step.node), step.node->getPostExecuteFunctionParam());
+    }
+}
+
+/**
+ * @brief Binds an execute or post-execute handler to a field of the frame format.
+ *
+ * @param[in] idx The index of the field in the frame format.
+ * @param[in] func The handler (an empty handler removes it).
+ * @param[in] isPost `true` for the post-execute handler, `false` for the execute handler.
+ * @return `0` on success.
+ * @return `1` if the frame format is not set up or the index is invalid.
+ */
+int SynapSock::setFieldHandler(int idx, const FRAME_HOOK_t &func, bool isPost){
+    this->detachFormat();
+    DataFrame *node = (*this)[idx];
+    size_t i = 0;
+    if (node == nullptr) return 1;
+    for (i = 0; i < this->schema->hookBindings.size(); i++){
+        if (this->schema->hookBindings[i].node == node) break;
+    }
+    if (i == this->schema->hookBindings.size()) this->schema->hookBindings.push_back({node, nullptr, nullptr});
+    if (isPost){
+        this->schema->hookBindings[i].postExecute = func;
+        this->schema->parsePlan[idx].postExecute = func;
+    }
+    else {
+        this->schema->hookBindings[i].execute = func;
+        this->schema->parsePlan[idx].execute = func;
+    }
+    this->resetSharedFormat();
+    return 0;
+}
+
+/**
+ * @brief Drops the snapshot taken by `shareFormat` after the frame format has changed, the next call takes a new one.
+ */
+void SynapSock::resetSharedFormat(){
+    pthread_mutex_lock(&(this->formatMtx));
+    this->sharedSchema = nullptr;
+    pthread_mutex_unlock(&(this->formatMtx));
+}
+
+/**
+ * @brief Restarts the parse state at the beginning of a frame.
+ *
+ * @param[in] offset The offset in the buffered data where the next frame is searched.
+ */
+void SynapSock::resetParseCursor(size_t offset){
+    this->parseCursor.step = 0;
+    this->parseCursor.begin = offset;
+    this->parseCursor.pos = offset;
+    this->parseCursor.scanned = offset;
+    this->parseCursor.isExecuted = false;
+}
+
+/**
+ * @brief Receives all the complete frames with the resumable parser.
+ *
+ * @param[out] frames A variable that holds the views of the received frames.
+ * @param[in] isWait `true` to wait (up to the timeout) for data if no complete frame is buffered, `false` to only parse the data that has already arrived.
+ * @return 0 on success.
+ * @return 1 if the port is not open.
+ * @return 2 if a timeout occurs or no complete frame is available.
+ * @return 3 if the frame format is not set up.
+ */
+int SynapSock::receiveFrames(std::vector <FRAME_VIEW_t> &frames, bool isWait){
+    size_t consumed = 0;
+    size_t dropped = 0;
+    size_t frameBytes = 0;
+    int ret = 0;
+    frames.clear();
+    if (this->schema->frameFormat == nullptr) return 3;
+    this->compactRemainingData();
+    if (this->remainingData.size() != this->parseCursorDataSize){
+        /* the remaining buffer has been consumed by another receive operation, parse it from the beginning */
+        this->resetParseCursor(0);
+    }
+    this->data.clear();
+    this->data.swap(this->remainingData);
+    while (true){
+        while (true){
+            ret = this->parseFrame(this->data.data(), this->data.size(), this->parseCursor);
+            if (ret == 0){
+                frames.push_back({this->data.data() + this->parseCursor.begin, this->parseCursor.pos - this->parseCursor.begin});
+                frameBytes += this->parseCursor.pos - this->parseCursor.begin;
+                this->resetParseCursor(this->parseCursor.pos);
+            }
+            else if (ret == 2){
+                break;
+            }
+            else {
+                /* resynchronize one byte past the start of the invalid frame, in the same buffer */
+                this->invalidFrames++;
+                this->resetParseCursor(this->parseCursor.begin + 1);
+            }
+        }
+        if (frames.size() > 0) break;
+        /* no frame has been referenced yet, so the skipped data can be dropped and the buffer may grow (and be reallocated) */
+        consumed = this->parseCursor.begin;
+        if (consumed > 0){
+            this->data.erase(this->data.begin(), this->data.begin() + consumed);
+            this->parseCursor.begin -= consumed;
+            this->parseCursor.pos -= consumed;
+            this->parseCursor.scanned -= consumed;
+            dropped += consumed;
+        }
+        ret = this->readAvailableData(this->data, isWait);
+        if (ret != 0) break;
+    }
+    /* keep the partial frame, the parse state refers to the remaining buffer from now on */
+    consumed = this->parseCursor.begin;
+    if (this->data.size() > consumed){
+        this->remainingData.assign(this->data.begin() + consumed, this->data.end());
+        this->data.resize(consumed);
+    }
+    this->parseCursor.begin -= consumed;
+    this->parseCursor.pos -= consumed;
+    this->parseCursor.scanned -= consumed;
+    this->parseCursorDataSize = this->remainingData.size();
+    this->skippedBytes += dropped + consumed - frameBytes;
+    this->updateReceiveUsage();
+    if (frames.size() > 0) return 0;
+    return ret;
+}
+
+/**
+ * @brief Receives all the complete frames with a compiled frame parser.
+ *
+ * @param[out] frames A variable that holds the views of the received frames.
+ * @param[in] parser The frame parser.
+ * @param[in] isWait `true` to wait (up to the timeout) for data if no complete frame is buffered, `false` to only parse the data that has already arrived.
+ * @return 0 on success.
+ * @return 1 if the port is not open.
+ * @return 2 if a timeout occurs or no complete frame is available.
+ * @return 3 if the parser is not set.
+ */
+int SynapSock::receiveParsedFrames(std::vector <FRAME_VIEW_t> &frames, FRAME_PARSER_t parser, bool isWait){
+    size_t offset = 0;
+    size_t begin = 0;
+    size_t size = 0;
+    size_t dropped = 0;
+    size_t frameBytes = 0;
+    int ret = 0;
+    frames.clear();
+    if (parser == nullptr) return 3;
+    this->compactRemainingData();
+    this->data.clear();
+    this->data.swap(this->remainingData);
+    while (true){
+        while (true){
+            ret = parser(this->data.data() + offset, this->data.size() - offset, &begin, &size);
+            if (ret == 0){
+                frames.push_back({this->data.data() + offset + begin, size});
+                frameBytes += size;
+                offset += begin + size;
+            }
+            else if (ret == 2){
+                offset += begin;
+                break;
+            }
+            else {
+                /* resynchronize one byte past the start of the invalid frame */
+                this->invalidFrames++;
+                offset += begin + 1;
+            }
+        }
+        if (frames.size() > 0) break;
+        if (offset > 0){
+            this->data.erase(this->data.begin(), this->data.begin() + offset);
+            dropped += offset;
+            offset = 0;
+        }
+        ret = this->readAvailableData(this->data, isWait);
+        if (ret != 0) break;
+    }
+    if (this->data.size() > offset){
+        this->remainingData.assign(this->data.begin() + offset, this->data.end());
+        this->data.resize(offset);
+    }
+    /* the remaining buffer is not described by the parse state of the frame format anymore */
+    this->resetParseCursor(0);
+    this->parseCursorDataSize = 0;
+    this->skippedBytes += dropped + offset - frameBytes;
+    this->updateReceiveUsage();
+    if (frames.size() > 0) return 0;
+    return ret;
+}
+
+/**
+ * @brief Receives one frame in resync mode.
+ *
+ * @return 0 on success.
+ * @return 1 if the port is not open.
+ * @return 2 if a timeout occurs.
+ */
+int SynapSock::receiveFrameResync(){
+    size_t consumed = 0;
+    size_t dropped = 0;
+    int ret = 0;
+    /* the frames are parsed in the remaining buffer, the delivered frames are only skipped by advancing the offset */
+    if (this->remainingData.size() != this->parseCursorDataSize){
+        /* the remaining buffer has been consumed by another receive operation, parse it from the first undelivered byte */
+        this->resetParseCursor(this->remainingOffset);
+    }
+    this->data.clear();
+    while (true){
+        ret = this->parseFrame(this->remainingData.data(), this->remainingData.size(), this->parseCursor);
+        if (ret == 0) break;
+        if (ret != 2){
+            /* resynchronize one byte past the start of the invalid frame, in the same buffer */
+            this->invalidFrames++;
+            this->resetParseCursor(this->parseCursor.begin + 1);
+            continue;
+        }
+        /* the buffer is compacted once before each read, the delivered frames and the skipped data are dropped */
+        consumed = this->parseCursor.begin;
+        dropped += consumed - this->remainingOffset;
+        this->remainingData.erase(this->remainingData.begin(), this->remainingData.begin() + consumed);
+        this->remainingOffset = 0;
+        this->parseCursor.begin -= consumed;
+        this->parseCursor.pos -= consumed;
+        this->parseCursor.scanned -= consumed;
+        ret = this->readAvailableData(this->remainingData, true);
+        if (ret != 0) break;
+    }
+    if (ret == 0){
+        dropped += this->parseCursor.begin - this->remainingOffset;
+        this->data.assign(this->remainingData.begin() + this->parseCursor.begin, this->remainingData.begin() + this->parseCursor.pos);
+        this->remainingOffset = this->parseCursor.pos;
+        this->resetParseCursor(this->remainingOffset);
+    }
+    if (this->remainingOffset == this->remainingData.size()){
+        this->remainingData.clear();
+        this->remainingOffset = 0;
+        this->resetParseCursor(0);
+    }
+    this->parseCursorDataSize = this->remainingData.size();
+    this->skippedBytes += dropped;
+    this->updateReceiveUsage();
+    return ret;
+}
+
+/**
+ * @brief Receives all the complete frames that are available with a custom frame format.
+ *
+ * This method parses every complete frame in the buffered data in one pass, and only performs a read operation (that reads all the available data at once)
+ * if no complete frame is buffered yet. Invalid data is skipped. An incomplete frame is kept in the remaining buffer and completed by the next call.
+ * The frames are returned as views into the connection buffer, they are only valid until the next receive operation on this connection.
+ * The frame format is used as scratch space while parsing, so use the views to access the data of each frame.
+ *
+ * @param[out] frames A variable that holds the views of the received frames.
+ * @return 0 on success.
+ * @return 1 if the port is not open.
+ * @return 2 if a timeout occurs.
+ * @return 3 if the frame format is not set up.
+ */
+int SynapSock::receiveFramedDataBatch(std::vector <FRAME_VIEW_t> &frames){
+    return this->receiveFrames(frames, true);
+}
+
+/**
+ * @brief Overloaded method of `receiveFramedDataBatch` with a compiled frame parser.
+ *
+ * The frames are parsed by `parser` (for example `&Format::parse` of a `FrameDsl::Frame` format) instead of the frame format of this
+ * connection, so the frame format does not need to be set up. Invalid data is skipped and an incomplete frame is kept in the remaining buffer.
+ *
+ * @param[out] frames A variable that holds the views of the received frames.
+ * @param[in] parser The frame parser.
+ * @return 0 on success.
+ * @return 1 if the port is not open.
+ * @return 2 if a timeout occurs.
+ * @return 3 if the parser is not set.
+ */
+int SynapSock::receiveFramedDataBatch(std::vector <FRAME_VIEW_t> &frames, FRAME_PARSER_t parser){
+    return this->receiveParsedFrames(frames, parser, true);
+}
+
+/**
+ * @brief Parses the complete frames from the data that has already arrived, without blocking.
+ *
+ * This method is intended for event loops (for example the reception handler of `TCPServer`): it reads the data that is available without waiting,
+ * feeds it to the resumable parser and returns the frames that have been completed. A partial frame keeps its parse state (current field and
+ * delimiter search position) in the connection, so the next call continues where this one stopped instead of parsing the frame again.
+ * The frames are returned as views into the connection buffer, they are only valid until the next receive operation on this connection.
+ *
+ * @param[out] frames A variable that holds the views of the received frames.
+ * @return 0 if at least one frame has been completed.
+ * @return 1 if the port is not open.
+ * @return 2 if no complete frame is available yet.
+ * @return 3 if the frame format is not set up.
+ */
+int SynapSock::pollFramedData(std::vector <FRAME_VIEW_t> &frames){
+    return this->receiveFrames(frames, false);
+}
+
+/**
+ * @brief Overloaded method of `pollFramedData` with a compiled frame parser.
+ *
+ * @param[out] frames A variable that holds the views of the received frames.
+ * @param[in] parser The frame parser (for example `&Format::parse` of a `FrameDsl::Frame` format).
+ * @return 0 if at least one frame has been completed.
+ * @return 1 if the port is not open.
+ * @return 2 if no complete frame is available yet.
+ * @return 3 if the parser is not set.
+ */
+int SynapSock::pollFramedData(std::vector <FRAME_VIEW_t> &frames, FRAME_PARSER_t parser){
+    return this->receiveParsedFrames(frames, parser, false);
+}
+
+/**
+ * @brief Performs socket data send operations with a custom frame format.
+ *
+ * This function executes socket data send operations using a specific frame format. Each field of the frame format is sent as a separate
+ * buffer of a single scatter-gather write, the fields are not concatenated into one buffer first.
+ *
+ * @return 0 on success.
+ * @return 1 if the port is not open.
+ * @return 2 if a timeout occurs.
+ * @return 3 if there is no data to send, or if the size of a bound field does not fit in its length field or exceeds its maximum size.
+ */
+int SynapSock::sendFramedData(){
+    return this->sendFramedData(nullptr);
+}
+
+/**
+ * @brief Overloaded method of `sendFramedData` that reports whether the connection still holds the frame after a failed write operation.
+ *
+ * @param[out] isQueued A variable that is set to `true` if (a part of) the frame is held by the output queue or the cork buffer (may be `nullptr`).
+ * @return 0 on success.
+ * @return 1 if the port is not open.
+ * @return 2 if a timeout occurs.
+ * @return 3 if there is no data to send, or if the size of a bound field does not fit in its length field or exceeds its maximum size.
+ */
+int SynapSock::sendFramedData(bool *isQueued){
+    size_t idx = 0;
+    if (isQueued != nullptr) *isQueued = false;
+    size_t total = 0;
+    DataFrame *tmp = this->schema->frameFormat;
+    while (tmp != nullptr){
+        if (idx >= this->sendSegments.size()){
+            this->sendSegments.emplace_back();
+        }
+        total += tmp->getData(this->sendSegments[idx]);
+        idx++;
+        tmp = tmp->getNext();
+    }
+    for (size_t i = 0; i < this->schema->parsePlan.size() && i < idx; i++){
+        if (this->schema->parsePlan[i].op != SynapSock::PARSE_OP_LENGTH) continue;
+        total -= this->sendSegments[i].size();
+        if (SynapSock::encodeLength(this->sendSegments[i], this->schema->parsePlan[i], this->sendSegments[this->schema->parsePlan[i].lengthTarget].size()) == false){
+            return 3;
+        }
+        total += this->sendSegments[i].size();
+    }
+    for (size_t i = 0; i < this->schema->validatorSteps.size(); i++){
+        const PARSE_STEP_t &step = this->schema->parsePlan[this->schema->validatorSteps[i]];
+        Checksum::ALGORITHM_t algorithm = static_cast<Checksum::ALGORITHM_t>(step.checksumAlgorithm);
+        uint32_t value = Checksum::init(algorithm);
+        if (this->schema->validatorSteps[i] >= idx) continue;
+        for (size_t j = step.checksumBegin; j <= step.checksumEnd; j++){
+            value = Checksum::update(algorithm, value, this->sendSegments[j].data(), this->sendSegments[j].size());
+        }
+        total -= this->sendSegments[this->schema->validatorSteps[i]].size();
+        SynapSock::encodeChecksum(this->sendSegments[this->schema->validatorSteps[i]], step, value);
+        total += this->sendSegments[this->schema->validatorSteps[i]].size();
+    }
+    if (total == 0) return 3;
+    this->sendIov.resize(idx);
+    for (size_t i = 0; i < idx; i++){
+        this->sendIov[i].iov_base = (void *) this->sendSegments[i].data();
+        this->sendIov[i].iov_len = this->sendSegments[i].size();
+    }
+    return this->sendData(this->sendIov.data(), (int) idx, isQueued);
+}
+
+/**
+ * @brief Overloaded method of `sendFramedData` that encodes the frame from the values of its fields.
+ *
+ * The frame is encoded with `FrameSchema::encode` into a buffer of the output buffer pool of this connection and sent with one write, the
+ * fields of the frame format are not modified. Several threads may send frames on the same connection at the same time, as long as the frame
+ * format is not changed meanwhile.
+ *
+ * @param[in] fields The value of every field, indexed as the frame format (see `FrameSchema::encode`).
+ * @param[in] count The number of values, it must be the number of fields of the frame format.
+ * @return 0 on success.
+ * @return 1 if the port is not open.
+ * @return 2 if a timeout occurs.
+ * @return 3 if the frame format is not set up, the number of values is invalid or the size of a bound field does not fit in its length field (or exceeds its maximum size), or if a value does not match its field (a fixed size field with a value of another size, or a delimited field whose value contains its stop bytes).
+ */
+int SynapSock::sendFramedData(const FieldView *fields, size_t count){
+    BufferPool::BUFFER_t buffer = this->sendPool.acquire();
+    if (this->schema->encode(fields, count, *buffer) != 0) return 3;
+    /* the buffer goes back to the pool once it has been sent (in zero-copy send mode, once the kernel has released it) */
+    return this->sendData(std::shared_ptr <const std::vector <unsigned char>>(buffer));
+}
+
+/**
+ * @brief Encodes a frame from the values of its fields with the frame format of this connection.
+ *
+ * See `FrameSchema::encode`. This method does not modify the connection, it may be called from any thread as long as the frame format is not changed meanwhile.
+ *
+ * @param[in] fields The value of every field, indexed as the frame format.
+ * @param[in] count The number of values, it must be the number of fields of the frame format.
+ * @param[out] buffer A variable that holds the encoded frame.
+ * @return `0` on success.
+ * @return `1` if the frame format is not set up, the number of values is invalid or the size of a bound field does not fit in its length field (or exceeds its maximum size), or if a value does not match its field (a fixed size field with a value of another size, or a delimited field whose value contains its stop bytes).
+ */
+int SynapSock::encodeFramedData(const FieldView *fields, size_t count, std::vector <unsigned char> &buffer){
+    return this->schema->encode(fields, count, buffer);
+}
+
+/**
+ * @brief Creates a frame template from the values of its fields with the frame format of this connection.
+ *
+ * The frame is encoded once with `FrameSchema::encode`, then only the patched fields are written for each frame sent with the template.
+ *
+ * @param[out] frame The template.
+ * @param[in] fields The value of every field, indexed as the frame format (see `FrameSchema::encode`).
+ * @param[in] count The number of values, it must be the number of fields of the frame format.
+ * @return `0` on success.
+ * @return `1` if the frame format is not set up, the number of values is invalid or the size of a bound field does not fit in its length field (or exceeds its maximum size), or if a value does not match its field (a fixed size field with a value of another size, or a delimited field whose value contains its stop bytes).
+ */
+int SynapSock::createFrameTemplate(FrameTemplate &frame, const FieldView *fields, size_t count){
+    if (this->schema->encode(fields, count, frame.frame) != 0) return 1;
+    frame.parsePlan = this->schema->parsePlan;
+    frame.offsets.resize(count + 1);
+    frame.offsets[0] = 0;
+    for (size_t i = 0; i < count; i++){
+        frame.offsets[i + 1] = frame.offsets[i] + this->schema->getEncodedSize(i, fields);
+    }
+    frame.patchPoints.clear();
+    frame.isValidated = true;
+    return 0;
+}
+
+/**
+ * @brief Overloaded method of `sendFramedData` that sends a frame template.
+ *
+ * The checksum fields of the template are computed again if a covered field has been patched, then the frame is sent with one write.
+ *
+ * @param[in] frame The template, created with `createFrameTemplate`.
+ * @return 0 on success.
+ * @return 1 if the port is not open.
+ * @return 2 if a timeout occurs.
+ * @return 3 if the template has not been created.
+ */
+int SynapSock::sendFramedData(FrameTemplate &frame){
+    FieldView data = frame.getFrame();
+    if (data.isEmpty()) return 3;
+    return this->sendData(data.getData(), data.getSize());
+}
+
+/**
+ * @brief Default constructor, creates an empty template.
+ */
+SynapSock::FrameTemplate::FrameTemplate(){
+    this->isValidated = true;
+}
+
+/**
+ * @brief Replaces the bytes of a field, the next fields are moved if the size changes.
+ *
+ * @param[in] idx The index of the field.
+ * @param[in] data The new bytes of the field.
+ * @param[in] sz The number of new bytes.
+ */
+void SynapSock::FrameTemplate::replaceField(size_t idx, const unsigned char *data, size_t sz){
+    size_t offset = this->offsets[idx];
+    size_t current = this->offsets[idx + 1] - offset;
+    if (sz > current){
+        this->frame.insert(this->frame.begin() + offset + current, sz - current, 0x00);
+    }
+    else if (sz < current){
+        this->frame.erase(this->frame.begin() + offset + sz, this->frame.begin() + offset + current);
+    }
+    if (sz > 0) memcpy(this->frame.data() + offset, data, sz);
+    for (size_t i = idx + 1; i < this->offsets.size(); i++){
+        this->offsets[i] = this->offsets[i] + sz - current;
+    }
+}
+
+/**
+ * @brief Names a field of the template.
+ *
+ * @param[in] name The name of the patch point.
+ * @param[in] idx The index of the field in the frame format.
+ * @return `0` on success.
+ * @return `1` if the index is invalid, or the field is start bytes, stop bytes, or a declared length or checksum field (they are computed).
+ */
+int SynapSock::FrameTemplate::setPatchPoint(const std::string &name, int idx){
+    if (idx < 0 || (size_t) idx >= this->parsePlan.size()) return 1;
+    if (this->parsePlan[idx].op != SynapSock::PARSE_OP_FIELD && this->parsePlan[idx].op != SynapSock::PARSE_OP_INVALID) return 1;
+    for (size_t i = 0; i < this->patchPoints.size(); i++){
+        if (this->patchPoints[i].first == name){
+            this->patchPoints[i].second = (size_t) idx;
+            return 0;
+        }
+    }
+    this->patchPoints.push_back({name, (size_t) idx});
+    return 0;
+}
+
+/**
+ * @brief Gets the index of the field of a patch point.
+ *
+ * @param[in] name The name of the patch point.
+ * @return the index of the field (`-1` if there is no patch point with this name).
+ */
+int SynapSock::FrameTemplate::getPatchPoint(const std::string &name){
+    for (size_t i = 0; i < this->patchPoints.size(); i++){
+        if (this->patchPoints[i].first == name) return (int) this->patchPoints[i].second;
+    }
+    return -1;
+}
+
+/**
+ * @brief Changes the value of a field.
+ *
+ * The bytes are copied in place when the size does not change. Otherwise the next fields are moved and the length field bound to the
+ * field (if any) is encoded again.
+ *
+ * @param[in] idx The index of the field in the frame format.
+ * @param[in] value The new value of the field.
+ * @return `0` on success.
+ * @return `1` if the index is invalid, the field is start bytes, stop bytes, or a declared length or checksum field, or the new size does not
+ * fit in the length field bound to the field (or exceeds its maximum size). The template is then not modified.
+ */
+int SynapSock::FrameTemplate::patch(int idx, const FieldView &value){
+    unsigned char length[10];
+    size_t sz = 0;
+    bool isResized = false;
+    if (idx < 0 || (size_t) idx >= this->parsePlan.size()) return 1;
+    if (this->parsePlan[idx].op != SynapSock::PARSE_OP_FIELD && this->parsePlan[idx].op != SynapSock::PARSE_OP_INVALID) return 1;
+    /* the bound length fields are checked before anything is written */
+    for (size_t i = 0; i < (size_t) idx; i++){
+        if (this->parsePlan[i].op != SynapSock::PARSE_OP_LENGTH || this->parsePlan[i].lengthTarget != (size_t) idx) continue;
+        if (SynapSock::encodeLength(length, this->parsePlan[i], value.getSize()) == 0) return 1;
+    }
+    if (value.getSize() == this->offsets[idx + 1] - this->offsets[idx]){
+        if (value.getSize() > 0) memcpy(this->frame.data() + this->offsets[idx], value.getData(), value.getSize());
+    }
+    else {
+        isResized = true;
+        this->replaceField((size_t) idx, value.getData(), value.getSize());
+        for (size_t i = 0; i < (size_t) idx; i++){
+            if (this->parsePlan[i].op != SynapSock::PARSE_OP_LENGTH || this->parsePlan[i].lengthTarget != (size_t) idx) continue;
+            sz = SynapSock::encodeLength(length, this->parsePlan[i], value.getSize());
+            this->replaceField(i, length, sz);
+        }
+    }
+    /* a checksum is only stale if it covers the field, or the length field that has been encoded again */
+    for (size_t i = 0; i < this->parsePlan.size() && this->isValidated; i++){
+        const PARSE_STEP_t &step = this->parsePlan[i];
+        if (step.op != SynapSock::PARSE_OP_VALIDATOR) continue;
+        if (step.checksumBegin <= (size_t) idx && (size_t) idx <= step.checksumEnd) this->isValidated = false;
+        for (size_t j = step.checksumBegin; j <= step.checksumEnd && isResized && this->isValidated; j++){
+            if (this->parsePlan[j].op == SynapSock::PARSE_OP_LENGTH && this->parsePlan[j].lengthTarget == (size_t) idx) this->isValidated = false;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Overloaded method of `patch` with the name of a patch point.
+ *
+ * @param[in] name The name of the patch point.
+ * @param[in] value The new value of the field.
+ * @return `0` on success.
+ * @return `1` if there is no patch point with this name.
+ */
+int SynapSock::FrameTemplate::patch(const std::string &name, const FieldView &value){
+    int idx = this->getPatchPoint(name);
+    if (idx < 0) return 1;
+    return this->patch(idx, value);
+}
+
+/**
+ * @brief Gets a field of the template.
+ *
+ * @param[in] idx The index of the field in the frame format.
+ * @return view of the field (empty if the index is invalid), valid until the template is patched.
+ */
+FieldView SynapSock::FrameTemplate::getField(int idx){
+    if (idx < 0 || (size_t) idx >= this->parsePlan.size()) return FieldView();
+    if (this->isValidated == false) this->getFrame();
+    return FieldView(this->frame.data() + this->offsets[idx], this->offsets[idx + 1] - this->offsets[idx]);
+}
+
+/**
+ * @brief Gets the encoded frame, the checksum fields are computed first if a covered field has been patched.
+ *
+ * @return view of the frame (empty if the template has not been created), valid until the template is patched.
+ */
+FieldView SynapSock::FrameTemplate::getFrame(){
+    if (this->isValidated == false){
+        for (size_t i = 0; i < this->parsePlan.size(); i++){
+            const PARSE_STEP_t &step = this->parsePlan[i];
+            if (step.op != SynapSock::PARSE_OP_VALIDATOR) continue;
+            Checksum::ALGORITHM_t algorithm = static_cast<Checksum::ALGORITHM_t>(step.checksumAlgorithm);
+            size_t begin = this->offsets[step.checksumBegin];
+            uint32_t value = Checksum::update(algorithm, Checksum::init(algorithm), this->frame.data() + begin, this->offsets[step.checksumEnd + 1] - begin);
+            SynapSock::encodeChecksum(this->frame.data() + this->offsets[i], step, value);
+        }
+        this->isValidated = true;
+    }
+    return FieldView(this->frame.data(), this->frame.size());
+}
+
+/**
+ * @brief Retrieves a buffer of data receive and stored in the Framed Data within a specified range.
+ *
+ * This method extracts data from the buffer that has been successfully receive and stored in the Framed Data
+ * within the specified range. This version is suitable for data with unique Frame Formats in each frame
+ * (no duplicate Frame Types).
+ *
+ * @param begin Reference to the starting point for data extraction.
+ * @param end Reference to the ending point for data extraction.
+ * @return A vector containing the data.
+ */
+std::vector <unsigned char> SynapSock::getSpecificBufferAsVector(DataFrame::FRAME_TYPE_t begin, DataFrame::FRAME_TYPE_t end){
+    DataFrame *tmpBegin = (*this)[begin];
+    DataFrame *tmpEnd = (*this)[end];
+    return this->schema->frameFormat->getSpecificDataAsVector(tmpBegin, tmpEnd);
+}
+
+/**
+ * @brief Overloaded method of __getSpecificBufferAsVector__.
+ *
+ * This method performs the same data extraction operation as the other overload but is designed to handle
+ * cases where duplicate Frame Formats exist within the Framed Data. It retrieves data from the buffer
+ * that has been successfully receive and stored within the specified range.
+ *
+ * @param begin Pointer to the starting point for data extraction.
+ * @param end Pointer to the ending point for data extraction.
+ * @return A vector containing the data.
  */
 std::vector <unsigned char> SynapSock::getSpecificBufferAsVector(const DataFrame *begin, const DataFrame *end){
-    return this->frameFormat->getSpecificDataAsVector(begin, end);
+    return this->schema->frameFormat->getSpecificDataAsVector(begin, end);
 }
 
-SynapSock& SynapSock::operator=(const DataFrame &obj){
-    if (this->frameFormat != nullptr){
-        delete this->frameFormat;
-        this->frameFormat = nullptr;
+/**
+ * @brief Gets a view of a field of the last frame received with `receiveFramedData`.
+ *
+ * The view points into the receive buffer, where the frame is stored as one contiguous block, so the field is not copied.
+ * It is only valid until the next receive operation on this connection.
+ *
+ * @param[in] idx The index of the field in the frame format.
+ * @return view of the field (empty if the index is invalid or no frame has been received).
+ */
+FieldView SynapSock::getFieldView(int idx){
+    if (idx < 0 || (size_t) idx >= this->schema->parsePlan.size()) return FieldView();
+    const STEP_STATE_t &state = this->stepStates[idx];
+    if (state.fieldOffset > this->data.size() || this->data.size() - state.fieldOffset < state.fieldSize) return FieldView();
+    return FieldView(this->data.data() + state.fieldOffset, state.fieldSize);
+}
+
+/**
+ * @brief Overloaded method of `getFieldView` that gets the first field of a type.
+ *
+ * @param[in] type The type of the field.
+ * @return view of the field (empty if the frame format has no field of this type or no frame has been received).
+ */
+FieldView SynapSock::getFieldView(DataFrame::FRAME_TYPE_t type){
+    DataFrame *node = (*this)[type];
+    for (size_t i = 0; node != nullptr && i < this->schema->parsePlan.size(); i++){
+        if (this->schema->parsePlan[i].node == node) return this->getFieldView((int) i);
     }
-    DataFrame &ncObj = const_cast<DataFrame&>(obj);
-    std::vector <unsigned char> ref;
-    ncObj.getReference(ref);
-    this->frameFormat = new DataFrame(
-     static_cast<DataFrame::FRAME_TYPE_t>(ncObj.getType()),
-      ncObj.getSize(),
-      ref.data(),
-      ncObj.getExecuteFunction(),
-      ncObj.getExecuteFunctionParam(),
-      ncObj.getPostExecuteFunction(),
-      ncObj.getPostExecuteFunctionParam()
-    );
-    if (this->frameFormat != nullptr){
-        if (ncObj.getNext() != nullptr)
-            *(this->frameFormat) += *(ncObj.getNext());
+    return FieldView();
+}
+
+/**
+ * @brief Gets a view of a range of fields of the last frame received with `receiveFramedData`.
+ *
+ * This is the zero-copy version of `getSpecificBufferAsVector`, the view is only valid until the next receive operation on this connection.
+ *
+ * @param[in] begin The type of the first field of the range.
+ * @param[in] end The type of the last field of the range.
+ * @return view of the fields (empty if a type is not in the frame format, or `end` comes before `begin`).
+ */
+FieldView SynapSock::getSpecificBufferView(DataFrame::FRAME_TYPE_t begin, DataFrame::FRAME_TYPE_t end){
+    DataFrame *beginNode = (*this)[begin];
+    DataFrame *endNode = (*this)[end];
+    size_t beginIdx = this->schema->parsePlan.size();
+    size_t endIdx = this->schema->parsePlan.size();
+    for (size_t i = 0; i < this->schema->parsePlan.size(); i++){
+        if (this->schema->parsePlan[i].node == beginNode && beginIdx == this->schema->parsePlan.size()) beginIdx = i;
+        if (this->schema->parsePlan[i].node == endNode) endIdx = i;
     }
+    if (beginIdx > endIdx || endIdx >= this->schema->parsePlan.size()) return FieldView();
+    size_t offset = this->stepStates[beginIdx].fieldOffset;
+    size_t last = this->stepStates[endIdx].fieldOffset + this->stepStates[endIdx].fieldSize;
+    if (last < offset || last > this->data.size()) return FieldView();
+    return FieldView(this->data.data() + offset, last - offset);
+}
+
+/**
+ * @brief Compiles the frame format into the parse plan and the index of fields.
+ *
+ * The delimiters and the parse operation of every field are resolved once, so receiving a frame does not walk the linked list or copy the
+ * delimiters. The field sizes are still read from the fields while parsing, since an execute or post-execute function may resize a field.
+ */
+void SynapSock::compileFormat(){
+    this->resetParseCursor(0);
+    this->parseCursorDataSize = 0;
+    SynapSock::compileSchema(*(this->schema));
+    this->stepStates.assign(this->schema->parsePlan.size(), STEP_STATE_t{0, 0, 0, 0});
+    this->resetSharedFormat();
+}
+
+/**
+ * @brief Compiles the fields of a schema into its parse plan and its index of fields.
+ *
+ * @param[in,out] schema The schema, its declared length fields, checksum fields and handlers are resolved to parse steps.
+ */
+void SynapSock::compileSchema(FrameSchema &schema){
+    DataFrame *tmp = schema.frameFormat;
+    schema.parsePlan.clear();
+    schema.formatIndex.clear();
+    while (tmp != nullptr){
+        schema.parsePlan.emplace_back();
+        PARSE_STEP_t &step = schema.parsePlan.back();
+        step.node = tmp;
+        step.op = SynapSock::PARSE_OP_INVALID;
+        step.lengthEncoding = SynapSock::LENGTH_ENCODING_UINT8;
+        step.lengthAdjustment = 0;
+        step.lengthMax = 0;
+        step.lengthTarget = 0;
+        step.isSizeBound = false;
+        step.checksumAlgorithm = Checksum::CHECKSUM_CRC16_CCITT_FALSE;
+        step.isChecksumBigEndian = true;
+        step.checksumBegin = 0;
+        step.checksumEnd = 0;
+        if (tmp->getType() == DataFrame::FRAME_TYPE_START_BYTES && tmp->getReference(step.delimiter) > 0){
+            step.op = SynapSock::PARSE_OP_START_BYTES;
+        }
+        else if (tmp->getType() == DataFrame::FRAME_TYPE_STOP_BYTES && tmp->getReference(step.delimiter) > 0){
+            step.op = SynapSock::PARSE_OP_STOP_BYTES;
+        }
+        else if (tmp->getType() == DataFrame::FRAME_TYPE_CONTENT_LENGTH ||
+                 tmp->getType() == DataFrame::FRAME_TYPE_DATA ||
+                 tmp->getType() == DataFrame::FRAME_TYPE_VALIDATOR ||
+                 tmp->getType() == DataFrame::FRAME_TYPE_COMMAND
+        ){
+            step.op = SynapSock::PARSE_OP_FIELD;
+            step.delimiter.clear();
+            if (tmp->getNext() != nullptr && tmp->getNext()->getType() == DataFrame::FRAME_TYPE_STOP_BYTES){
+                tmp->getNext()->getReference(step.delimiter);
+            }
+        }
+        if (tmp->getType() >= schema.formatIndex.size()) schema.formatIndex.resize(tmp->getType() + 1);
+        schema.formatIndex[tmp->getType()].push_back(tmp);
+        tmp = tmp->getNext();
+    }
+    for (size_t i = 0; i < schema.lengthBindings.size(); i++){
+        const LENGTH_BINDING_t &binding = schema.lengthBindings[i];
+        size_t lengthIdx = schema.parsePlan.size();
+        size_t targetIdx = schema.parsePlan.size();
+        for (size_t j = 0; j < schema.parsePlan.size(); j++){
+            if (schema.parsePlan[j].node == binding.lengthNode) lengthIdx = j;
+            if (schema.parsePlan[j].node == binding.targetNode) targetIdx = j;
+        }
+        if (lengthIdx >= targetIdx || targetIdx >= schema.parsePlan.size()) continue;
+        PARSE_STEP_t &lengthStep = schema.parsePlan[lengthIdx];
+        lengthStep.op = SynapSock::PARSE_OP_LENGTH;
+        lengthStep.delimiter.clear();
+        lengthStep.lengthEncoding = binding.encoding;
+        lengthStep.lengthAdjustment = binding.adjustment;
+        lengthStep.lengthMax = binding.maxSize;
+        lengthStep.lengthTarget = targetIdx;
+        schema.parsePlan[targetIdx].isSizeBound = true;
+    }
+    schema.validatorSteps.clear();
+    for (size_t i = 0; i < schema.validatorBindings.size(); i++){
+        const VALIDATOR_BINDING_t &binding = schema.validatorBindings[i];
+        size_t validatorIdx = schema.parsePlan.size();
+        size_t beginIdx = schema.parsePlan.size();
+        size_t endIdx = schema.parsePlan.size();
+        for (size_t j = 0; j < schema.parsePlan.size(); j++){
+            if (schema.parsePlan[j].node == binding.validatorNode) validatorIdx = j;
+            if (schema.parsePlan[j].node == binding.beginNode) beginIdx = j;
+            if (schema.parsePlan[j].node == binding.endNode) endIdx = j;
+        }
+        if (beginIdx > endIdx || endIdx >= validatorIdx || validatorIdx >= schema.parsePlan.size()) continue;
+        PARSE_STEP_t &validatorStep = schema.parsePlan[validatorIdx];
+        validatorStep.op = SynapSock::PARSE_OP_VALIDATOR;
+        validatorStep.delimiter.clear();
+        validatorStep.checksumAlgorithm = binding.algorithm;
+        validatorStep.isChecksumBigEndian = binding.isBigEndian;
+        validatorStep.checksumBegin = beginIdx;
+        validatorStep.checksumEnd = endIdx;
+        schema.validatorSteps.push_back(validatorIdx);
+    }
+    for (size_t i = 0; i < schema.hookBindings.size(); i++){
+        for (size_t j = 0; j < schema.parsePlan.size(); j++){
+            if (schema.parsePlan[j].node == schema.hookBindings[i].node){
+                schema.parsePlan[j].execute = schema.hookBindings[i].execute;
+                schema.parsePlan[j].postExecute = schema.hookBindings[i].postExecute;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Decodes the value of a length field.
+ *
+ * @param[in] buffer The buffer that starts with the length field.
+ * @param[in] sz The size of the buffer.
+ * @param[in] step The parse step of the length field.
+ * @param[out] fieldSize The number of bytes of the length field.
+ * @param[out] length The size of the bound field (the adjustment has been applied).
+ * @return `0` if the length has been decoded.
+ * @return `2` if the buffer does not hold the whole length field yet.
+ * @return `4` if the length is invalid or exceeds the maximum size.
+ */
+int SynapSock::decodeLength(const unsigned char *buffer, size_t sz, const PARSE_STEP_t &step, size_t *fieldSize, size_t *length){
+    uint64_t value = 0;
+    uint64_t decrement = 0;
+    size_t width = getLengthWidth(step.lengthEncoding);
+    if (step.lengthEncoding == SynapSock::LENGTH_ENCODING_VARINT){
+        for (width = 0; ; width++){
+            if (width >= sz) return 2;
+            /* the 10th byte may only hold the most significant bit of a 64 bits value */
+            if (width == 9 && buffer[width] > 0x01) return 4;
+            value |= static_cast<uint64_t>(buffer[width] & 0x7F) << (7 * width);
+            if ((buffer[width] & 0x80) == 0) break;
+        }
+        width++;
+    }
+    else {
+        if (sz < width) return 2;
+        for (size_t i = 0; i < width; i++){
+            value = (value << 8) | buffer[isLengthBigEndian(step.lengthEncoding) ? i : width - 1 - i];
+        }
+    }
+    *fieldSize = width;
+    if (step.lengthAdjustment < 0){
+        decrement = static_cast<uint64_t>(-(step.lengthAdjustment + 1)) + 1;
+        if (value < decrement) return 4;
+        value -= decrement;
+    }
+    else {
+        if (value > UINT64_MAX - static_cast<uint64_t>(step.lengthAdjustment)) return 4;
+        value += static_cast<uint64_t>(step.lengthAdjustment);
+    }
+    if (value > SIZE_MAX || (step.lengthMax > 0 && value > step.lengthMax)) return 4;
+    *length = static_cast<size_t>(value);
+    return 0;
+}
+
+/**
+ * @brief Encodes the size of a field into a length field.
+ *
+ * @param[out] buffer A variable that holds the encoded length field.
+ * @param[in] step The parse step of the length field.
+ * @param[in] size The size of the bound field.
+ * @return `true` when success.
+ * @return `false` if the size does not fit in the length field or exceeds the maximum size (the buffer is then empty).
+ */
+bool SynapSock::encodeLength(std::vector <unsigned char> &buffer, const PARSE_STEP_t &step, size_t size){
+    buffer.resize(10);
+    buffer.resize(SynapSock::encodeLength(buffer.data(), step, size));
+    return (buffer.size() > 0);
+}
+
+/**
+ * @brief Overloaded method of `encodeLength` that writes into a buffer of at least 10 bytes.
+ *
+ * @param[out] buffer The buffer that holds the encoded length field.
+ * @param[in] step The parse step of the length field.
+ * @param[in] size The size of the bound field.
+ * @return the number of bytes of the length field.
+ * @return `0` if the size does not fit in the length field or exceeds the maximum size (nothing is written).
+ */
+size_t SynapSock::encodeLength(unsigned char *buffer, const PARSE_STEP_t &step, size_t size){
+    uint64_t value = static_cast<uint64_t>(size);
+    uint64_t increment = 0;
+    size_t width = getLengthWidth(step.lengthEncoding);
+    if (step.lengthMax > 0 && size > step.lengthMax) return 0;
+    /* the decoded value must give back the same size, see decodeLength */
+    if (step.lengthAdjustment < 0){
+        increment = static_cast<uint64_t>(-(step.lengthAdjustment + 1)) + 1;
+        if (value > UINT64_MAX - increment) return 0;
+        value += increment;
+    }
+    else {
+        if (value < static_cast<uint64_t>(step.lengthAdjustment)) return 0;
+        value -= static_cast<uint64_t>(step.lengthAdjustment);
+    }
+    if (width > 0 && width < 8 && value >= (static_cast<uint64_t>(1) << (8 * width))) return 0;
+    if (step.lengthEncoding == SynapSock::LENGTH_ENCODING_VARINT){
+        width = 0;
+        do {
+            buffer[width++] = static_cast<unsigned char>((value & 0x7F) | (value > 0x7F ? 0x80 : 0x00));
+            value >>= 7;
+        } while (value > 0);
+        return width;
+    }
+    for (size_t i = 0; i < width; i++){
+        buffer[isLengthBigEndian(step.lengthEncoding) ? width - 1 - i : i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+    return width;
+}
+
+/**
+ * @brief Updates the checksums that cover a parse step with the bytes of the step.
+ *
+ * @param[in] stepIdx The index of the parse step.
+ * @param[in] buffer The bytes of the step (field data or delimiter).
+ * @param[in] sz The number of bytes of the step.
+ */
+void SynapSock::updateValidators(size_t stepIdx, const unsigned char *buffer, size_t sz){
+    for (size_t i = 0; i < this->schema->validatorSteps.size(); i++){
+        const PARSE_STEP_t &step = this->schema->parsePlan[this->schema->validatorSteps[i]];
+        STEP_STATE_t &state = this->stepStates[this->schema->validatorSteps[i]];
+        Checksum::ALGORITHM_t algorithm = static_cast<Checksum::ALGORITHM_t>(step.checksumAlgorithm);
+        if (stepIdx < step.checksumBegin || stepIdx > step.checksumEnd) continue;
+        if (stepIdx == step.checksumBegin) state.checksumValue = Checksum::init(algorithm);
+        state.checksumValue = Checksum::update(algorithm, state.checksumValue, buffer, sz);
+    }
+}
+
+/**
+ * @brief Compares a received checksum with the checksum computed over the covered fields.
+ *
+ * @param[in] step The parse step of the checksum field.
+ * @param[in] checksum The checksum computed over the covered fields.
+ * @param[in] buffer The received checksum (`Checksum::getSize` bytes).
+ * @return `true` if the checksum is valid.
+ */
+bool SynapSock::isChecksumValid(const PARSE_STEP_t &step, uint32_t checksum, const unsigned char *buffer){
+    size_t width = Checksum::getSize(static_cast<Checksum::ALGORITHM_t>(step.checksumAlgorithm));
+    uint32_t value = 0;
+    for (size_t i = 0; i < width; i++){
+        value = (value << 8) | buffer[step.isChecksumBigEndian ? i : width - 1 - i];
+    }
+    return (value == checksum);
+}
+
+/**
+ * @brief Encodes a checksum into a checksum field.
+ *
+ * @param[out] buffer A variable that holds the encoded checksum field.
+ * @param[in] step The parse step of the checksum field.
+ * @param[in] value The checksum.
+ */
+void SynapSock::encodeChecksum(std::vector <unsigned char> &buffer, const PARSE_STEP_t &step, uint32_t value){
+    buffer.resize(Checksum::getSize(static_cast<Checksum::ALGORITHM_t>(step.checksumAlgorithm)));
+    SynapSock::encodeChecksum(buffer.data(), step, value);
+}
+
+/**
+ * @brief Overloaded method of `encodeChecksum` that writes into a buffer of `Checksum::getSize` bytes.
+ *
+ * @param[out] buffer The buffer that holds the encoded checksum field.
+ * @param[in] step The parse step of the checksum field.
+ * @param[in] value The checksum.
+ */
+void SynapSock::encodeChecksum(unsigned char *buffer, const PARSE_STEP_t &step, uint32_t value){
+    size_t width = Checksum::getSize(static_cast<Checksum::ALGORITHM_t>(step.checksumAlgorithm));
+    for (size_t i = 0; i < width; i++){
+        buffer[step.isChecksumBigEndian ? width - 1 - i : i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+SynapSock& SynapSock::operator=(const DataFrame &obj){
+    /* the previous frame format is released with its schema, unless other connections still share it */
+    this->schema = std::make_shared<FrameSchema>();
+    this->isSchemaShared = false;
+    this->schema->frameFormat = SynapSock::copyFrames(obj);
+    this->compileFormat();
     return *this;
 }
 
 SynapSock& SynapSock::operator+=(const DataFrame &obj){
-    *(this->frameFormat) += obj;
+    this->detachFormat();
+    *(this->schema->frameFormat) += obj;
+    this->compileFormat();
     return *this;
 }
 
@@ -428,39 +2072,27 @@ SynapSock& SynapSock::operator+(const DataFrame &obj){
     return *this;
 }
 
+/**
+ * @brief Gets a field of the frame format.
+ *
+ * The field may be modified through the returned pointer (see `getFormat`), `refreshFormat` must be called after its start bytes or stop bytes
+ * have been modified.
+ *
+ * @param[in] idx The index of the field in the frame format.
+ * @return The field (`nullptr` if the index is invalid).
+ */
 DataFrame* SynapSock::operator[](int idx){
-    int i = 0;
-    DataFrame *tmp = this->frameFormat;
-    if (tmp == nullptr || i < 0) return nullptr;
-    while(tmp != nullptr){
-        if(i == idx) return tmp;
-        i++;
-        tmp = tmp->getNext();
-    }
-    return nullptr;
+    if (idx < 0 || (size_t) idx >= this->schema->parsePlan.size()) return nullptr;
+    return this->schema->parsePlan[idx].node;
 }
 
 DataFrame* SynapSock::operator[](DataFrame::FRAME_TYPE_t type){
-    DataFrame *tmp = this->frameFormat;
-    if (tmp == nullptr) return nullptr;
-    while(tmp != nullptr){
-        if(tmp->getType() == type) return tmp;
-        tmp = tmp->getNext();
-    }
-    return nullptr;
+    if ((size_t) type >= this->schema->formatIndex.size() || this->schema->formatIndex[type].size() == 0) return nullptr;
+    return this->schema->formatIndex[type][0];
 }
 
 DataFrame* SynapSock::operator[](std::pair <DataFrame::FRAME_TYPE_t, int> params){
-    int i = 0;
-    DataFrame *tmp = this->frameFormat;
-    if (tmp == nullptr || i < 0) return nullptr;
-    while(tmp != nullptr){
-        if (tmp->getType() == params.first){
-            if(i == params.second) return tmp;
-            i++;
-        }
-        tmp = tmp->getNext();
-    }
-    return nullptr;
+    if ((size_t) params.first >= this->schema->formatIndex.size() || params.second < 0) return nullptr;
+    if ((size_t) params.second >= this->schema->formatIndex[params.first].size()) return nullptr;
+    return this->schema->formatIndex[params.first][params.second];
 }
-
@@ -24,6 +24,7 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 #include "tcp-client.hpp"
 
 /**
@@ -42,6 +43,11 @@ TCPClient::TCPClient(){
   this->sslWarper = nullptr;
 #endif
   this->status = static_cast<unsigned char>(TCPClient::CLIENT_UNINITIALIZED);
+  this->correlationOffset = 0;
+  this->correlationLength = 0;
+  this->requestSequence = 0;
+  pthread_mutex_init(&(this->pmtx), nullptr);
+  pthread_mutex_init(&(this->smtx), nullptr);
 }
 
 /**
@@ -60,6 +66,11 @@ TCPClient::TCPClient(const unsigned char *address) : SynapSock(address){
   this->sslWarper = nullptr;
 #endif
   this->status = static_cast<unsigned char>(TCPClient::CLIENT_UNINITIALIZED);
+  this->correlationOffset = 0;
+  this->correlationLength = 0;
+  this->requestSequence = 0;
+  pthread_mutex_init(&(this->pmtx), nullptr);
+  pthread_mutex_init(&(this->smtx), nullptr);
 }
 
 /**
@@ -78,6 +89,11 @@ TCPClient::TCPClient(const unsigned char *address, int port) : SynapSock(address
   this->sslWarper = nullptr;
 #endif
   this->status = static_cast<unsigned char>(TCPClient::CLIENT_UNINITIALIZED);
+  this->correlationOffset = 0;
+  this->correlationLength = 0;
+  this->requestSequence = 0;
+  pthread_mutex_init(&(this->pmtx), nullptr);
+  pthread_mutex_init(&(this->smtx), nullptr);
 }
 
 /**
@@ -91,11 +107,16 @@ TCPClient::TCPClient(const unsigned char *address, int port) : SynapSock(address
  * - Initializes the mutex for thread safety.
  * @param[in] address The address is in the form of an IP address with a size of 4 bytes.
  */
-TCPClient::TCPClient(const std::vector <unsigned char> address) : SynapSock(address){
+TCPClient::TCPClient(const std::vector <unsigned char> &address) : SynapSock(address){
 #ifdef __STCP_SSL__
   this->sslWarper = nullptr;
 #endif
   this->status = static_cast<unsigned char>(TCPClient::CLIENT_UNINITIALIZED);
+  this->correlationOffset = 0;
+  this->correlationLength = 0;
+  this->requestSequence = 0;
+  pthread_mutex_init(&(this->pmtx), nullptr);
+  pthread_mutex_init(&(this->smtx), nullptr);
 }
 
 /**
@@ -109,11 +130,16 @@ TCPClient::TCPClient(const std::vector <unsigned char> address) : SynapSock(addr
  * @param[in] address The address is in the form of an IP address with a size of 4 bytes.
  * @param[in] port The port of TCPClient/IP interface.
  */
-TCPClient::TCPClient(const std::vector <unsigned char> address, int port) : SynapSock(address, port){
+TCPClient::TCPClient(const std::vector <unsigned char> &address, int port) : SynapSock(address, port){
 #ifdef __STCP_SSL__
   this->sslWarper = nullptr;
 #endif
   this->status = static_cast<unsigned char>(TCPClient::CLIENT_UNINITIALIZED);
+  this->correlationOffset = 0;
+  this->correlationLength = 0;
+  this->requestSequence = 0;
+  pthread_mutex_init(&(this->pmtx), nullptr);
+  pthread_mutex_init(&(this->smtx), nullptr);
 }
 
 /**
@@ -132,6 +158,11 @@ TCPClient::TCPClient(const char *address) : SynapSock(address){
   this->sslWarper = nullptr;
 #endif
   this->status = static_cast<unsigned char>(TCPClient::CLIENT_UNINITIALIZED);
+  this->correlationOffset = 0;
+  this->correlationLength = 0;
+  this->requestSequence = 0;
+  pthread_mutex_init(&(this->pmtx), nullptr);
+  pthread_mutex_init(&(this->smtx), nullptr);
 }
 
 /**
@@ -150,6 +181,11 @@ TCPClient::TCPClient(const char *address, int port) : SynapSock(address, port){
   this->sslWarper = nullptr;
 #endif
   this->status = static_cast<unsigned char>(TCPClient::CLIENT_UNINITIALIZED);
+  this->correlationOffset = 0;
+  this->correlationLength = 0;
+  this->requestSequence = 0;
+  pthread_mutex_init(&(this->pmtx), nullptr);
+  pthread_mutex_init(&(this->smtx), nullptr);
 }
 
 /**
@@ -163,11 +199,16 @@ TCPClient::TCPClient(const char *address, int port) : SynapSock(address, port){
  * - Initializes the mutex for thread safety.
  * @param[in] address The address in the form of an IP address or domain (string).
  */
-TCPClient::TCPClient(const std::string address) : SynapSock(address){
+TCPClient::TCPClient(const std::string &address) : SynapSock(address){
 #ifdef __STCP_SSL__
   this->sslWarper = nullptr;
 #endif
   this->status = static_cast<unsigned char>(TCPClient::CLIENT_UNINITIALIZED);
+  this->correlationOffset = 0;
+  this->correlationLength = 0;
+  this->requestSequence = 0;
+  pthread_mutex_init(&(this->pmtx), nullptr);
+  pthread_mutex_init(&(this->smtx), nullptr);
 }
 
 /**
@@ -181,11 +222,16 @@ TCPClient::TCPClient(const std::string address) : SynapSock(address){
  * @param[in] address The address in the form of an IP address or domain (string).
  * @param[in] port The port of TCPClient/IP interface.
  */
-TCPClient::TCPClient(const std::string address, int port) : SynapSock(address, port){
+TCPClient::TCPClient(const std::string &address, int port) : SynapSock(address, port){
 #ifdef __STCP_SSL__
   this->sslWarper = nullptr;
 #endif
   this->status = static_cast<unsigned char>(TCPClient::CLIENT_UNINITIALIZED);
+  this->correlationOffset = 0;
+  this->correlationLength = 0;
+  this->requestSequence = 0;
+  pthread_mutex_init(&(this->pmtx), nullptr);
+  pthread_mutex_init(&(this->smtx), nullptr);
 }
 
 /**
@@ -200,6 +246,8 @@ TCPClient::~TCPClient(){
     delete this->sslWarper;
   }
 #endif
+  pthread_mutex_destroy(&(this->pmtx));
+  pthread_mutex_destroy(&(this->smtx));
 }
 
 /**
@@ -309,6 +357,7 @@ int TCPClient::init(){
     tv.tv_usec = this->tvTimeout.tv_usec;
     setsockopt(this->sockFd, SOL_SOCKET, SO_RCVTIMEO, (const char*) &(tv), sizeof(tv));
   }
+  this->applySocketOptions();
   this->status = static_cast<unsigned char>(TCPClient::CLIENT_INITIALIZED);
   if (this->connectToServer() != true){
     close(this->sockFd);
@@ -370,6 +419,261 @@ bool TCPClient::initializeSSL(){
 }
 #endif
 
+/**
+ * @brief Gets the value of the correlation field from the data of the frame format.
+ *
+ * @param[out] key A variable that holds the value of the correlation field.
+ * @return `true` when success.
+ * @return `false` if the frame format is shorter than the correlation field.
+ */
+bool TCPClient::getFormatCorrelationKey(std::vector <unsigned char> &key){
+  size_t begin = 0;
+  size_t end = 0;
+  DataFrame *tmp = this->getFormat();
+  key.clear();
+  while (tmp != nullptr && key.size() < this->correlationLength){
+    tmp->getData(this->requestSegment);
+    end = begin + this->requestSegment.size();
+    if (end > this->correlationOffset){
+      /* the part of this field that overlaps the correlation field */
+      size_t from = (this->correlationOffset > begin ? this->correlationOffset - begin : 0);
+      size_t to = std::min(this->requestSegment.size(), this->correlationOffset + this->correlationLength - begin);
+      key.insert(key.end(), this->requestSegment.begin() + from, this->requestSegment.begin() + to);
+    }
+    begin = end;
+    tmp = tmp->getNext();
+  }
+  return (key.size() == this->correlationLength);
+}
+
+/**
+ * @brief Matches a response with its pending request and calls the callback function of the request.
+ *
+ * @param[in] frame The response frame.
+ */
+void TCPClient::dispatchResponse(const FRAME_VIEW_t &frame){
+  void (*callback)(TCPClient &, int, const unsigned char *, size_t, void *) = nullptr;
+  void *param = nullptr;
+  int status = 0;
+  pthread_mutex_lock(&(this->pmtx));
+  if (this->correlationLength == 0){
+    if (this->pendingRequests.size() > 0){
+      callback = (void (*)(TCPClient &, int, const unsigned char *, size_t, void *)) this->pendingRequests.front().callbackFunction;
+      param = this->pendingRequests.front().callbackParam;
+      status = (this->pendingRequests.front().isFailed ? 2 : 0);
+      this->pendingRequests.pop_front();
+    }
+  }
+  else if (frame.size >= this->correlationOffset + this->correlationLength){
+    const unsigned char *key = frame.data + this->correlationOffset;
+    for (std::deque <PIPELINE_REQUEST_t>::iterator it = this->pendingRequests.begin(); it != this->pendingRequests.end(); it++){
+      if (it->key.size() == this->correlationLength && memcmp(it->key.data(), key, this->correlationLength) == 0){
+        callback = (void (*)(TCPClient &, int, const unsigned char *, size_t, void *)) it->callbackFunction;
+        param = it->callbackParam;
+        status = (it->isFailed ? 2 : 0);
+        this->pendingRequests.erase(it);
+        break;
+      }
+    }
+  }
+  pthread_mutex_unlock(&(this->pmtx));
+  if (callback != nullptr) callback(*this, status, frame.data, frame.size, param);
+}
+
+/**
+ * @brief Sets the correlation field that matches the responses with the pipelined requests.
+ *
+ * By default (`length = 0`) the responses are matched with the pipelined requests in the order the requests have been sent. With a correlation
+ * field, a response is matched with the oldest pending request that has the same value of the `length` bytes at `offset` from the first byte of
+ * the frame, so the server may answer the requests out of order.
+ *
+ * @param[in] offset The offset of the correlation field from the first byte of the frame.
+ * @param[in] length The size of the correlation field (`0` to match the responses in order).
+ */
+void TCPClient::setPipelineCorrelation(size_t offset, size_t length){
+  pthread_mutex_lock(&(this->pmtx));
+  this->correlationOffset = offset;
+  this->correlationLength = length;
+  pthread_mutex_unlock(&(this->pmtx));
+}
+
+/**
+ * @brief Removes all the pipelined requests that wait for their response and calls their callback function with a status.
+ *
+ * @param[in] status The status that is passed to the callback functions.
+ */
+void TCPClient::failPendingRequests(int status){
+  std::deque <PIPELINE_REQUEST_t> failed;
+  pthread_mutex_lock(&(this->pmtx));
+  failed.swap(this->pendingRequests);
+  pthread_mutex_unlock(&(this->pmtx));
+  for (size_t i = 0; i < failed.size(); i++){
+    void (*callback)(TCPClient &, int, const unsigned char *, size_t, void *) = (void (*)(TCPClient &, int, const unsigned char *, size_t, void *)) failed[i].callbackFunction;
+    if (callback != nullptr) callback(*this, status, nullptr, 0, failed[i].callbackParam);
+  }
+}
+
+/**
+ * @brief Settles a pending request after its write operation.
+ *
+ * A request that is not held by the connection is removed, a request that is (partially) held by the output queue or the cork buffer keeps its
+ * place in the order of the pending requests but is marked as failed.
+ *
+ * @param[in] sequence The sequence number of the request.
+ * @param[in] ret The result of the write operation.
+ * @param[in] isQueued `true` if (a part of) the request is held by the output queue or the cork buffer.
+ */
+void TCPClient::settleRequest(unsigned long sequence, int ret, bool isQueued){
+  if (ret == 0) return;
+  pthread_mutex_lock(&(this->pmtx));
+  for (std::deque <PIPELINE_REQUEST_t>::reverse_iterator it = this->pendingRequests.rbegin(); it != this->pendingRequests.rend(); it++){
+    if (it->sequence != sequence) continue;
+    if (isQueued) it->isFailed = true;
+    else this->pendingRequests.erase(std::next(it).base());
+    break;
+  }
+  pthread_mutex_unlock(&(this->pmtx));
+}
+
+/**
+ * @brief Sends a framed request without waiting for the response of the previous requests (pipelining).
+ *
+ * The request is a complete frame that has been built by the caller. It is registered as pending and sent immediately, so many requests can
+ * be sent back to back. The response is delivered to `func` by `TCPClient::processResponses`. Requests may be sent from several threads,
+ * the requests are registered and written one at a time so the order of the pending requests is the order on the wire. The pending requests
+ * are not locked during the write, so the responses are still processed while a request is being written. If the write fails, the request is
+ * removed when none of its data is held by the output queue or the cork buffer, otherwise it is marked as failed.
+ *
+ * @param[in] buffer The request frame.
+ * @param[in] sz The size of the request frame.
+ * @param[in] func callback function that has 5 parameters. `TCPClient &` is the connection. `int` is `0` when the response has been received,
+ *                 `1` when the request has been cancelled and `2` when the response has been received for a request whose write operation failed
+ *                 (timeout or partial write) and `3` when the peer has closed the connection before the response has been received.
+ *                 `const unsigned char *` and `size_t` are the response frame (a view into the connection buffer, `nullptr` and `0` when
+ *                 cancelled or closed). `void *` is a pointer that will connect directly to `void *param`.
+ * @param[in] param callback function parameter.
+ * @return `0` if the operation is successful.
+ * @return `1` if the port is not open.
+ * @return `2` if the data write operation fails.
+ * @return `3` if the request is shorter than the correlation field.
+ */
+int TCPClient::sendRequest(const unsigned char *buffer, size_t sz, void (*func)(TCPClient &, int, const unsigned char *, size_t, void *), void *param){
+  struct iovec iov;
+  int ret = 0;
+  unsigned long sequence = 0;
+  bool isQueued = false;
+  pthread_mutex_lock(&(this->smtx));
+  pthread_mutex_lock(&(this->pmtx));
+  if (sz < this->correlationOffset + this->correlationLength){
+    pthread_mutex_unlock(&(this->pmtx));
+    pthread_mutex_unlock(&(this->smtx));
+    return 3;
+  }
+  sequence = this->requestSequence++;
+  this->pendingRequests.emplace_back();
+  this->pendingRequests.back().key.assign(buffer + this->correlationOffset, buffer + this->correlationOffset + this->correlationLength);
+  this->pendingRequests.back().callbackFunction = (const void *) func;
+  this->pendingRequests.back().callbackParam = param;
+  this->pendingRequests.back().sequence = sequence;
+  this->pendingRequests.back().isFailed = false;
+  pthread_mutex_unlock(&(this->pmtx));
+  /* register before writing, the response may be processed before sendData returns */
+  iov.iov_base = (void *) buffer;
+  iov.iov_len = sz;
+  ret = this->sendData(&iov, 1, &isQueued);
+  this->settleRequest(sequence, ret, isQueued);
+  pthread_mutex_unlock(&(this->smtx));
+  return ret;
+}
+
+/**
+ * @brief Sends the data of the frame format as a pipelined request.
+ *
+ * This method is the same as `TCPClient::sendRequest` but the request is built from the data of the frame format (see `SynapSock::sendFramedData`).
+ *
+ * @param[in] func callback function that is called with the response (see `TCPClient::sendRequest`).
+ * @param[in] param callback function parameter.
+ * @return `0` if the operation is successful.
+ * @return `1` if the port is not open.
+ * @return `2` if the data write operation fails.
+ * @return `3` if there is no data to send, or if the size of a bound field does not fit in its length field or exceeds its maximum size.
+ * @return `4` if the request is shorter than the correlation field.
+ */
+int TCPClient::sendFramedRequest(void (*func)(TCPClient &, int, const unsigned char *, size_t, void *), void *param){
+  int ret = 0;
+  unsigned long sequence = 0;
+  bool isQueued = false;
+  std::vector <unsigned char> key;
+  pthread_mutex_lock(&(this->smtx));
+  pthread_mutex_lock(&(this->pmtx));
+  if (this->getFormatCorrelationKey(key) == false){
+    pthread_mutex_unlock(&(this->pmtx));
+    pthread_mutex_unlock(&(this->smtx));
+    return 4;
+  }
+  sequence = this->requestSequence++;
+  this->pendingRequests.emplace_back();
+  this->pendingRequests.back().key.swap(key);
+  this->pendingRequests.back().callbackFunction = (const void *) func;
+  this->pendingRequests.back().callbackParam = param;
+  this->pendingRequests.back().sequence = sequence;
+  this->pendingRequests.back().isFailed = false;
+  pthread_mutex_unlock(&(this->pmtx));
+  ret = this->sendFramedData(&isQueued);
+  this->settleRequest(sequence, ret, isQueued);
+  pthread_mutex_unlock(&(this->smtx));
+  return ret;
+}
+
+/**
+ * @brief Receives the available responses of the pipelined requests and calls the callback function of each request.
+ *
+ * The responses are received with `SynapSock::receiveFramedDataBatch`, so all the complete responses are handled with a single read operation.
+ * A response that does not match any pending request is discarded. The callback functions are called from the calling thread without holding
+ * any lock, they may send new requests but must not receive data from this connection (the response frame is a view into the connection buffer).
+ * When no response is available and the peer has closed the connection, the callback function of every pending request is called with status `3`.
+ *
+ * @return `0` if at least one response has been received.
+ * @return `1` if the port is not open.
+ * @return `2` if a timeout occurs.
+ * @return `3` if the frame format is not set up.
+ * @return `4` if the peer has closed the connection.
+ */
+int TCPClient::processResponses(){
+  int ret = this->receiveFramedDataBatch(this->responseFrames);
+  if (ret == 2 && this->isPeerClosed()){
+    this->failPendingRequests(3);
+    return 4;
+  }
+  if (ret != 0) return ret;
+  for (size_t i = 0; i < this->responseFrames.size(); i++){
+    this->dispatchResponse(this->responseFrames[i]);
+  }
+  return 0;
+}
+
+/**
+ * @brief Gets the number of pipelined requests that wait for their response.
+ *
+ * @return The number of pending requests.
+ */
+size_t TCPClient::getPendingRequestsSize(){
+  size_t ret = 0;
+  pthread_mutex_lock(&(this->pmtx));
+  ret = this->pendingRequests.size();
+  pthread_mutex_unlock(&(this->pmtx));
+  return ret;
+}
+
+/**
+ * @brief Cancels all the pipelined requests that wait for their response.
+ *
+ * The callback function of every pending request is called with status `1` (for example after the connection has been lost).
+ */
+void TCPClient::cancelPendingRequests(){
+  this->failPendingRequests(1);
+}
+
 TCPClient& TCPClient::operator=(const DataFrame &obj){
   SynapSock::operator=(obj);
   return *this;
@@ -22,6 +22,7 @@
  */
 
 #include <unistd.h>
+#include <fcntl.h>
 #include <stdlib.h>
 #include <string.h>
 #include <iostream>
@@ -40,8 +41,8 @@ void *receptionThreadHandler(void *ptr){
   pthread_cond_signal(&(obj->cond));
   pthread_mutex_unlock(&(obj->mtx));
   std::cout << __func__ << ": thread start" << std::endl;
-  void (*callback)(SynapSock &, void *) = (void (*)(SynapSock &, void *))server->getReceptionHandlerFunction();
-  callback(*(obj->client), server->getReceptionHandlerParam());
+  TCPServer::RECEPTION_HANDLER_t handler = server->getReceptionHandler();
+  if (handler) handler(*(obj->client));
   pthread_mutex_lock(&(obj->mtx));
   pthread_detach(obj->th);
   obj->th = 0;
@@ -56,6 +57,12 @@ void *receptionThreadHandler(void *ptr){
   return nullptr;
 }
 
+void outputQueuedHandler(Socket &, void *ptr){
+  int *wakeFd = (int *) ptr;
+  /* the pipe is non-blocking, when it is full eventCheck is already woken up */
+  if (*wakeFd > 0 && write(*wakeFd, "\x30", 1) != 1) return;
+}
+
 ClientCollection::ClientCollection(const SynapSock *client){
   gettimeofday(&lastActivity, nullptr);
   this->th = 0;
@@ -96,8 +103,16 @@ ClientCollection::~ClientCollection(){
  */
 TCPServer::TCPServer(){
   this->maxClient = 10;
+  this->isClientFormatShared = false;
+  this->wakePipe[0] = 0;
+  this->wakePipe[1] = 0;
   this->client = nullptr;
   this->clientList = nullptr;
+  this->receptionHandlerAsThread = false;
+  this->conReqCallbackFunction = nullptr;
+  this->conReqCallbackParam = nullptr;
+  this->receptionCallbackFunction = nullptr;
+  this->receptionCallbackParam = nullptr;
 #ifdef __STCP_SSL__
   this->sslWarper = nullptr;
 #endif
@@ -116,8 +131,16 @@ TCPServer::TCPServer(){
  */
 TCPServer::TCPServer(const unsigned char *address) : SynapSock(address){
   this->maxClient = 10;
+  this->isClientFormatShared = false;
+  this->wakePipe[0] = 0;
+  this->wakePipe[1] = 0;
   this->client = nullptr;
   this->clientList = nullptr;
+  this->receptionHandlerAsThread = false;
+  this->conReqCallbackFunction = nullptr;
+  this->conReqCallbackParam = nullptr;
+  this->receptionCallbackFunction = nullptr;
+  this->receptionCallbackParam = nullptr;
 #ifdef __STCP_SSL__
   this->sslWarper = nullptr;
 #endif
@@ -136,8 +159,16 @@ TCPServer::TCPServer(const unsigned char *address) : SynapSock(address){
  */
 TCPServer::TCPServer(const unsigned char *address, int port) : SynapSock(address, port){
   this->maxClient = 10;
+  this->isClientFormatShared = false;
+  this->wakePipe[0] = 0;
+  this->wakePipe[1] = 0;
   this->client = nullptr;
   this->clientList = nullptr;
+  this->receptionHandlerAsThread = false;
+  this->conReqCallbackFunction = nullptr;
+  this->conReqCallbackParam = nullptr;
+  this->receptionCallbackFunction = nullptr;
+  this->receptionCallbackParam = nullptr;
 #ifdef __STCP_SSL__
   this->sslWarper = nullptr;
 #endif
@@ -154,10 +185,18 @@ TCPServer::TCPServer(const unsigned char *address, int port) : SynapSock(address
  * - Initializes the mutex for thread safety.
  * @param[in] address The address is in the form of an IP address with a size of 4 bytes.
  */
-TCPServer::TCPServer(const std::vector <unsigned char> address) : SynapSock(address){
+TCPServer::TCPServer(const std::vector <unsigned char> &address) : SynapSock(address){
   this->maxClient = 10;
+  this->isClientFormatShared = false;
+  this->wakePipe[0] = 0;
+  this->wakePipe[1] = 0;
   this->client = nullptr;
   this->clientList = nullptr;
+  this->receptionHandlerAsThread = false;
+  this->conReqCallbackFunction = nullptr;
+  this->conReqCallbackParam = nullptr;
+  this->receptionCallbackFunction = nullptr;
+  this->receptionCallbackParam = nullptr;
 #ifdef __STCP_SSL__
   this->sslWarper = nullptr;
 #endif
@@ -174,10 +213,18 @@ TCPServer::TCPServer(const std::vector <unsigned char> address) : SynapSock(addr
  * @param[in] address The address is in the form of an IP address with a size of 4 bytes.
  * @param[in] port The port of TCPServer/IP interface.
  */
-TCPServer::TCPServer(const std::vector <unsigned char> address, int port) : SynapSock(address, port){
+TCPServer::TCPServer(const std::vector <unsigned char> &address, int port) : SynapSock(address, port){
   this->maxClient = 10;
+  this->isClientFormatShared = false;
+  this->wakePipe[0] = 0;
+  this->wakePipe[1] = 0;
   this->client = nullptr;
   this->clientList = nullptr;
+  this->receptionHandlerAsThread = false;
+  this->conReqCallbackFunction = nullptr;
+  this->conReqCallbackParam = nullptr;
+  this->receptionCallbackFunction = nullptr;
+  this->receptionCallbackParam = nullptr;
 #ifdef __STCP_SSL__
   this->sslWarper = nullptr;
 #endif
@@ -196,8 +243,16 @@ TCPServer::TCPServer(const std::vector <unsigned char> address, int port) : Syna
  */
 TCPServer::TCPServer(const char *address) : SynapSock(address){
   this->maxClient = 10;
+  this->isClientFormatShared = false;
+  this->wakePipe[0] = 0;
+  this->wakePipe[1] = 0;
   this->client = nullptr;
   this->clientList = nullptr;
+  this->receptionHandlerAsThread = false;
+  this->conReqCallbackFunction = nullptr;
+  this->conReqCallbackParam = nullptr;
+  this->receptionCallbackFunction = nullptr;
+  this->receptionCallbackParam = nullptr;
 #ifdef __STCP_SSL__
   this->sslWarper = nullptr;
 #endif
@@ -216,8 +271,16 @@ TCPServer::TCPServer(const char *address) : SynapSock(address){
  */
 TCPServer::TCPServer(const char *address, int port) : SynapSock(address, port){
   this->maxClient = 10;
+  this->isClientFormatShared = false;
+  this->wakePipe[0] = 0;
+  this->wakePipe[1] = 0;
   this->client = nullptr;
   this->clientList = nullptr;
+  this->receptionHandlerAsThread = false;
+  this->conReqCallbackFunction = nullptr;
+  this->conReqCallbackParam = nullptr;
+  this->receptionCallbackFunction = nullptr;
+  this->receptionCallbackParam = nullptr;
 #ifdef __STCP_SSL__
   this->sslWarper = nullptr;
 #endif
@@ -234,10 +297,18 @@ TCPServer::TCPServer(const char *address, int port) : SynapSock(address, port){
  * - Initializes the mutex for thread safety.
  * @param[in] address The address in the form of an IP address or domain (string).
  */
-TCPServer::TCPServer(const std::string address) : SynapSock(address){
+TCPServer::TCPServer(const std::string &address) : SynapSock(address){
   this->maxClient = 10;
+  this->isClientFormatShared = false;
+  this->wakePipe[0] = 0;
+  this->wakePipe[1] = 0;
   this->client = nullptr;
   this->clientList = nullptr;
+  this->receptionHandlerAsThread = false;
+  this->conReqCallbackFunction = nullptr;
+  this->conReqCallbackParam = nullptr;
+  this->receptionCallbackFunction = nullptr;
+  this->receptionCallbackParam = nullptr;
 #ifdef __STCP_SSL__
   this->sslWarper = nullptr;
 #endif
@@ -254,10 +325,18 @@ TCPServer::TCPServer(const std::string address) : SynapSock(address){
  * @param[in] address The address in the form of an IP address or domain (string).
  * @param[in] port The port of TCPServer/IP interface.
  */
-TCPServer::TCPServer(const std::string address, int port) : SynapSock(address, port){
+TCPServer::TCPServer(const std::string &address, int port) : SynapSock(address, port){
   this->maxClient = 10;
+  this->isClientFormatShared = false;
+  this->wakePipe[0] = 0;
+  this->wakePipe[1] = 0;
   this->client = nullptr;
   this->clientList = nullptr;
+  this->receptionHandlerAsThread = false;
+  this->conReqCallbackFunction = nullptr;
+  this->conReqCallbackParam = nullptr;
+  this->receptionCallbackFunction = nullptr;
+  this->receptionCallbackParam = nullptr;
 #ifdef __STCP_SSL__
   this->sslWarper = nullptr;
 #endif
@@ -279,6 +358,12 @@ TCPServer::~TCPServer(){
       tmp = next;
     } while (tmp != this->clientList);
   }
+  if (this->wakePipe[0] > 0){
+    close(this->wakePipe[0]);
+  }
+  if (this->wakePipe[1] > 0){
+    close(this->wakePipe[1]);
+  }
 #ifdef __STCP_SSL__
   if (this->sslWarper != nullptr){
     delete this->sslWarper;
@@ -316,6 +401,27 @@ int TCPServer::getMaximumClient(){
   return this->maxClient;
 }
 
+/**
+ * @brief Shares the frame format of the server with the clients that are accepted afterwards.
+ *
+ * Disabled by default. When enabled, every accepted client gets the frame format of the server with `setFormat`: the clients read one
+ * read-only schema instead of a copy each (see `SynapSock::setFormat`), a frame format with callbacks is still copied for every client.
+ *
+ * @param[in] isShared `true` to share the frame format of the server with the clients.
+ */
+void TCPServer::setClientFormatSharing(bool isShared){
+  this->isClientFormatShared = isShared;
+}
+
+/**
+ * @brief Checks if the frame format of the server is shared with the accepted clients.
+ *
+ * @return `true` if the frame format is shared.
+ */
+bool TCPServer::isClientFormatSharing(){
+  return this->isClientFormatShared;
+}
+
 /**
  * @brief Initialize TCPServer/IP Server connection.
  *
@@ -361,6 +467,11 @@ int TCPServer::init(){
     pthread_mutex_unlock(&(this->wmtx));
     return 4;
   }
+  if (this->wakePipe[0] <= 0 && pipe2(this->wakePipe, O_NONBLOCK | O_CLOEXEC) == -1){
+    /* without the pipe, the queued data of the clients is flushed after the timeout of eventCheck */
+    this->wakePipe[0] = 0;
+    this->wakePipe[1] = 0;
+  }
   pthread_mutex_unlock(&(this->mtx));
   pthread_mutex_unlock(&(this->wmtx));
   return 0;
@@ -396,6 +507,11 @@ bool TCPServer::addClient(int connFd){
     delete client;
     return false;
   }
+  /* the output queue of the clients is flushed by eventCheck on write-readiness, queuing data wakes it up */
+  client->setNonBlockingSend(true);
+  client->setOutputQueuedHandler(outputQueuedHandler, (void *) &(this->wakePipe[1]));
+  /* on request, the clients parse with the frame format of the server (a format with callbacks is copied for every client by setFormat) */
+  if (this->isClientFormatShared && this->getFormat() != nullptr) client->setFormat(this->shareFormat());
   pthread_mutex_lock(&(this->mtx));
   pthread_mutex_lock(&(this->wmtx));
   client->setSocketFd(connFd);
@@ -486,7 +602,10 @@ bool TCPServer::removeClient(const SynapSock *socket){
  *
  * This function attempts to check available event on server side after server has been initialized.
  *
- * @param[in] timeoutMs maximum waiting time to check event.
+ * The wait also ends when a client queues output data (for example a reply sent from a reception handler thread), so the queue is written without
+ * waiting for the timeout.
+ *
+ * @param[in] timeoutMs maximum waiting time to check event (shortened to the earliest flush deadline of the cork buffers of the clients).
  * @return `EVENT_NONE` when nothing happens
  * @return `EVENT_CONNECT_REQUEST` when there is a connection request from the client side (when receiving this event, the server side needs to call the `acceptNewClient` method)
  * @return `EVENT_BYTES_AVAILABLE` When there is data sent from the client side (to obtain this data, the server needs to call the reception method)
@@ -501,17 +620,38 @@ TCPServer::SERVER_EVENT_t TCPServer::eventCheck(unsigned short timeoutMs){
     return EVENT_NONE;
   }
   fd_set readfds;
+  fd_set writefds;
   unsigned short max = 0;
   int ret = 0;
+  long corkTimeLeft = 0;
+  unsigned char wakeByte = 0;
+  bool isWoken = false;
   struct timeval tv;
   ClientCollection *cList = this->clientList;
   ClientCollection *tmp = nullptr;
   max = this->sockFd;
   FD_ZERO(&readfds);
+  FD_ZERO(&writefds);
   FD_SET(this->sockFd, &readfds);
+  if (this->wakePipe[0] > 0){
+    FD_SET(this->wakePipe[0], &readfds);
+    max = max < this->wakePipe[0] ? this->wakePipe[0] : max;
+  }
   if (cList != nullptr){
     do {
-      if(cList->pipe[0] <= 0){
+      cList->client->flushIfDeadlineExpired();
+      /* wake up in time to flush the cork buffer of the client */
+      corkTimeLeft = cList->client->getCorkTimeLeft();
+      if (corkTimeLeft >= 0 && corkTimeLeft < static_cast<long>(timeoutMs)) timeoutMs = static_cast<unsigned short>(corkTimeLeft);
+      if (cList->client->getOutputQueueSize() > 0){
+        FD_SET(cList->client->getSocketFd(), &writefds);
+        max = max < cList->client->getSocketFd() ? cList->client->getSocketFd() : max;
+      }
+      if(cList->pipe[0] <= 0 && Socket::isGlobalReceiveBudgetExhausted() == true && cList->client->getReceiveUsage() == 0){
+        /* receive budget exhausted: stop polling the clients that would need new memory, their data stays in the kernel buffer */
+        gettimeofday(&(cList->lastActivity), nullptr);
+      }
+      else if(cList->pipe[0] <= 0){
         FD_SET(cList->client->getSocketFd(), &readfds);
         max = max < cList->client->getSocketFd() ? cList->client->getSocketFd() : max;
       }
@@ -526,17 +666,37 @@ TCPServer::SERVER_EVENT_t TCPServer::eventCheck(unsigned short timeoutMs){
   tv.tv_usec = (timeoutMs % 1000) * 1000;
   pthread_mutex_unlock(&(this->mtx));
   pthread_mutex_unlock(&(this->wmtx));
-  ret = select(max + 1 , &readfds , NULL , NULL , &tv);
+  ret = select(max + 1 , &readfds , &writefds , NULL , &tv);
   pthread_mutex_lock(&(this->mtx));
   pthread_mutex_lock(&(this->wmtx));
+  if (ret > 0 && this->wakePipe[0] > 0 && FD_ISSET(this->wakePipe[0], &readfds)){
+    /* a client has queued output data while select was waiting, the queues are written below */
+    while (read(this->wakePipe[0], &wakeByte, 1) > 0);
+    isWoken = true;
+  }
+  if (ret >= 0 && this->clientList != nullptr){
+    cList = this->clientList;
+    do {
+      cList->client->flushIfDeadlineExpired();
+      if (FD_ISSET(cList->client->getSocketFd(), &writefds) || (isWoken && cList->client->getOutputQueueSize() > 0)){
+        cList->client->flushOutputQueue();
+      }
+      if ((cList->client->getZeroCopy() || cList->client->getZeroCopyPendingSize() > 0) && cList->client->processZeroCopyCompletions() > 0 &&
+          FD_ISSET(cList->client->getSocketFd(), &readfds) && cList->client->isInputBytesAvailable() == false
+      ){
+        /* woken up by the zero-copy completion on the error queue, not by a disconnection */
+        FD_CLR(cList->client->getSocketFd(), &readfds);
+      }
+      cList = cList->next;
+    } while (cList != this->clientList);
+  }
   if(ret >= 0){
     if (FD_ISSET(this->sockFd, &readfds)){
-      if (this->conReqCallbackFunction != nullptr){
-        void (*callback)(TCPServer &, void *) = (void (*)(TCPServer &, void *))this->conReqCallbackFunction;
-        void *param = this->conReqCallbackParam;
+      if (this->conReqHandler){
+        CON_REQ_HANDLER_t handler = this->conReqHandler;
         pthread_mutex_unlock(&(this->mtx));
         pthread_mutex_unlock(&(this->wmtx));
-        callback(*this, param);
+        handler(*this);
       }
       else {
         pthread_mutex_unlock(&(this->mtx));
@@ -574,10 +734,9 @@ clientEvent:
             pthread_mutex_unlock(&(this->wmtx));
             return EVENT_CLIENT_DISCONNECTED;
           }
-          if (this->receptionCallbackFunction != nullptr){
+          if (this->receptionHandler){
             if (this->receptionHandlerAsThread == false){
-              void (*callback)(SynapSock &, void *) = (void (*)(SynapSock &, void *))this->receptionCallbackFunction;
-              callback(*(this->client), this->conReqCallbackParam);
+              this->receptionHandler(*(this->client));
             }
             else {
               struct thHandler_t handlerPointer = {cList, this};
@@ -683,6 +842,30 @@ void TCPServer::setConnectionRequestHandler(void (*func)(TCPServer &, void *), v
   pthread_mutex_lock(&(this->wmtx));
   this->conReqCallbackFunction = (const void *) func;
   this->conReqCallbackParam = param;
+  if (func != nullptr){
+    this->conReqHandler = [func, param](TCPServer &server){ func(server, param); };
+  }
+  else {
+    this->conReqHandler = nullptr;
+  }
+  pthread_mutex_unlock(&(this->mtx));
+  pthread_mutex_unlock(&(this->wmtx));
+}
+
+/**
+ * @brief Overloaded method of `setConnectionRequestHandler` with a callable.
+ *
+ * The callable (lambda, `std::function` or function object) is stored inline without allocation, so it can carry its own state
+ * instead of a `void *` parameter.
+ *
+ * @param[in] func callable that has 1 parameter. `TCP Server &` is an object of the server itself.
+ */
+void TCPServer::setConnectionRequestHandler(const CON_REQ_HANDLER_t &func){
+  pthread_mutex_lock(&(this->mtx));
+  pthread_mutex_lock(&(this->wmtx));
+  this->conReqCallbackFunction = nullptr;
+  this->conReqCallbackParam = nullptr;
+  this->conReqHandler = func;
   pthread_mutex_unlock(&(this->mtx));
   pthread_mutex_unlock(&(this->wmtx));
 }
@@ -701,6 +884,12 @@ void TCPServer::setReceptionHandler(void (*func)(SynapSock &, void *), void *par
   pthread_mutex_lock(&(this->wmtx));
   this->receptionCallbackFunction = (const void *) func;
   this->receptionCallbackParam = param;
+  if (func != nullptr){
+    this->receptionHandler = [func, param](SynapSock &connection){ func(connection, param); };
+  }
+  else {
+    this->receptionHandler = nullptr;
+  }
   this->receptionHandlerAsThread = asThread;
   pthread_mutex_unlock(&(this->mtx));
   pthread_mutex_unlock(&(this->wmtx));
@@ -718,10 +907,54 @@ void TCPServer::setReceptionHandler(void (*func)(SynapSock &, void *), void *par
   this->setReceptionHandler(func, param, false);
 }
 
+/**
+ * @brief Overloaded method of `setReceptionHandler` with a callable.
+ *
+ * This method must be called before socket communication begins (before calling the `eventCheck` method).
+ * The callable (lambda, `std::function` or function object) is stored inline without allocation, so it can carry per-server state
+ * instead of a `void *` parameter.
+ *
+ * @param[in] func callable that has 1 parameter. `SynapSock &` is an active connection.
+ * @param[in] asThread if the given value is true, then the reception handler will run as a thread.
+ */
+void TCPServer::setReceptionHandler(const RECEPTION_HANDLER_t &func, bool asThread){
+  pthread_mutex_lock(&(this->mtx));
+  pthread_mutex_lock(&(this->wmtx));
+  this->receptionCallbackFunction = nullptr;
+  this->receptionCallbackParam = nullptr;
+  this->receptionHandler = func;
+  this->receptionHandlerAsThread = asThread;
+  pthread_mutex_unlock(&(this->mtx));
+  pthread_mutex_unlock(&(this->wmtx));
+}
+
+/**
+ * @brief Overloaded method of `setReceptionHandler` with a callable for non-thread operation.
+ *
+ * This method must be called before socket communication begins (before calling the `eventCheck` method).
+ *
+ * @param[in] func callable that has 1 parameter. `SynapSock &` is an active connection.
+ */
+void TCPServer::setReceptionHandler(const RECEPTION_HANDLER_t &func){
+  this->setReceptionHandler(func, false);
+}
+
+/**
+ * @brief Retrieves the data reception handler.
+ *
+ * @return copy of the reception handler (empty if no handler is set).
+ */
+TCPServer::RECEPTION_HANDLER_t TCPServer::getReceptionHandler(){
+  pthread_mutex_lock(&(this->mtx));
+  RECEPTION_HANDLER_t handler = this->receptionHandler;
+  pthread_mutex_unlock(&(this->mtx));
+  return handler;
+}
+
 /**
  * @brief Retrieves the pointer address for the data reception handler function.
  *
- * @return pointer of reception handler function.
+ * @return pointer of reception handler function (`nullptr` if the handler has been set with a callable).
  */
 const void *TCPServer::getReceptionHandlerFunction(){
   return this->receptionCallbackFunction;
@@ -747,7 +980,7 @@ void *TCPServer::getReceptionHandlerParam(){
  * @return `true` when success.
  * @return `false` when failed (if the SSL preprocessor is not enabled or SSL handshake is not enabled)
  */
-bool TCPServer::initializeSSL(const std::string cert, const std::string key){
+bool TCPServer::initializeSSL(const std::string &cert, const std::string &key){
   this->sslWarper = new SSLWarper(SSLWarper::CTX_TYPE_SERVER, cert, key);
   if (this->sslWarper) return true;
   return false;
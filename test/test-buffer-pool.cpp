@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <iostream>
+#include "buffer-pool.hpp"
+
+TEST(BufferPoolTest, Reuse_1) {
+    BufferPool pool;
+    std::vector <unsigned char> *data = nullptr;
+    BufferPool::BUFFER_t buffer = pool.acquire();
+    ASSERT_NE(buffer, nullptr);
+    ASSERT_EQ(buffer->size(), 0);
+    ASSERT_EQ(pool.getFreeCount(), 0);
+    buffer->resize(1024);
+    data = buffer.get();
+    buffer.reset();
+    ASSERT_EQ(pool.getFreeCount(), 1);
+    /* the released buffer is given back empty, with its capacity */
+    buffer = pool.acquire();
+    ASSERT_EQ(buffer.get(), data);
+    ASSERT_EQ(buffer->size(), 0);
+    ASSERT_GE(buffer->capacity(), 1024);
+    ASSERT_EQ(pool.getFreeCount(), 0);
+}
+
+TEST(BufferPoolTest, Limit_1) {
+    BufferPool pool(2);
+    BufferPool::BUFFER_t buffers[3] = {pool.acquire(), pool.acquire(), pool.acquire()};
+    for (int i = 0; i < 3; i++){
+        buffers[i].reset();
+    }
+    ASSERT_EQ(pool.getFreeCount(), 2);
+}
+
+TEST(BufferPoolTest, OutlivePool_1) {
+    BufferPool::BUFFER_t buffer;
+    {
+        BufferPool pool;
+        buffer = pool.acquire();
+        buffer->push_back(0x01);
+    }
+    ASSERT_EQ(buffer->size(), 1);
+    buffer.reset();
+}
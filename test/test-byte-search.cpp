@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "byte-search.hpp"
+
+static size_t naiveSearch(const unsigned char *buffer, size_t sz, const unsigned char *pattern, size_t patternSz){
+    if (patternSz == 0) return 0;
+    if (sz < patternSz) return ByteSearch::NOT_FOUND;
+    for (size_t i = 0; i <= sz - patternSz; i++){
+        if (memcmp(buffer + i, pattern, patternSz) == 0) return i;
+    }
+    return ByteSearch::NOT_FOUND;
+}
+
+class ByteSearchTest:public::testing::Test {
+protected:
+    void SetUp() override {
+        std::cout << "Search Kernel: " << ByteSearch::getKernelName() << std::endl;
+    }
+};
+
+TEST_F(ByteSearchTest, EdgeCase_1) {
+    const unsigned char buffer[] = "0123456789abcdef0123456789ABCDEF";
+    ASSERT_EQ(ByteSearch::find(buffer, 32, (const unsigned char *) "", 0), 0);
+    ASSERT_EQ(ByteSearch::find(buffer, 32, (const unsigned char *) "0", 1), 0);
+    ASSERT_EQ(ByteSearch::find(buffer, 32, (const unsigned char *) "F", 1), 31);
+    ASSERT_EQ(ByteSearch::find(buffer, 32, (const unsigned char *) "EF", 2), 30);
+    ASSERT_EQ(ByteSearch::find(buffer, 32, (const unsigned char *) "9A", 2), 25);
+    ASSERT_EQ(ByteSearch::find(buffer, 32, (const unsigned char *) "fe", 2), ByteSearch::NOT_FOUND);
+    ASSERT_EQ(ByteSearch::find(buffer, 3, (const unsigned char *) "01234", 5), ByteSearch::NOT_FOUND);
+    ASSERT_EQ(ByteSearch::find(nullptr, 0, (const unsigned char *) "0", 1), ByteSearch::NOT_FOUND);
+}
+
+TEST_F(ByteSearchTest, RandomCompare_1) {
+    std::vector <unsigned char> buffer;
+    unsigned char pattern[16];
+    size_t patternSz = 0;
+    srand(4431);
+    for (int n = 0; n < 2000; n++){
+        buffer.resize(rand() % 300);
+        /* small alphabet, so partial matches (first and last byte) are frequent */
+        for (size_t i = 0; i < buffer.size(); i++) buffer[i] = 'a' + rand() % 3;
+        patternSz = 1 + rand() % sizeof(pattern);
+        for (size_t i = 0; i < patternSz; i++) pattern[i] = 'a' + rand() % 3;
+        ASSERT_EQ(ByteSearch::find(buffer.data(), buffer.size(), pattern, patternSz), naiveSearch(buffer.data(), buffer.size(), pattern, patternSz));
+    }
+}
+
+TEST_F(ByteSearchTest, MatchAtEnd_1) {
+    std::vector <unsigned char> buffer;
+    const unsigned char pattern[] = {0x0d, 0x0a, 0xff};
+    for (size_t sz = 3; sz < 200; sz++){
+        buffer.assign(sz, 0x0d);
+        memcpy(buffer.data() + sz - 3, pattern, 3);
+        ASSERT_EQ(ByteSearch::find(buffer.data(), buffer.size(), pattern, 3), sz - 3);
+        buffer[sz - 1] = 0x00;
+        ASSERT_EQ(ByteSearch::find(buffer.data(), buffer.size(), pattern, 3), ByteSearch::NOT_FOUND);
+    }
+}
+
+TEST_F(ByteSearchTest, MatcherSplitChunk_1) {
+    const unsigned char data[] = "xxabaabaabacxxabab";
+    const unsigned char pattern[] = "abaabac";
+    ByteMatcher matcher;
+    size_t sz = strlen((const char *) data);
+    size_t expected = naiveSearch(data, sz, pattern, 7) + 7;
+    ASSERT_EQ(matcher.setPattern(pattern, 7), true);
+    ASSERT_EQ(matcher.setPattern(pattern, 7), false);
+    for (size_t split = 0; split <= sz; split++){
+        matcher.reset();
+        size_t ret = matcher.feed(data, split);
+        if (ret == ByteSearch::NOT_FOUND){
+            ret = matcher.feed(data + split, sz - split);
+            ASSERT_NE(ret, ByteSearch::NOT_FOUND);
+            ret += split;
+        }
+        ASSERT_EQ(ret, expected);
+        ASSERT_EQ(matcher.getState(), 0);
+    }
+}
+
+TEST_F(ByteSearchTest, MatcherRandomChunk_1) {
+    std::vector <unsigned char> buffer;
+    unsigned char pattern[8];
+    size_t patternSz = 0;
+    ByteMatcher matcher;
+    srand(4432);
+    for (int n = 0; n < 2000; n++){
+        buffer.resize(1 + rand() % 200);
+        for (size_t i = 0; i < buffer.size(); i++) buffer[i] = 'a' + rand() % 2;
+        patternSz = 1 + rand() % sizeof(pattern);
+        for (size_t i = 0; i < patternSz; i++) pattern[i] = 'a' + rand() % 2;
+        matcher.setPattern(pattern, patternSz);
+        matcher.reset();
+        size_t pos = 0;
+        size_t ret = ByteSearch::NOT_FOUND;
+        while (pos < buffer.size() && ret == ByteSearch::NOT_FOUND){
+            size_t chunk = 1 + rand() % 7;
+            if (chunk > buffer.size() - pos) chunk = buffer.size() - pos;
+            ret = matcher.feed(buffer.data() + pos, chunk);
+            if (ret != ByteSearch::NOT_FOUND) ret += pos;
+            pos += chunk;
+        }
+        size_t expected = naiveSearch(buffer.data(), buffer.size(), pattern, patternSz);
+        if (expected != ByteSearch::NOT_FOUND) expected += patternSz;
+        ASSERT_EQ(ret, expected);
+    }
+}
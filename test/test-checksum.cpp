@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "checksum.hpp"
+
+static uint16_t bitwiseCrc16(uint16_t crc, const unsigned char *buffer, size_t sz){
+    for (size_t i = 0; i < sz; i++){
+        crc ^= (static_cast<uint16_t>(buffer[i]) << 8);
+        for (int j = 0; j < 8; j++) crc = (crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1);
+    }
+    return crc;
+}
+
+static uint32_t bitwiseCrc32(uint32_t poly, const unsigned char *buffer, size_t sz){
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < sz; i++){
+        crc ^= buffer[i];
+        for (int j = 0; j < 8; j++) crc = (crc & 1 ? (crc >> 1) ^ poly : crc >> 1);
+    }
+    return ~crc;
+}
+
+class ChecksumTest:public::testing::Test {
+protected:
+    void SetUp() override {
+        std::cout << "CRC32 Kernel: " << Checksum::getCrc32KernelName() << std::endl;
+        std::cout << "CRC32C Kernel: " << Checksum::getCrc32cKernelName() << std::endl;
+    }
+};
+
+TEST_F(ChecksumTest, CheckValue_1) {
+    const unsigned char *buffer = (const unsigned char *) "123456789";
+    ASSERT_EQ(Checksum::compute(Checksum::CHECKSUM_CRC16_CCITT_FALSE, buffer, 9), 0x29B1);
+    ASSERT_EQ(Checksum::compute(Checksum::CHECKSUM_CRC16_XMODEM, buffer, 9), 0x31C3);
+    ASSERT_EQ(Checksum::compute(Checksum::CHECKSUM_CRC32, buffer, 9), 0xCBF43926);
+    ASSERT_EQ(Checksum::compute(Checksum::CHECKSUM_CRC32C, buffer, 9), 0xE3069283);
+    ASSERT_EQ(Checksum::compute(Checksum::CHECKSUM_SUM8, buffer, 9), 0xDD);
+    ASSERT_EQ(Checksum::compute(Checksum::CHECKSUM_XOR8, buffer, 9), 0x31);
+    ASSERT_EQ(Checksum::compute(Checksum::CHECKSUM_CRC32, buffer, 0), 0);
+    ASSERT_EQ(Checksum::getSize(Checksum::CHECKSUM_CRC16_XMODEM), 2);
+    ASSERT_EQ(Checksum::getSize(Checksum::CHECKSUM_CRC32C), 4);
+    ASSERT_EQ(Checksum::getSize(Checksum::CHECKSUM_XOR8), 1);
+}
+
+TEST_F(ChecksumTest, RandomCompare_1) {
+    std::vector <unsigned char> buffer(4096);
+    srand(1234);
+    for (size_t i = 0; i < buffer.size(); i++) buffer[i] = (unsigned char) rand();
+    for (size_t sz = 0; sz <= buffer.size(); sz += 61){
+        ASSERT_EQ(Checksum::crc16Ccitt(0xFFFF, buffer.data(), sz), bitwiseCrc16(0xFFFF, buffer.data(), sz));
+        ASSERT_EQ(Checksum::crc32(0, buffer.data(), sz), bitwiseCrc32(0xEDB88320, buffer.data(), sz));
+        ASSERT_EQ(Checksum::crc32c(0, buffer.data(), sz), bitwiseCrc32(0x82F63B78, buffer.data(), sz));
+    }
+}
+
+TEST_F(ChecksumTest, Incremental_1) {
+    std::vector <unsigned char> buffer(2048);
+    srand(4321);
+    for (size_t i = 0; i < buffer.size(); i++) buffer[i] = (unsigned char) rand();
+    Checksum::ALGORITHM_t algorithms[] = {
+        Checksum::CHECKSUM_CRC16_CCITT_FALSE, Checksum::CHECKSUM_CRC16_XMODEM, Checksum::CHECKSUM_CRC32,
+        Checksum::CHECKSUM_CRC32C, Checksum::CHECKSUM_SUM8, Checksum::CHECKSUM_XOR8
+    };
+    for (Checksum::ALGORITHM_t algorithm : algorithms){
+        uint32_t value = Checksum::init(algorithm);
+        size_t pos = 0;
+        size_t chunk = 1;
+        while (pos < buffer.size()){
+            if (chunk > buffer.size() - pos) chunk = buffer.size() - pos;
+            value = Checksum::update(algorithm, value, buffer.data() + pos, chunk);
+            pos += chunk;
+            chunk = (chunk * 7) % 131 + 1;
+        }
+        ASSERT_EQ(value, Checksum::compute(algorithm, buffer.data(), buffer.size()));
+    }
+}
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <iostream>
+#include "field-view.hpp"
+
+TEST(FieldViewTest, Empty_1) {
+    FieldView view;
+    ASSERT_EQ(view.isEmpty(), true);
+    ASSERT_EQ(view.getSize(), 0);
+    ASSERT_EQ(view.getData(), nullptr);
+    ASSERT_EQ(view.u8(0), 0);
+    ASSERT_EQ(view.u32be(0), 0);
+    ASSERT_EQ(view.sub(1, 2).isEmpty(), true);
+}
+
+TEST(FieldViewTest, Read_1) {
+    const unsigned char buffer[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09};
+    FieldView view(buffer, sizeof(buffer));
+    ASSERT_EQ(view.getData(), buffer);
+    ASSERT_EQ(view.getSize(), 9);
+    ASSERT_EQ(view[8], 0x09);
+    ASSERT_EQ(view.u8(0), 0x01);
+    ASSERT_EQ(view.u16be(0), 0x0102);
+    ASSERT_EQ(view.u16le(0), 0x0201);
+    ASSERT_EQ(view.u32be(1), 0x02030405u);
+    ASSERT_EQ(view.u32le(1), 0x05040302u);
+    ASSERT_EQ(view.u64be(1), 0x0203040506070809ull);
+    ASSERT_EQ(view.u64le(0), 0x0807060504030201ull);
+    /* reads past the end of the field give 0 */
+    ASSERT_EQ(view.u8(9), 0);
+    ASSERT_EQ(view.u16be(8), 0);
+    ASSERT_EQ(view.u64le(2), 0);
+    ASSERT_EQ(view.u32le(100), 0);
+}
+
+TEST(FieldViewTest, Sub_1) {
+    const char *text = "1234abcd90-=";
+    FieldView view((const unsigned char *) text, 12);
+    FieldView part = view.sub(4, 4);
+    ASSERT_EQ(part.getData(), view.getData() + 4);
+    ASSERT_EQ(part.toStringView(), "abcd");
+    ASSERT_EQ(view.sub(8, 100).toStringView(), "90-=");
+    ASSERT_EQ(view.sub(12, 1).isEmpty(), true);
+    ASSERT_EQ(view.sub(13, 1).isEmpty(), true);
+    ASSERT_EQ(part.toVector(), (std::vector <unsigned char>{'a', 'b', 'c', 'd'}));
+}
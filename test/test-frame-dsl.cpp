@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <iostream>
+#include <string.h>
+#include <vector>
+#include "frame-dsl.hpp"
+
+typedef FrameDsl::Frame <FrameDsl::StartBytes <'1', '2', '3', '4'>,
+                         FrameDsl::Length <SynapSock::LENGTH_ENCODING_UINT16_BE>,
+                         FrameDsl::Data <FrameDsl::LenFrom <1, 0, 64>>,
+                         FrameDsl::Validator <Checksum::CHECKSUM_CRC16_XMODEM, 1, 2>,
+                         FrameDsl::StopBytes <'9', '0', '-', '='>> LengthFrame;
+
+typedef FrameDsl::Frame <FrameDsl::StartBytes <'1', '2', '3', '4'>,
+                         FrameDsl::Command <1>,
+                         FrameDsl::Data <FrameDsl::UntilStop>,
+                         FrameDsl::StopBytes <'9', '0', '-', '='>> TextFrame;
+
+typedef FrameDsl::Frame <FrameDsl::Command <2>,
+                         FrameDsl::Length <SynapSock::LENGTH_ENCODING_VARINT>,
+                         FrameDsl::Data <FrameDsl::LenFrom <1>>,
+                         FrameDsl::Validator <Checksum::CHECKSUM_CRC32, 0, 2>> VarintFrame;
+
+class FrameDslTest:public::testing::Test {};
+
+TEST_F(FrameDslTest, Constants_1) {
+    ASSERT_EQ(LengthFrame::FIELD_COUNT, 5);
+    ASSERT_EQ(LengthFrame::MIN_SIZE, 12);
+    ASSERT_EQ(LengthFrame::IS_FIXED_SIZE, false);
+    ASSERT_EQ(TextFrame::MIN_SIZE, 9);
+    ASSERT_EQ(VarintFrame::MIN_SIZE, 7);
+    ASSERT_EQ((FrameDsl::Frame <FrameDsl::StartBytes <'A'>, FrameDsl::Command <3>>::IS_FIXED_SIZE), true);
+}
+
+TEST_F(FrameDslTest, EncodeParse_1) {
+    SynapSock::FRAME_VIEW_t input[LengthFrame::FIELD_COUNT] = {};
+    SynapSock::FRAME_VIEW_t fields[LengthFrame::FIELD_COUNT] = {};
+    std::vector <unsigned char> buffer;
+    size_t begin = 0;
+    size_t size = 0;
+    input[2] = {(const unsigned char *) "qwerty", 6};
+    ASSERT_EQ(LengthFrame::encode(buffer, input), 0);
+    ASSERT_EQ(buffer.size(), 18);
+    ASSERT_EQ(memcmp(buffer.data(), "1234\x00\x06qwerty", 12), 0);
+    ASSERT_EQ(memcmp(buffer.data() + 14, "90-=", 4), 0);
+    buffer.insert(buffer.begin(), {'x', 'x'});
+    ASSERT_EQ(LengthFrame::parse(buffer.data(), buffer.size(), &begin, &size, fields), 0);
+    ASSERT_EQ(begin, 2);
+    ASSERT_EQ(size, 18);
+    ASSERT_EQ(fields[2].size, 6);
+    ASSERT_EQ(memcmp(fields[2].data, "qwerty", 6), 0);
+    /* an incomplete frame keeps the start of the frame */
+    ASSERT_EQ(LengthFrame::parse(buffer.data(), buffer.size() - 1, &begin, &size), 2);
+    ASSERT_EQ(begin, 2);
+    /* a corrupted checksum */
+    buffer[8] ^= 0x01;
+    ASSERT_EQ(LengthFrame::parse(buffer.data(), buffer.size(), &begin, &size), 4);
+    ASSERT_EQ(begin, 2);
+    /* a field larger than the maximum size */
+    input[2] = {buffer.data(), 65};
+    ASSERT_EQ(LengthFrame::encode(buffer, input), 1);
+    ASSERT_EQ(buffer.size(), 0);
+}
+
+TEST_F(FrameDslTest, EncodeParse_2) {
+    SynapSock::FRAME_VIEW_t input[VarintFrame::FIELD_COUNT] = {};
+    SynapSock::FRAME_VIEW_t fields[VarintFrame::FIELD_COUNT] = {};
+    std::vector <unsigned char> buffer;
+    std::vector <unsigned char> payload(200, 0x5A);
+    size_t begin = 0;
+    size_t size = 0;
+    input[0] = {(const unsigned char *) "AB", 2};
+    input[2] = {payload.data(), payload.size()};
+    ASSERT_EQ(VarintFrame::encode(buffer, input), 0);
+    ASSERT_EQ(buffer.size(), 208);
+    ASSERT_EQ(buffer[2], 0xC8);
+    ASSERT_EQ(buffer[3], 0x01);
+    ASSERT_EQ(VarintFrame::parse(buffer.data(), buffer.size(), &begin, &size, fields), 0);
+    ASSERT_EQ(begin, 0);
+    ASSERT_EQ(size, 208);
+    ASSERT_EQ(fields[2].size, 200);
+    ASSERT_EQ(fields[3].size, 4);
+    input[0] = {(const unsigned char *) "ABC", 3};
+    ASSERT_EQ(VarintFrame::encode(buffer, input), 1);
+}
+
+TEST_F(FrameDslTest, UntilStop_1) {
+    SynapSock::FRAME_VIEW_t fields[TextFrame::FIELD_COUNT] = {};
+    const unsigned char *buffer = (const unsigned char *) "qw1234567890-=12346ab90";
+    size_t begin = 0;
+    size_t size = 0;
+    ASSERT_EQ(TextFrame::parse(buffer, 23, &begin, &size, fields), 0);
+    ASSERT_EQ(begin, 2);
+    ASSERT_EQ(size, 12);
+    ASSERT_EQ(fields[1].size, 1);
+    ASSERT_EQ(fields[1].data[0], '5');
+    ASSERT_EQ(fields[2].size, 3);
+    ASSERT_EQ(memcmp(fields[2].data, "678", 3), 0);
+    ASSERT_EQ(TextFrame::parse(buffer + 14, 9, &begin, &size), 2);
+    ASSERT_EQ(begin, 0);
+    /* no start bytes, only the tail may hold the beginning of a frame */
+    ASSERT_EQ(TextFrame::parse((const unsigned char *) "qwerty123", 9, &begin, &size), 2);
+    ASSERT_EQ(begin, 6);
+}
@@ -4,8 +4,12 @@
 #include <iostream>
 #include <unistd.h>
 #include <pthread.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
 #include "tcp-client.hpp"
 #include "tcp-server.hpp"
+#include "frame-dsl.hpp"
 
 extern bool isRun;
 
@@ -228,6 +232,28 @@ TEST_F(TCPFramedDataTest, OperatorOverloading_5) {
     ASSERT_EQ(frame, nullptr);
 }
 
+TEST_F(TCPFramedDataTest, OperatorOverloading_append) {
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA, 2);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    client = startBytes + cmdBytes;
+    ASSERT_EQ(client[2], nullptr);
+    ASSERT_EQ(client[DataFrame::FRAME_TYPE_DATA], nullptr);
+    client += dataBytes;
+    client += stopBytes;
+    ASSERT_NE(client[3], nullptr);
+    ASSERT_EQ(client[3]->getType(), DataFrame::FRAME_TYPE_STOP_BYTES);
+    ASSERT_EQ(client[-1], nullptr);
+    ASSERT_EQ(client[4], nullptr);
+    ASSERT_EQ(client[DataFrame::FRAME_TYPE_DATA], client[2]);
+    ASSERT_EQ((client[{DataFrame::FRAME_TYPE_DATA, 0}]), client[2]);
+    ASSERT_EQ((client[{DataFrame::FRAME_TYPE_DATA, 1}]), nullptr);
+    client.destroyFormat();
+    ASSERT_EQ(client[0], nullptr);
+    ASSERT_EQ(client[DataFrame::FRAME_TYPE_START_BYTES], nullptr);
+}
+
 TEST_F(TCPFramedDataTest, OperatorOverloading_6) {
     unsigned char buffer[8];
     std::vector <unsigned char> tmp;
@@ -622,6 +648,26 @@ TEST_F(TCPFramedDataTest, ReceptionTest_withUnknownDataSz_1) {
     ASSERT_EQ(memcmp(tmp.data(), (unsigned char *) "qwertyuiopplkjhgfdsaZxcvbh76redcvbnm,mvdswertyuioiuhgfcxvbnm", 60), 0);
 }
 
+TEST_F(TCPFramedDataTest, ReceptionTest_refreshFormat) {
+    unsigned char buffer[16];
+    client.setPort(4431);
+    client.setTimeout(250);
+    client.setKeepAlive(25);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    client = startBytes + dataBytes + stopBytes;
+    ASSERT_EQ(client.init(), 0);
+    /* the parse plan keeps its copy of the stop bytes until the frame format is compiled again */
+    client[DataFrame::FRAME_TYPE_STOP_BYTES]->setData((const unsigned char *) "ab-=", 4);
+    client.refreshFormat();
+    ASSERT_EQ(client.sendData("1234xyz90-=ab-="), 0);
+    ASSERT_EQ(client.receiveFramedData(), 0);
+    ASSERT_EQ(client.getDataSize(), 15);
+    ASSERT_EQ(client.getBuffer(buffer, sizeof(buffer)), 15);
+    ASSERT_EQ(memcmp(buffer, (const unsigned char *) "1234xyz90-=ab-=", 15), 0);
+}
+
 TEST_F(TCPFramedDataTest, ReceptionTest_withUnknownDataSz_2) {
     unsigned char buffer[16];
     struct timeval tvStart, tvEnd;
@@ -794,3 +840,774 @@ TEST_F(TCPFramedDataTest, ReceptionTestNegative_InvalidTrigger_1) {
     ASSERT_EQ(tmp.size(), 7);
     ASSERT_EQ(memcmp(tmp.data(), (const unsigned char *) "67890-=", 7), 0);
 }
+
+TEST_F(TCPFramedDataTest, ReceptionTest_batch_1) {
+    std::vector <SynapSock::FRAME_VIEW_t> frames;
+    client.setPort(4431);
+    client.setTimeout(250);
+    client.setKeepAlive(25);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    cmdBytes.setPostExecuteFunction((const void *) &setupLengthByCommand, (void *) &client);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    client = startBytes + cmdBytes + dataBytes + stopBytes;
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.sendData("qw1234567890-=12346ab90-=xx1234790-=1234567890-=12345"), 0);
+    ASSERT_EQ(client.receiveFramedDataBatch(frames), 0);
+    ASSERT_EQ(frames.size(), 3);
+    ASSERT_EQ(frames[0].size, 12);
+    ASSERT_EQ(memcmp(frames[0].data, "1234567890-=", 12), 0);
+    ASSERT_EQ(frames[1].size, 11);
+    ASSERT_EQ(memcmp(frames[1].data, "12346ab90-=", 11), 0);
+    ASSERT_EQ(frames[2].size, 12);
+    ASSERT_EQ(memcmp(frames[2].data, "1234567890-=", 12), 0);
+    ASSERT_EQ(client.getRemainingDataSize(), 5);
+    ASSERT_EQ(client.sendData("67890-="), 0);
+    ASSERT_EQ(client.receiveFramedDataBatch(frames), 0);
+    ASSERT_EQ(frames.size(), 1);
+    ASSERT_EQ(frames[0].size, 12);
+    ASSERT_EQ(memcmp(frames[0].data, "1234567890-=", 12), 0);
+    ASSERT_EQ(client.getRemainingDataSize(), 0);
+}
+
+TEST_F(TCPFramedDataTest, LengthFieldTest_1) {
+    std::vector <SynapSock::FRAME_VIEW_t> frames;
+    client.setPort(4431);
+    client.setTimeout(250);
+    client.setKeepAlive(25);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, 1, (const unsigned char *) "\x02");
+    DataFrame lengthBytes(DataFrame::FRAME_TYPE_CONTENT_LENGTH);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, 1, (const unsigned char *) "\x03");
+    client = startBytes + lengthBytes + dataBytes + stopBytes;
+    ASSERT_EQ(client.setLengthField(2, 1, SynapSock::LENGTH_ENCODING_UINT16_LE), 1);
+    ASSERT_EQ(client.setLengthField(1, 4, SynapSock::LENGTH_ENCODING_UINT16_LE), 1);
+    ASSERT_EQ(client.setLengthField(0, 2, SynapSock::LENGTH_ENCODING_UINT16_LE), 1);
+    /* the length counts the length field itself, the data is limited to 8 bytes */
+    ASSERT_EQ(client.setLengthField(1, 2, SynapSock::LENGTH_ENCODING_UINT16_LE, -2, 8), 0);
+    ASSERT_EQ(client[1]->getSize(), 2);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.sendData((const unsigned char *) "\x02\x05\x00" "abc\x03\x02\x02\x00\x03\x02\x0c\x00" "0123456789\x03\x02\x04\x00xy\x03", 31), 0);
+    ASSERT_EQ(client.receiveFramedDataBatch(frames), 0);
+    ASSERT_EQ(frames.size(), 3);
+    ASSERT_EQ(frames[0].size, 7);
+    ASSERT_EQ(memcmp(frames[0].data, "\x02\x05\x00" "abc\x03", 7), 0);
+    ASSERT_EQ(frames[1].size, 4);
+    ASSERT_EQ(memcmp(frames[1].data, "\x02\x02\x00\x03", 4), 0);
+    ASSERT_EQ(frames[2].size, 6);
+    ASSERT_EQ(memcmp(frames[2].data, "\x02\x04\x00xy\x03", 6), 0);
+    ASSERT_EQ(client.getRemainingDataSize(), 0);
+    /* the length field is bound again with another encoding, the previous binding is replaced */
+    ASSERT_EQ(client.setLengthField(1, 2, SynapSock::LENGTH_ENCODING_UINT8), 0);
+    ASSERT_EQ(client[1]->getSize(), 1);
+    ASSERT_EQ(client.sendData((const unsigned char *) "\x02\x03xyz\x03", 6), 0);
+    ASSERT_EQ(client.receiveFramedDataBatch(frames), 0);
+    ASSERT_EQ(frames.size(), 1);
+    ASSERT_EQ(frames[0].size, 6);
+    ASSERT_EQ(memcmp(frames[0].data, "\x02\x03xyz\x03", 6), 0);
+}
+
+TEST_F(TCPFramedDataTest, LengthFieldTest_varint) {
+    std::vector <unsigned char> payload;
+    std::vector <unsigned char> tmp;
+    client.setPort(4431);
+    client.setTimeout(250);
+    client.setKeepAlive(25);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame lengthBytes(DataFrame::FRAME_TYPE_CONTENT_LENGTH);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    client = startBytes + lengthBytes + dataBytes + stopBytes;
+    ASSERT_EQ(client.setLengthField(1, 2, SynapSock::LENGTH_ENCODING_VARINT), 0);
+    for (int i = 0; i < 200; i++) payload.push_back((unsigned char) ('a' + i % 26));
+    client[2]->setSize(payload.size());
+    client[2]->setData(payload);
+    ASSERT_EQ(client.init(), 0);
+    /* the length field is encoded from the size of the data field */
+    ASSERT_EQ(client.sendFramedData(), 0);
+    client[2]->setSize(0);
+    ASSERT_EQ(client.receiveFramedData(), 0);
+    ASSERT_EQ(client.getBuffer(tmp), 210);
+    ASSERT_EQ(memcmp(tmp.data(), "1234\xc8\x01", 6), 0);
+    ASSERT_EQ(memcmp(tmp.data() + 206, "90-=", 4), 0);
+    ASSERT_EQ(client[2]->getData(tmp), 200);
+    ASSERT_EQ(tmp, payload);
+}
+
+TEST_F(TCPFramedDataTest, LengthFieldTest_overflow) {
+    std::vector <unsigned char> payload(300, 'a');
+    TCPClient limited;
+    TCPClient adjusted;
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, 1, (const unsigned char *) "\x02");
+    DataFrame lengthBytes(DataFrame::FRAME_TYPE_CONTENT_LENGTH);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, 1, (const unsigned char *) "\x03");
+    /* the size exceeds the maximum size, then the width of the length field */
+    limited = startBytes + lengthBytes + dataBytes + stopBytes;
+    ASSERT_EQ(limited.setLengthField(1, 2, SynapSock::LENGTH_ENCODING_UINT8, 0, 200), 0);
+    limited[2]->setSize(250);
+    limited[2]->setData(payload.data(), 250);
+    ASSERT_EQ(limited.sendFramedData(), 3);
+    limited[2]->setSize(200);
+    limited[2]->setData(payload.data(), 200);
+    ASSERT_EQ(limited.sendFramedData(), 1);
+    /* the length also counts 2 bytes, so the largest size is 253 bytes */
+    adjusted = startBytes + lengthBytes + dataBytes + stopBytes;
+    ASSERT_EQ(adjusted.setLengthField(1, 2, SynapSock::LENGTH_ENCODING_UINT8, -2, 0), 0);
+    adjusted[2]->setSize(254);
+    adjusted[2]->setData(payload.data(), 254);
+    ASSERT_EQ(adjusted.sendFramedData(), 3);
+    adjusted[2]->setSize(253);
+    adjusted[2]->setData(payload.data(), 253);
+    ASSERT_EQ(adjusted.sendFramedData(), 1);
+}
+
+TEST_F(TCPFramedDataTest, ValidatorTest_crc16) {
+    std::vector <SynapSock::FRAME_VIEW_t> frames;
+    client.setPort(4431);
+    client.setTimeout(250);
+    client.setKeepAlive(25);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    cmdBytes.setPostExecuteFunction((const void *) &setupLengthByCommand, (void *) &client);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame crcBytes(DataFrame::FRAME_TYPE_VALIDATOR);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    client = startBytes + cmdBytes + dataBytes + crcBytes + stopBytes;
+    ASSERT_EQ(client.setValidator(3, 2, 1, Checksum::CHECKSUM_CRC16_XMODEM), 1);
+    ASSERT_EQ(client.setValidator(2, 0, 2, Checksum::CHECKSUM_CRC16_XMODEM), 1);
+    ASSERT_EQ(client.setValidator(3, 0, 2, Checksum::CHECKSUM_CRC16_XMODEM, false), 0);
+    ASSERT_EQ(client[3]->getSize(), 2);
+    ASSERT_EQ(client.init(), 0);
+    /* the first frame has an invalid CRC */
+    ASSERT_EQ(client.sendData((const unsigned char *) "12345678\x15\x91" "90-=12345678\x15\x90" "90-=123469\x00\x00" "90-=", 40), 0);
+    ASSERT_EQ(client.receiveFramedDataBatch(frames), 0);
+    ASSERT_EQ(frames.size(), 1);
+    ASSERT_EQ(frames[0].size, 14);
+    ASSERT_EQ(memcmp(frames[0].data, "12345678\x15\x90" "90-=", 14), 0);
+    ASSERT_EQ(client.getRemainingDataSize(), 3);
+}
+
+TEST_F(TCPFramedDataTest, ValidatorTest_crc32c) {
+    std::vector <unsigned char> payload;
+    std::vector <unsigned char> tmp;
+    client.setPort(4431);
+    client.setTimeout(250);
+    client.setKeepAlive(25);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame lengthBytes(DataFrame::FRAME_TYPE_CONTENT_LENGTH);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame crcBytes(DataFrame::FRAME_TYPE_VALIDATOR);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    client = startBytes + lengthBytes + dataBytes + crcBytes + stopBytes;
+    ASSERT_EQ(client.setLengthField(1, 2, SynapSock::LENGTH_ENCODING_UINT16_BE), 0);
+    ASSERT_EQ(client.setValidator(3, 1, 2, Checksum::CHECKSUM_CRC32C), 0);
+    for (int i = 0; i < 300; i++) payload.push_back((unsigned char) (i * 7));
+    client[2]->setSize(payload.size());
+    client[2]->setData(payload);
+    ASSERT_EQ(client.init(), 0);
+    /* the length and the checksum are computed on send */
+    ASSERT_EQ(client.sendFramedData(), 0);
+    ASSERT_EQ(client.receiveFramedData(), 0);
+    ASSERT_EQ(client.getBuffer(tmp), 314);
+    ASSERT_EQ(client[3]->getData(tmp), 4);
+    tmp.clear();
+    tmp.push_back(0x01);
+    tmp.push_back(0x2c);
+    tmp.insert(tmp.end(), payload.begin(), payload.end());
+    uint32_t crc = Checksum::compute(Checksum::CHECKSUM_CRC32C, tmp.data(), tmp.size());
+    ASSERT_EQ(client[3]->getData(tmp), 4);
+    ASSERT_EQ(tmp[0] | (tmp[1] << 8) | (tmp[2] << 16) | ((uint32_t) tmp[3] << 24), crc);
+}
+
+TEST_F(TCPFramedDataTest, ResyncTest_1) {
+    std::vector <unsigned char> tmp;
+    client.setPort(4431);
+    client.setTimeout(250);
+    client.setKeepAlive(25);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    cmdBytes.setPostExecuteFunction((const void *) &setupLengthByCommand, (void *) &client);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    client = startBytes + cmdBytes + dataBytes + stopBytes;
+    client.setResync(true);
+    ASSERT_EQ(client.getResync(), true);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.sendData("qw1234567890-=12346ab90-=xx1234790-=1234567890-=12345"), 0);
+    ASSERT_EQ(client.receiveFramedData(), 0);
+    ASSERT_EQ(client.getBuffer(tmp), 12);
+    ASSERT_EQ(memcmp(tmp.data(), "1234567890-=", 12), 0);
+    ASSERT_EQ(client.getSkippedBytes(), 2);
+    ASSERT_EQ(client.receiveFramedData(), 0);
+    ASSERT_EQ(client.getBuffer(tmp), 11);
+    ASSERT_EQ(memcmp(tmp.data(), "12346ab90-=", 11), 0);
+    ASSERT_EQ(client[2]->getData(tmp), 2);
+    ASSERT_EQ(memcmp(tmp.data(), "ab", 2), 0);
+    /* "xx" and the frame with an invalid command are skipped */
+    ASSERT_EQ(client.receiveFramedData(), 0);
+    ASSERT_EQ(client.getBuffer(tmp), 12);
+    ASSERT_EQ(memcmp(tmp.data(), "1234567890-=", 12), 0);
+    ASSERT_EQ(client.getSkippedBytes(), 13);
+    ASSERT_EQ(client.getInvalidFrames(), 1);
+    ASSERT_EQ(client.getRemainingDataSize(), 5);
+    ASSERT_EQ(client.sendData("67890-="), 0);
+    ASSERT_EQ(client.receiveFramedData(), 0);
+    ASSERT_EQ(client.getBuffer(tmp), 12);
+    ASSERT_EQ(memcmp(tmp.data(), "1234567890-=", 12), 0);
+    ASSERT_EQ(client.getRemainingDataSize(), 0);
+    ASSERT_EQ(client.getSkippedBytes(), 13);
+    /* the next frames are parsed in place, the other receive methods only see the data that has not been delivered */
+    ASSERT_EQ(client.sendData("1234567890-=1234567890-=xyz"), 0);
+    ASSERT_EQ(client.receiveFramedData(), 0);
+    ASSERT_EQ(client.getBuffer(tmp), 12);
+    ASSERT_EQ(client.getRemainingDataSize(), 15);
+    ASSERT_EQ(client.getReceiveUsage(), 15);
+    ASSERT_EQ(client.getRemainingBuffer(tmp), 15);
+    ASSERT_EQ(memcmp(tmp.data(), "1234567890-=xyz", 15), 0);
+    ASSERT_EQ(client.receiveFramedData(), 0);
+    ASSERT_EQ(client.getBuffer(tmp), 12);
+    ASSERT_EQ(client.receiveData(), 0);
+    ASSERT_EQ(client.getBuffer(tmp), 3);
+    ASSERT_EQ(memcmp(tmp.data(), "xyz", 3), 0);
+    ASSERT_EQ(client.getReceiveUsage(), 0);
+    client.resetResyncCounters();
+    ASSERT_EQ(client.getSkippedBytes(), 0);
+    ASSERT_EQ(client.getInvalidFrames(), 0);
+}
+
+void countExecution(DataFrame &, void *ptr){
+    int *counter = (int *) ptr;
+    (*counter)++;
+}
+
+TEST_F(TCPFramedDataTest, PollTest_1) {
+    std::vector <SynapSock::FRAME_VIEW_t> frames;
+    struct timeval tvStart, tvEnd;
+    long diffTime = 0;
+    int counter = 0;
+    int ret = 0;
+    client.setPort(4431);
+    client.setTimeout(250);
+    client.setKeepAlive(25);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    cmdBytes.setExecuteFunction((const void *) &countExecution, (void *) &counter);
+    cmdBytes.setPostExecuteFunction((const void *) &setupLengthByCommand, (void *) &client);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    client = startBytes + cmdBytes + dataBytes + stopBytes;
+    ASSERT_EQ(client.init(), 0);
+    /* every part leaves an incomplete frame, the garbage before the start bytes is dropped */
+    const char *parts[] = {"qw12", "34", "5", "678"};
+    size_t remainingSize[] = {3, 4, 5, 8};
+    for (size_t i = 0; i < 4; i++){
+        ASSERT_EQ(client.sendData(parts[i]), 0);
+        for (int j = 0; j < 100 && client.getRemainingDataSize() != remainingSize[i]; j++){
+            gettimeofday(&tvStart, NULL);
+            ASSERT_EQ(client.pollFramedData(frames), 2);
+            gettimeofday(&tvEnd, NULL);
+            diffTime = (tvEnd.tv_sec - tvStart.tv_sec) * 1000 + (tvEnd.tv_usec - tvStart.tv_usec) / 1000;
+            ASSERT_EQ(diffTime >= 0 && diffTime <= 20, true);
+            ASSERT_EQ(frames.size(), 0);
+            usleep(5000);
+        }
+        ASSERT_EQ(client.getRemainingDataSize(), remainingSize[i]);
+    }
+    ASSERT_EQ(counter, 1);
+    ASSERT_EQ(client.sendData("90-=12"), 0);
+    for (int j = 0; j < 100 && (ret = client.pollFramedData(frames)) == 2; j++) usleep(5000);
+    ASSERT_EQ(ret, 0);
+    ASSERT_EQ(frames.size(), 1);
+    ASSERT_EQ(frames[0].size, 12);
+    ASSERT_EQ(memcmp(frames[0].data, "1234567890-=", 12), 0);
+    ASSERT_EQ(client.getRemainingDataSize(), 2);
+    ASSERT_EQ(client.sendData("346ab90-="), 0);
+    for (int j = 0; j < 100 && (ret = client.pollFramedData(frames)) == 2; j++) usleep(5000);
+    ASSERT_EQ(ret, 0);
+    ASSERT_EQ(frames.size(), 1);
+    ASSERT_EQ(frames[0].size, 11);
+    ASSERT_EQ(memcmp(frames[0].data, "12346ab90-=", 11), 0);
+    ASSERT_EQ(client.getRemainingDataSize(), 0);
+    ASSERT_EQ(counter, 2);
+    ASSERT_EQ(client.pollFramedData(frames), 2);
+    ASSERT_EQ(frames.size(), 0);
+}
+
+void pipelineResponseHandler(TCPClient &, int status, const unsigned char *frame, size_t sz, void *param){
+    std::string *responses = (std::string *) param;
+    if (status != 0){
+        responses->push_back('!');
+    }
+    else if (sz > 4){
+        responses->push_back((char) frame[4]);
+    }
+}
+
+TEST_F(TCPFramedDataTest, PipelineTest_inOrder) {
+    std::string responses;
+    int tryTimes = 0;
+    client.setPort(4431);
+    client.setTimeout(250);
+    client.setKeepAlive(25);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA, 2);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    client = startBytes + cmdBytes + dataBytes + stopBytes;
+    /* a request that could not be written is not kept as pending */
+    ASSERT_EQ(client.sendRequest((const unsigned char *) "1234Axy90-=", 11, &pipelineResponseHandler, &responses), 1);
+    ASSERT_EQ(client.getPendingRequestsSize(), 0);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.sendRequest((const unsigned char *) "1234Axy90-=", 11, &pipelineResponseHandler, &responses), 0);
+    ASSERT_EQ(client.sendRequest((const unsigned char *) "1234Bxy90-=", 11, &pipelineResponseHandler, &responses), 0);
+    ASSERT_EQ(client.sendRequest((const unsigned char *) "1234Cxy90-=", 11, &pipelineResponseHandler, &responses), 0);
+    ASSERT_EQ(client.getPendingRequestsSize(), 3);
+    while (client.getPendingRequestsSize() > 0 && tryTimes < 10){
+        client.processResponses();
+        tryTimes++;
+    }
+    ASSERT_EQ(responses, "ABC");
+    ASSERT_EQ(client.sendRequest((const unsigned char *) "1234Dxy90-=", 11, &pipelineResponseHandler, &responses), 0);
+    client.cancelPendingRequests();
+    ASSERT_EQ(client.getPendingRequestsSize(), 0);
+    ASSERT_EQ(responses, "ABC!");
+}
+
+TEST_F(TCPFramedDataTest, PipelineTest_correlation) {
+    std::string responses;
+    int tryTimes = 0;
+    client.setPort(4431);
+    client.setTimeout(250);
+    client.setKeepAlive(25);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA, 2);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    client = startBytes + cmdBytes + dataBytes + stopBytes;
+    client.setPipelineCorrelation(4, 1);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.sendRequest((const unsigned char *) "1234", 4, &pipelineResponseHandler, &responses), 3);
+    ASSERT_EQ(client.sendRequest((const unsigned char *) "1234Axy90-=", 11, &pipelineResponseHandler, &responses), 0);
+    /* a response without a pending request is discarded */
+    ASSERT_EQ(client.sendData("1234Zxy90-="), 0);
+    client[DataFrame::FRAME_TYPE_COMMAND]->setData((const unsigned char *) "B", 1);
+    client[DataFrame::FRAME_TYPE_DATA]->setData((const unsigned char *) "xy", 2);
+    ASSERT_EQ(client.sendFramedRequest(&pipelineResponseHandler, &responses), 0);
+    ASSERT_EQ(client.getPendingRequestsSize(), 2);
+    while (client.getPendingRequestsSize() > 0 && tryTimes < 10){
+        client.processResponses();
+        tryTimes++;
+    }
+    ASSERT_EQ(responses, "AB");
+}
+
+TEST_F(TCPFramedDataTest, PipelineTest_peerClosed) {
+    std::string responses;
+    struct sockaddr_in addr;
+    int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    int connFd = -1;
+    int opt = 1;
+    int ret = 2;
+    ASSERT_GT(listenFd, 0);
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    memset(&addr, 0x00, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(4432);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    ASSERT_EQ(bind(listenFd, (struct sockaddr *) &addr, sizeof(addr)), 0);
+    ASSERT_EQ(listen(listenFd, 1), 0);
+    client.setPort(4432);
+    client.setTimeout(250);
+    client.setKeepAlive(25);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA, 2);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    client = startBytes + cmdBytes + dataBytes + stopBytes;
+    ASSERT_EQ(client.init(), 0);
+    connFd = accept(listenFd, nullptr, nullptr);
+    ASSERT_GT(connFd, 0);
+    ASSERT_EQ(client.sendRequest((const unsigned char *) "1234Axy90-=", 11, &pipelineResponseHandler, &responses), 0);
+    ASSERT_EQ(client.sendRequest((const unsigned char *) "1234Bxy90-=", 11, &pipelineResponseHandler, &responses), 0);
+    /* the peer answers the first request and closes the connection */
+    ASSERT_EQ(write(connFd, "1234Axy90-=", 11), 11);
+    close(connFd);
+    close(listenFd);
+    for (int i = 0; i < 10 && ret != 4; i++){
+        ret = client.processResponses();
+    }
+    ASSERT_EQ(ret, 4);
+    ASSERT_EQ(client.getPendingRequestsSize(), 0);
+    ASSERT_EQ(responses, "A!");
+}
+
+TEST_F(TCPFramedDataTest, HandlerTest_1) {
+    std::vector <SynapSock::FRAME_VIEW_t> frames;
+    int exeCounter = 0;
+    int postCounter = 0;
+    TCPClient &connection = client;
+    client.setPort(4431);
+    client.setTimeout(250);
+    client.setKeepAlive(25);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, "1234");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, "90-=");
+    client = startBytes + cmdBytes + dataBytes + stopBytes;
+    ASSERT_EQ(client.setExecuteHandler(4, [&exeCounter](DataFrame &){ exeCounter++; }), 1);
+    ASSERT_EQ(client.setExecuteHandler(0, [&exeCounter](DataFrame &){ exeCounter++; }), 0);
+    ASSERT_EQ(client.setPostExecuteHandler(1, [&connection, &postCounter](DataFrame &frame){
+        unsigned char cmd = 0;
+        postCounter++;
+        frame.getData(&cmd, 1);
+        if (cmd == 0x35) frame.getNext()->setSize(3);
+        else if (cmd == 0x36) frame.getNext()->setSize(2);
+        else connection.trigInvDataIndicator();
+    }), 0);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.sendData("qw1234567890-=12346ab90-=xx1234790-=1234567890-=12345"), 0);
+    ASSERT_EQ(client.receiveFramedDataBatch(frames), 0);
+    ASSERT_EQ(frames.size(), 3);
+    ASSERT_EQ(frames[0].size, 12);
+    ASSERT_EQ(memcmp(frames[0].data, "1234567890-=", 12), 0);
+    ASSERT_EQ(frames[1].size, 11);
+    ASSERT_EQ(memcmp(frames[1].data, "12346ab90-=", 11), 0);
+    ASSERT_EQ(frames[2].size, 12);
+    ASSERT_EQ(postCounter, 5);
+    ASSERT_EQ(exeCounter, 5);
+    /* an empty handler restores the function of the field */
+    ASSERT_EQ(client.setExecuteHandler(0, nullptr), 0);
+    ASSERT_EQ(client.sendData("67890-="), 0);
+    ASSERT_EQ(client.receiveFramedDataBatch(frames), 0);
+    ASSERT_EQ(frames.size(), 1);
+    ASSERT_EQ(memcmp(frames[0].data, "1234567890-=", 12), 0);
+    ASSERT_EQ(exeCounter, 5);
+    ASSERT_EQ(postCounter, 5);
+}
+
+typedef FrameDsl::Frame <FrameDsl::StartBytes <'1', '2', '3', '4'>,
+                         FrameDsl::Length <SynapSock::LENGTH_ENCODING_UINT8>,
+                         FrameDsl::Data <FrameDsl::LenFrom <1>>,
+                         FrameDsl::StopBytes <'9', '0', '-', '='>> PacketFormat;
+
+TEST_F(TCPFramedDataTest, CompiledFormatTest_1) {
+    std::vector <SynapSock::FRAME_VIEW_t> frames;
+    std::vector <unsigned char> packet;
+    SynapSock::FRAME_VIEW_t fields[PacketFormat::FIELD_COUNT];
+    size_t begin = 0;
+    size_t size = 0;
+    client.setPort(4431);
+    client.setTimeout(250);
+    client.setKeepAlive(25);
+    ASSERT_EQ(client.init(), 0);
+    fields[2] = {(const unsigned char *) "abc", 3};
+    ASSERT_EQ(PacketFormat::encode(packet, fields), 0);
+    ASSERT_EQ(client.sendData(std::string("qw") + std::string(packet.begin(), packet.end()) + "1234"), 0);
+    ASSERT_EQ(client.receiveFramedDataBatch(frames, &PacketFormat::parse), 0);
+    ASSERT_EQ(frames.size(), 1);
+    ASSERT_EQ(frames[0].size, 12);
+    ASSERT_EQ(memcmp(frames[0].data, "1234\x03" "abc90-=", 12), 0);
+    ASSERT_EQ(client.getSkippedBytes(), 2);
+    ASSERT_EQ(client.getRemainingDataSize(), 4);
+    ASSERT_EQ(client.sendData("\x02xy90-="), 0);
+    ASSERT_EQ(client.receiveFramedDataBatch(frames, &PacketFormat::parse), 0);
+    ASSERT_EQ(frames.size(), 1);
+    ASSERT_EQ(frames[0].size, 11);
+    ASSERT_EQ(PacketFormat::parse(frames[0].data, frames[0].size, &begin, &size, fields), 0);
+    ASSERT_EQ(size, 11);
+    ASSERT_EQ(fields[2].size, 2);
+    ASSERT_EQ(memcmp(fields[2].data, "xy", 2), 0);
+    ASSERT_EQ(client.getRemainingDataSize(), 0);
+    ASSERT_EQ(client.receiveFramedDataBatch(frames, nullptr), 3);
+}
+
+TEST_F(TCPFramedDataTest, FieldViewTest_1) {
+    std::vector <unsigned char> tmp;
+    FieldView view;
+    client.setPort(4431);
+    client.setTimeout(250);
+    client.setKeepAlive(25);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, 1, (const unsigned char *) "\x02");
+    DataFrame lengthBytes(DataFrame::FRAME_TYPE_CONTENT_LENGTH);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, 1, (const unsigned char *) "\x03");
+    client = startBytes + lengthBytes + dataBytes + stopBytes;
+    ASSERT_EQ(client.setLengthField(1, 2, SynapSock::LENGTH_ENCODING_UINT16_LE), 0);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.getFieldView(2).isEmpty(), true);
+    ASSERT_EQ(client.sendData((const unsigned char *) "\x02\x06\x00\x12\x34\x78\x56\x34\x12\x03", 10), 0);
+    ASSERT_EQ(client.receiveFramedData(), 0);
+    ASSERT_EQ(client.getBuffer(tmp), 10);
+    /* the views point into the receive buffer */
+    view = client.getFieldView(2);
+    ASSERT_EQ(view.getSize(), 6);
+    ASSERT_EQ(view.u16be(0), 0x1234);
+    ASSERT_EQ(view.u32le(2), 0x12345678);
+    ASSERT_EQ(view.u32le(3), 0);
+    ASSERT_EQ(client.getFieldView(DataFrame::FRAME_TYPE_CONTENT_LENGTH).u16le(0), 6);
+    ASSERT_EQ(client.getFieldView(DataFrame::FRAME_TYPE_STOP_BYTES).u8(0), 0x03);
+    ASSERT_EQ(client.getFieldView(4).isEmpty(), true);
+    view = client.getSpecificBufferView(DataFrame::FRAME_TYPE_CONTENT_LENGTH, DataFrame::FRAME_TYPE_DATA);
+    ASSERT_EQ(view.getSize(), 8);
+    ASSERT_EQ(memcmp(view.getData(), tmp.data() + 1, 8), 0);
+    ASSERT_EQ(client.getSpecificBufferView(DataFrame::FRAME_TYPE_DATA, DataFrame::FRAME_TYPE_START_BYTES).isEmpty(), true);
+    /* in resync mode the views refer to the frame that is kept in the receive buffer */
+    client.setResync(true);
+    ASSERT_EQ(client.sendData((const unsigned char *) "xy\x02\x02\x00\xbe\xef\x03", 8), 0);
+    ASSERT_EQ(client.receiveFramedData(), 0);
+    ASSERT_EQ(client.getSkippedBytes(), 2);
+    ASSERT_EQ(client.getFieldView(2).u16be(0), 0xbeef);
+    ASSERT_EQ(client.getFieldView(2).u16le(0), 0xefbe);
+    ASSERT_EQ(client.getFieldView(3).u8(0), 0x03);
+}
+
+TEST_F(TCPFramedDataTest, SharedFormatTest_1) {
+    std::vector <unsigned char> tmp;
+    TCPClient owner;
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, 1, (const unsigned char *) "\x02");
+    DataFrame lengthBytes(DataFrame::FRAME_TYPE_CONTENT_LENGTH);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, 1, (const unsigned char *) "\x03");
+    ASSERT_EQ(owner.shareFormat(), nullptr);
+    ASSERT_EQ(client.setFormat(nullptr), 1);
+    owner = startBytes + lengthBytes + dataBytes + stopBytes;
+    ASSERT_EQ(owner.setLengthField(1, 2, SynapSock::LENGTH_ENCODING_UINT16_BE), 0);
+    SynapSock::SHARED_FORMAT_t format = owner.shareFormat();
+    ASSERT_NE(format, nullptr);
+    ASSERT_EQ(owner.shareFormat(), format);
+    ASSERT_EQ(owner.isFormatShared(), false);
+    /* the client uses the fields of the snapshot, they are not copied */
+    ASSERT_EQ(client.setFormat(format), 0);
+    ASSERT_EQ(client.isFormatShared(), true);
+    ASSERT_NE(client.getFormat(), owner.getFormat());
+    ASSERT_EQ(format.use_count(), 3);
+    DataFrame *sharedFields = client.getFormat();
+    client.setPort(4431);
+    client.setTimeout(250);
+    client.setKeepAlive(25);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.sendData((const unsigned char *) "x\x02\x00\x02\xab\xcd\x03\x02\x00\x01" "a\x03", 13), 0);
+    ASSERT_EQ(client.receiveFramedData(), 0);
+    ASSERT_EQ(client.getBuffer(tmp), 6);
+    ASSERT_EQ(client.getSkippedBytes(), 1);
+    ASSERT_EQ(client.getFieldView(2).u16be(0), 0xabcd);
+    /* the shared fields are only read */
+    ASSERT_EQ(owner[2]->getData(tmp), 0);
+    ASSERT_EQ(client.receiveFramedData(), 0);
+    ASSERT_EQ(client.getFieldView(2).toStringView(), "a");
+    /* a change of the frame format gives the client its own copy, with the declared length field */
+    ASSERT_EQ(client.setExecuteHandler(2, nullptr), 0);
+    ASSERT_EQ(client.isFormatShared(), false);
+    ASSERT_NE(client.getFormat(), sharedFields);
+    ASSERT_EQ(format.use_count(), 2);
+    ASSERT_EQ(client.sendData((const unsigned char *) "\x02\x00\x03xyz\x03", 7), 0);
+    ASSERT_EQ(client.receiveFramedData(), 0);
+    ASSERT_EQ(client[2]->getData(tmp), 3);
+    ASSERT_EQ(memcmp(tmp.data(), "xyz", 3), 0);
+    ASSERT_EQ(owner[2]->getData(tmp), 0);
+    /* a frame format with a handler is copied, so the handler is called for the connection */
+    int exeCounter = 0;
+    ASSERT_EQ(owner.setExecuteHandler(2, [&exeCounter](DataFrame &){ exeCounter++; }), 0);
+    format = owner.shareFormat();
+    ASSERT_NE(format, nullptr);
+    ASSERT_EQ(client.setFormat(format), 0);
+    ASSERT_EQ(client.isFormatShared(), false);
+    ASSERT_EQ(format.use_count(), 2);
+    ASSERT_EQ(client.sendData((const unsigned char *) "\x02\x00\x02pq\x03", 6), 0);
+    ASSERT_EQ(client.receiveFramedData(), 0);
+    ASSERT_EQ(exeCounter, 1);
+    ASSERT_EQ(client[2]->getData(tmp), 2);
+}
+
+typedef struct _ENCODER_PARAM_t {
+    TCPClient *client;
+    int id;
+    int count;
+} ENCODER_PARAM_t;
+
+void *encoderThread(void *param){
+    ENCODER_PARAM_t *encoder = (ENCODER_PARAM_t *) param;
+    unsigned char cmd = (unsigned char) ('A' + encoder->id);
+    FieldView fields[6];
+    fields[1] = FieldView(&cmd, 1);
+    fields[3] = FieldView((const unsigned char *) "payload", 7);
+    for (int i = 0; i < 25; i++){
+        if (encoder->client->sendFramedData(fields, 6) == 0) encoder->count++;
+    }
+    return nullptr;
+}
+
+TEST_F(TCPFramedDataTest, EncoderTest_1) {
+    std::vector <SynapSock::FRAME_VIEW_t> frames;
+    std::vector <unsigned char> buffer;
+    std::vector <unsigned char> tmp;
+    FieldView fields[6];
+    FieldView delimitedFields[3];
+    TCPClient delimited;
+    pthread_t threads[4];
+    ENCODER_PARAM_t params[4];
+    int counter[4] = {0, 0, 0, 0};
+    size_t total = 0;
+    client.setPort(4431);
+    client.setTimeout(250);
+    client.setKeepAlive(25);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, 1, (const unsigned char *) "\x02");
+    DataFrame cmdBytes(DataFrame::FRAME_TYPE_COMMAND, 1);
+    DataFrame lengthBytes(DataFrame::FRAME_TYPE_CONTENT_LENGTH);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame xorBytes(DataFrame::FRAME_TYPE_VALIDATOR);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, 1, (const unsigned char *) "\x03");
+    client = startBytes + cmdBytes + lengthBytes + dataBytes + xorBytes + stopBytes;
+    ASSERT_EQ(client.setLengthField(2, 3, SynapSock::LENGTH_ENCODING_UINT8), 0);
+    ASSERT_EQ(client.setValidator(4, 1, 3, Checksum::CHECKSUM_XOR8), 0);
+    fields[1] = FieldView((const unsigned char *) "A", 1);
+    fields[3] = FieldView((const unsigned char *) "xy", 2);
+    ASSERT_EQ(client.encodeFramedData(fields, 5, buffer), 1);
+    ASSERT_EQ(client.encodeFramedData(fields, 6, buffer), 0);
+    ASSERT_EQ(buffer, (std::vector <unsigned char>{0x02, 0x41, 0x02, 0x78, 0x79, 0x42, 0x03}));
+    /* the fields of the frame format are not written */
+    ASSERT_EQ(client[3]->getData(tmp), 0);
+    ASSERT_EQ(client.sendFramedData(fields, 6), 1);
+    /* the size of the data does not fit in the length field */
+    std::vector <unsigned char> payload(300, 'a');
+    fields[3] = FieldView(payload.data(), payload.size());
+    ASSERT_EQ(client.encodeFramedData(fields, 6, buffer), 1);
+    ASSERT_EQ(client.sendFramedData(fields, 6), 3);
+    fields[3] = FieldView(payload.data(), 255);
+    ASSERT_EQ(client.encodeFramedData(fields, 6, buffer), 0);
+    ASSERT_EQ(buffer.size(), 260);
+    ASSERT_EQ(buffer[2], 0xff);
+    /* the value of a fixed size field must have the size of the field */
+    fields[1] = FieldView((const unsigned char *) "AB", 2);
+    ASSERT_EQ(client.encodeFramedData(fields, 6, buffer), 1);
+    ASSERT_EQ(client.sendFramedData(fields, 6), 3);
+    fields[1] = FieldView((const unsigned char *) "", 0);
+    ASSERT_EQ(client.encodeFramedData(fields, 6, buffer), 1);
+    fields[1] = FieldView((const unsigned char *) "A", 1);
+    /* the value of a delimited field must not contain its stop bytes */
+    DataFrame delimitedStart(DataFrame::FRAME_TYPE_START_BYTES, 1, (const unsigned char *) "\x02");
+    DataFrame delimitedData(DataFrame::FRAME_TYPE_DATA);
+    DataFrame delimitedStop(DataFrame::FRAME_TYPE_STOP_BYTES, 1, (const unsigned char *) "\x03");
+    delimited = delimitedStart + delimitedData + delimitedStop;
+    delimitedFields[1] = FieldView((const unsigned char *) "x\x03y", 3);
+    ASSERT_EQ(delimited.encodeFramedData(delimitedFields, 3, buffer), 1);
+    delimitedFields[1] = FieldView((const unsigned char *) "xy", 2);
+    ASSERT_EQ(delimited.encodeFramedData(delimitedFields, 3, buffer), 0);
+    ASSERT_EQ(buffer, (std::vector <unsigned char>{0x02, 0x78, 0x79, 0x03}));
+    ASSERT_EQ(client.init(), 0);
+    for (int i = 0; i < 4; i++){
+        params[i] = {&client, i, 0};
+        pthread_create(&threads[i], nullptr, &encoderThread, (void *) &params[i]);
+    }
+    for (int i = 0; i < 4; i++){
+        pthread_join(threads[i], nullptr);
+        ASSERT_EQ(params[i].count, 25);
+    }
+    /* every frame is written at once, so the frames of the threads are not interleaved */
+    while (total < 100 && client.receiveFramedDataBatch(frames) == 0){
+        for (size_t i = 0; i < frames.size(); i++){
+            ASSERT_EQ(frames[i].size, 12);
+            ASSERT_EQ(memcmp(frames[i].data + 3, "payload", 7), 0);
+            counter[frames[i].data[1] - 'A']++;
+        }
+        total += frames.size();
+    }
+    ASSERT_EQ(total, 100);
+    ASSERT_EQ(client.getInvalidFrames(), 0);
+    for (int i = 0; i < 4; i++){
+        ASSERT_EQ(counter[i], 25);
+    }
+}
+
+TEST_F(TCPFramedDataTest, FrameTemplateTest_1) {
+    std::vector <SynapSock::FRAME_VIEW_t> frames;
+    std::vector <unsigned char> buffer;
+    SynapSock::FrameTemplate reply;
+    FieldView fields[6];
+    FieldView frame;
+    client.setPort(4431);
+    client.setTimeout(250);
+    client.setKeepAlive(25);
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, 1, (const unsigned char *) "\x02");
+    DataFrame seqBytes(DataFrame::FRAME_TYPE_COMMAND, 2);
+    DataFrame lengthBytes(DataFrame::FRAME_TYPE_CONTENT_LENGTH);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame crcBytes(DataFrame::FRAME_TYPE_VALIDATOR);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, 1, (const unsigned char *) "\x03");
+    client = startBytes + seqBytes + lengthBytes + dataBytes + crcBytes + stopBytes;
+    ASSERT_EQ(client.setLengthField(2, 3, SynapSock::LENGTH_ENCODING_UINT8), 0);
+    ASSERT_EQ(client.setValidator(4, 1, 3, Checksum::CHECKSUM_CRC16_XMODEM), 0);
+    ASSERT_EQ(reply.getFrame().isEmpty(), true);
+    ASSERT_EQ(client.createFrameTemplate(reply, fields, 5), 1);
+    fields[1] = FieldView((const unsigned char *) "\x00\x01", 2);
+    fields[3] = FieldView((const unsigned char *) "hello", 5);
+    ASSERT_EQ(client.createFrameTemplate(reply, fields, 6), 0);
+    ASSERT_EQ(reply.setPatchPoint("seq", 1), 0);
+    ASSERT_EQ(reply.setPatchPoint("payload", 3), 0);
+    ASSERT_EQ(reply.setPatchPoint("crc", 4), 1);
+    ASSERT_EQ(reply.setPatchPoint("length", 2), 1);
+    ASSERT_EQ(reply.getPatchPoint("payload"), 3);
+    ASSERT_EQ(reply.getPatchPoint("crc"), -1);
+    ASSERT_EQ(reply.patch("crc", fields[4]), 1);
+    ASSERT_EQ(client.encodeFramedData(fields, 6, buffer), 0);
+    frame = reply.getFrame();
+    ASSERT_EQ(std::vector <unsigned char>(frame.getData(), frame.getData() + frame.getSize()), buffer);
+    /* same size: patched in place, a larger payload moves the next fields and updates the length */
+    ASSERT_EQ(reply.patch("seq", FieldView((const unsigned char *) "\x00\x02", 2)), 0);
+    ASSERT_EQ(reply.patch("payload", FieldView((const unsigned char *) "hello world", 11)), 0);
+    fields[1] = FieldView((const unsigned char *) "\x00\x02", 2);
+    fields[3] = FieldView((const unsigned char *) "hello world", 11);
+    ASSERT_EQ(client.encodeFramedData(fields, 6, buffer), 0);
+    frame = reply.getFrame();
+    ASSERT_EQ(std::vector <unsigned char>(frame.getData(), frame.getData() + frame.getSize()), buffer);
+    ASSERT_EQ(reply.getField(2).u8(0), 11);
+    ASSERT_EQ(reply.getField(3).toStringView(), "hello world");
+    /* a payload that does not fit in the length field leaves the template unchanged */
+    std::vector <unsigned char> payload(300, 'a');
+    ASSERT_EQ(reply.patch("payload", FieldView(payload.data(), payload.size())), 1);
+    frame = reply.getFrame();
+    ASSERT_EQ(std::vector <unsigned char>(frame.getData(), frame.getData() + frame.getSize()), buffer);
+    ASSERT_EQ(client.sendFramedData(reply), 1);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.sendFramedData(reply), 0);
+    ASSERT_EQ(reply.patch(1, FieldView((const unsigned char *) "\x00\x03", 2)), 0);
+    ASSERT_EQ(reply.patch(3, FieldView((const unsigned char *) "ok", 2)), 0);
+    ASSERT_EQ(client.sendFramedData(reply), 0);
+    ASSERT_EQ(client.receiveFramedDataBatch(frames), 0);
+    if (frames.size() < 2) ASSERT_EQ(client.receiveFramedDataBatch(frames), 0);
+    ASSERT_EQ(frames.back().size, 9);
+    ASSERT_EQ(memcmp(frames.back().data, "\x02\x00\x03\x02" "ok", 6), 0);
+    ASSERT_EQ(client.getInvalidFrames(), 0);
+}
+
+TEST_F(TCPFramedDataTest, FrameTemplateTest_partialValidator) {
+    std::vector <unsigned char> buffer;
+    SynapSock::FrameTemplate reply;
+    FieldView fields[6];
+    FieldView frame;
+    DataFrame startBytes(DataFrame::FRAME_TYPE_START_BYTES, 1, (const unsigned char *) "\x02");
+    DataFrame seqBytes(DataFrame::FRAME_TYPE_COMMAND, 2);
+    DataFrame lengthBytes(DataFrame::FRAME_TYPE_CONTENT_LENGTH);
+    DataFrame dataBytes(DataFrame::FRAME_TYPE_DATA);
+    DataFrame crcBytes(DataFrame::FRAME_TYPE_VALIDATOR);
+    DataFrame stopBytes(DataFrame::FRAME_TYPE_STOP_BYTES, 1, (const unsigned char *) "\x03");
+    client = startBytes + seqBytes + lengthBytes + dataBytes + crcBytes + stopBytes;
+    ASSERT_EQ(client.setLengthField(2, 3, SynapSock::LENGTH_ENCODING_UINT8), 0);
+    /* the checksum covers the length and the payload, not the sequence number */
+    ASSERT_EQ(client.setValidator(4, 2, 3, Checksum::CHECKSUM_CRC16_XMODEM), 0);
+    fields[1] = FieldView((const unsigned char *) "\x00\x01", 2);
+    fields[3] = FieldView((const unsigned char *) "hello", 5);
+    ASSERT_EQ(client.createFrameTemplate(reply, fields, 6), 0);
+    ASSERT_EQ(reply.patch(1, FieldView((const unsigned char *) "\x00\x02", 2)), 0);
+    fields[1] = FieldView((const unsigned char *) "\x00\x02", 2);
+    ASSERT_EQ(client.encodeFramedData(fields, 6, buffer), 0);
+    frame = reply.getFrame();
+    ASSERT_EQ(std::vector <unsigned char>(frame.getData(), frame.getData() + frame.getSize()), buffer);
+    ASSERT_EQ(reply.patch(3, FieldView((const unsigned char *) "hello world", 11)), 0);
+    fields[3] = FieldView((const unsigned char *) "hello world", 11);
+    ASSERT_EQ(client.encodeFramedData(fields, 6, buffer), 0);
+    frame = reply.getFrame();
+    ASSERT_EQ(std::vector <unsigned char>(frame.getData(), frame.getData() + frame.getSize()), buffer);
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <functional>
+#include <iostream>
+#include "inplace-function.hpp"
+
+static int destroyCount = 0;
+
+static int addOne(int value){
+    return value + 1;
+}
+
+class CountedFunctor {
+  public:
+    int base;
+    CountedFunctor(int base) : base(base) {}
+    CountedFunctor(const CountedFunctor &obj) : base(obj.base) {}
+    ~CountedFunctor(){
+        destroyCount++;
+    }
+    int operator()(int value) const {
+        return this->base + value;
+    }
+};
+
+class InplaceFunctionTest:public::testing::Test {
+protected:
+    void SetUp() override {
+        destroyCount = 0;
+    }
+};
+
+TEST_F(InplaceFunctionTest, Empty_1) {
+    InplaceFunction <int(int)> func;
+    InplaceFunction <int(int)> nullFunc(nullptr);
+    int (*nullPointer)(int) = nullptr;
+    InplaceFunction <int(int)> nullPointerFunc(nullPointer);
+    ASSERT_EQ(static_cast<bool>(func), false);
+    ASSERT_EQ(static_cast<bool>(nullFunc), false);
+    ASSERT_EQ(static_cast<bool>(nullPointerFunc), false);
+    func = &addOne;
+    ASSERT_EQ(static_cast<bool>(func), true);
+    ASSERT_EQ(func(1), 2);
+    func = nullptr;
+    ASSERT_EQ(static_cast<bool>(func), false);
+}
+
+TEST_F(InplaceFunctionTest, Callable_1) {
+    int counter = 0;
+    std::function <int(int)> stdFunc = [](int value){ return value * 2; };
+    InplaceFunction <int(int)> lambda = [&counter](int value){ counter += value; return counter; };
+    InplaceFunction <int(int)> wrapped = stdFunc;
+    InplaceFunction <long(int)> functor = CountedFunctor(10);
+    ASSERT_EQ(lambda(3), 3);
+    ASSERT_EQ(lambda(4), 7);
+    ASSERT_EQ(counter, 7);
+    ASSERT_EQ(wrapped(21), 42);
+    ASSERT_EQ(functor(5), 15);
+}
+
+TEST_F(InplaceFunctionTest, CopyAndDestroy_1) {
+    {
+        InplaceFunction <int(int)> func = CountedFunctor(1);
+        destroyCount = 0;
+        InplaceFunction <int(int)> copy = func;
+        ASSERT_EQ(copy(1), 2);
+        copy = &addOne;
+        ASSERT_EQ(destroyCount, 1);
+        ASSERT_EQ(copy(1), 2);
+        copy = func;
+        ASSERT_EQ(copy(2), 3);
+    }
+    ASSERT_EQ(destroyCount, 3);
+}
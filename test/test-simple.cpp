@@ -4,6 +4,7 @@
 #include <iostream>
 #include <unistd.h>
 #include <pthread.h>
+#include <atomic>
 #include "tcp-client.hpp"
 #include "tcp-server.hpp"
 
@@ -90,6 +91,8 @@ protected:
     void TearDown() override {
         isRun = false;
         pthread_join(th, nullptr);
+        /* the global receive budget is shared by every connection, a failed test must not leave it set */
+        Socket::setGlobalReceiveBudget(0);
         std::cout << "Echo Server Thread Stoped" << std::endl;
     }
 };
@@ -505,6 +508,28 @@ TEST_F(TCPSimpleTest, communicationTest_1) {
     ASSERT_EQ(tmp.size(), 0);
 }
 
+TEST_F(TCPSimpleTest, communicationTest_callableHandler) {
+    std::vector <unsigned char> tmp;
+    std::atomic <int> receptions(0);
+    std::string prefix = "echo:";
+    server.setReceptionHandler([prefix, &receptions](SynapSock &connection){
+        if (connection.receiveData() == 0){
+            receptions++;
+            connection.sendData(prefix + std::string((const char *) connection.getBufferAsVector().data(), connection.getDataSize()));
+        }
+    });
+    ASSERT_EQ(server.getReceptionHandlerFunction(), nullptr);
+    ASSERT_EQ(static_cast<bool>(server.getReceptionHandler()), true);
+    ASSERT_EQ(client.setPort(4431), true);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.sendData(TEST_STR_1), 0);
+    ASSERT_EQ(client.receiveData(18), 0);
+    client.closeSocket();
+    ASSERT_EQ(client.getBuffer(tmp), 18);
+    ASSERT_EQ(memcmp(tmp.data(), (const unsigned char *) "echo:TCP::EchoTest", 18), 0);
+    ASSERT_EQ(receptions.load(), 1);
+}
+
 TEST_F(TCPSimpleTest, communicationTest_2) {
     unsigned char buffer[8];
     std::vector <unsigned char> tmp;
@@ -907,6 +932,22 @@ TEST_F(TCPSimpleTest, communicationTest_rcvUntillStopBytes_ov3) {
     ASSERT_EQ(memcmp(tmp.data(), (const unsigned char *) (TEST_STR_3 + 385), 77), 0);
 }
 
+TEST_F(TCPSimpleTest, communicationTest_rcvUntillStopBytes_resume) {
+    std::vector <unsigned char> tmp;
+    ASSERT_EQ(client.setPort(4431), true);
+    ASSERT_EQ(client.setTimeout(50), true);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.sendData("abc"), 0);
+    /* on timeout the buffer holds the data received so far, which also stays pending for the next call */
+    ASSERT_EQ(client.receiveUntillStopBytes("\r\n"), 2);
+    ASSERT_EQ(client.getBuffer(tmp), 3);
+    ASSERT_EQ(memcmp(tmp.data(), "abc", 3), 0);
+    ASSERT_EQ(client.sendData("de\r\nf"), 0);
+    ASSERT_EQ(client.receiveUntillStopBytes("\r\n"), 0);
+    ASSERT_EQ(client.getBuffer(tmp), 7);
+    ASSERT_EQ(memcmp(tmp.data(), "abcde\r\n", 7), 0);
+}
+
 TEST_F(TCPSimpleTest, communicationTest_rcvStopBytes) {
     unsigned char buffer[16];
     pthread_t thread;
@@ -1175,4 +1216,338 @@ TEST_F(TCPSimpleTest, negativeCommunicationTest_rcvStopBytes) {
     tmp.clear();
     tmp = client.getRemainingBufferAsVector();
     ASSERT_EQ(tmp.size(), 0);
-}
\ No newline at end of file
+}
+TEST_F(TCPSimpleTest, communicationTest_rcvLines) {
+    std::vector <std::string_view> lines;
+    const char *part1 = "line-1\r\nline-2\n\nline-4\npart";
+    const char *part2 = "ial line\r\n";
+    ASSERT_EQ(client.setPort(4431), true);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.sendData((const unsigned char *) part1, strlen(part1)), 0);
+    ASSERT_EQ(client.receiveLines(lines), 0);
+    ASSERT_EQ(lines.size(), 4);
+    ASSERT_EQ(lines[0], "line-1");
+    ASSERT_EQ(lines[1], "line-2");
+    ASSERT_EQ(lines[2], "");
+    ASSERT_EQ(lines[3], "line-4");
+    ASSERT_EQ(client.getRemainingDataSize(), 4);
+    ASSERT_EQ(client.getReceiveUsage(), strlen(part1));
+    ASSERT_EQ(client.sendData((const unsigned char *) part2, strlen(part2)), 0);
+    ASSERT_EQ(client.receiveLines(lines), 0);
+    ASSERT_EQ(lines.size(), 1);
+    ASSERT_EQ(lines[0], "partial line");
+    ASSERT_EQ(client.getRemainingDataSize(), 0);
+    ASSERT_EQ(client.getReceiveUsage(), strlen("partial line\r\n"));
+}
+
+TEST_F(TCPSimpleTest, negativeCommunicationTest_rcvLines_maxLength) {
+    std::vector <std::string_view> lines;
+    const char *part1 = "0123456789abcdef\nshort\r\n0123456789";
+    const char *part2 = "abcdef\nend\n";
+    ASSERT_EQ(client.setPort(4431), true);
+    ASSERT_EQ(client.setLineMaxLength(8), true);
+    ASSERT_EQ(client.getLineMaxLength(), 8);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.sendData((const unsigned char *) part1, strlen(part1)), 0);
+    ASSERT_EQ(client.receiveLines(lines), 3);
+    ASSERT_EQ(lines.size(), 1);
+    ASSERT_EQ(lines[0], "short");
+    ASSERT_EQ(client.sendData((const unsigned char *) part2, strlen(part2)), 0);
+    ASSERT_EQ(client.receiveLines(lines), 0);
+    ASSERT_EQ(lines.size(), 1);
+    ASSERT_EQ(lines[0], "end");
+}
+
+TEST_F(TCPSimpleTest, communicationTest_receiveBufferLimit) {
+    std::vector <unsigned char> tmp;
+    ASSERT_EQ(client.setPort(4431), true);
+    ASSERT_EQ(client.setKeepAlive(50), true);
+    ASSERT_EQ(client.setReceiveBufferLimit(8), true);
+    ASSERT_EQ(client.getReceiveBufferLimit(), 8);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.sendData((const unsigned char *) TEST_STR_2, 16), 0);
+    ASSERT_EQ(client.receiveData(), 0);
+    ASSERT_EQ(client.getBuffer(tmp), 8);
+    ASSERT_EQ(memcmp(tmp.data(), TEST_STR_2, 8), 0);
+    ASSERT_EQ(client.receiveData(), 0);
+    ASSERT_EQ(client.getBuffer(tmp), 8);
+    ASSERT_EQ(memcmp(tmp.data(), TEST_STR_2 + 8, 8), 0);
+}
+
+TEST_F(TCPSimpleTest, negativeCommunicationTest_maxFrameSize) {
+    std::vector <unsigned char> tmp;
+    ASSERT_EQ(client.setPort(4431), true);
+    ASSERT_EQ(client.setKeepAlive(50), true);
+    ASSERT_EQ(client.setMaxFrameSize(8), true);
+    ASSERT_EQ(client.getMaxFrameSize(), 8);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.sendData((const unsigned char *) TEST_STR_2, 16), 0);
+    ASSERT_EQ(client.receiveUntillStopBytes("7890"), 3);
+    ASSERT_EQ(client.getDataSize(), 0);
+    ASSERT_EQ(client.getReceiveUsage(), 0);
+}
+
+TEST_F(TCPSimpleTest, communicationTest_globalReceiveBudget) {
+    std::vector <unsigned char> tmp;
+    ASSERT_EQ(client.setPort(4431), true);
+    ASSERT_EQ(client.setKeepAlive(50), true);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(Socket::setGlobalReceiveBudget(12), true);
+    ASSERT_EQ(Socket::getGlobalReceiveBudget(), 12);
+    ASSERT_EQ(client.sendData((const unsigned char *) TEST_STR_2, 16), 0);
+    ASSERT_EQ(client.receiveData(4), 0);
+    ASSERT_EQ(client.getBuffer(tmp), 4);
+    ASSERT_EQ(client.getReceiveUsage(), 8);
+    ASSERT_EQ(Socket::getGlobalReceiveUsage(), 8);
+    ASSERT_EQ(client.receiveUntillStopBytes("1234"), 0);
+    ASSERT_EQ(client.getBuffer(tmp), 6);
+    ASSERT_EQ(memcmp(tmp.data(), TEST_STR_2 + 4, 6), 0);
+    ASSERT_EQ(client.getReceiveUsage(), 2);
+    ASSERT_EQ(Socket::getGlobalReceiveUsage(), 2);
+    ASSERT_EQ(Socket::setGlobalReceiveBudget(0), true);
+}
+
+TEST_F(TCPSimpleTest, communicationTest_rcvNBytes_directBuffer) {
+    unsigned char buffer[512];
+    ASSERT_EQ(client.setPort(4431), true);
+    ASSERT_EQ(client.setTimeout(250), true);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.sendData((const unsigned char *) TEST_STR_3, 462), 0);
+    ASSERT_EQ(client.receiveNBytes(buffer, 385), 0);
+    ASSERT_EQ(memcmp(buffer, (const unsigned char *) TEST_STR_3, 385), 0);
+    ASSERT_EQ(client.getRemainingDataSize(), 0);
+    ASSERT_EQ(client.receiveNBytes(buffer, 77), 0);
+    ASSERT_EQ(memcmp(buffer, (const unsigned char *) (TEST_STR_3 + 385), 77), 0);
+    ASSERT_EQ(client.receiveNBytes(buffer, 4), 2);
+    ASSERT_EQ(client.getDataSize(), 0);
+}
+
+TEST_F(TCPSimpleTest, communicationTest_nonBlockingSend_outputQueue) {
+    std::vector <unsigned char> payload(8 * 1024 * 1024, 0x5a);
+    size_t received = 0;
+    int tryTimes = 0;
+    ASSERT_EQ(client.setPort(4431), true);
+    ASSERT_EQ(client.setTimeout(250), true);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.setNonBlockingSend(true), true);
+    ASSERT_EQ(client.sendData(payload.data(), payload.size()), 0);
+    ASSERT_GT(client.getOutputQueueSize(), 0);
+    ASSERT_LT(client.getOutputQueueSize(), payload.size());
+    while (received < payload.size() && tryTimes < 1000){
+        client.flushOutputQueue();
+        if (client.receiveData() == 0){
+            received += client.getDataSize();
+            tryTimes = 0;
+        }
+        else {
+            tryTimes++;
+        }
+    }
+    ASSERT_EQ(client.getOutputQueueSize(), 0);
+    ASSERT_EQ(client.flushOutputQueue(), 0);
+    ASSERT_EQ(received, payload.size());
+}
+
+TEST_F(TCPSimpleTest, communicationTest_sendData_iovec) {
+    std::string expected = std::string(TEST_STR_1) + TEST_STR_2 + TEST_STR_4;
+    struct iovec iov[4];
+    iov[0].iov_base = (void *) TEST_STR_1;
+    iov[0].iov_len = strlen(TEST_STR_1);
+    iov[1].iov_base = nullptr;
+    iov[1].iov_len = 0;
+    iov[2].iov_base = (void *) TEST_STR_2;
+    iov[2].iov_len = strlen(TEST_STR_2);
+    iov[3].iov_base = (void *) TEST_STR_4;
+    iov[3].iov_len = strlen(TEST_STR_4);
+    ASSERT_EQ(client.setPort(4431), true);
+    ASSERT_EQ(client.setTimeout(250), true);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.sendData(iov, 4), 0);
+    ASSERT_EQ(client.receiveNBytes(expected.length()), 0);
+    ASSERT_EQ(client.getBufferAsVector(), std::vector <unsigned char>(expected.begin(), expected.end()));
+}
+
+TEST_F(TCPSimpleTest, communicationTest_cork_flush) {
+    int value = 0;
+    socklen_t len = sizeof(value);
+    ASSERT_EQ(client.setPort(4431), true);
+    ASSERT_EQ(client.setTimeout(250), true);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.setNoDelay(true), true);
+    ASSERT_EQ(client.getNoDelay(), true);
+    ASSERT_EQ(getsockopt(client.getSocketFd(), IPPROTO_TCP, TCP_NODELAY, &value, &len), 0);
+    ASSERT_NE(value, 0);
+    ASSERT_EQ(client.setCork(true, 64, 0), true);
+    ASSERT_EQ(client.getCork(), true);
+    ASSERT_EQ(client.sendData(TEST_STR_1), 0);
+    ASSERT_EQ(client.sendData(TEST_STR_2), 0);
+    ASSERT_EQ(client.getCorkTimeLeft(), -1);
+    ASSERT_EQ(client.flush(), 0);
+    ASSERT_EQ(client.receiveNBytes(strlen(TEST_STR_1) + strlen(TEST_STR_2)), 0);
+    ASSERT_EQ(memcmp(client.getBufferAsVector().data(), (std::string(TEST_STR_1) + TEST_STR_2).c_str(), strlen(TEST_STR_1) + strlen(TEST_STR_2)), 0);
+    /* a receive operation that waits for the peer writes the cork buffer first, so the request is not held back until the deadline */
+    ASSERT_EQ(client.sendData(TEST_STR_2), 0);
+    ASSERT_EQ(client.sendData(TEST_STR_1), 0);
+    ASSERT_EQ(client.receiveNBytes(strlen(TEST_STR_2) + strlen(TEST_STR_1)), 0);
+    ASSERT_EQ(memcmp(client.getBufferAsVector().data(), (std::string(TEST_STR_2) + TEST_STR_1).c_str(), strlen(TEST_STR_2) + strlen(TEST_STR_1)), 0);
+    /* reaching the flush size writes the cork buffer automatically */
+    ASSERT_EQ(client.sendData((const unsigned char *) TEST_STR_3, 64), 0);
+    ASSERT_EQ(client.receiveNBytes(64), 0);
+    ASSERT_EQ(client.getCorkTimeLeft(), -1);
+    /* with a deadline, the time left tells when the cork buffer has to be flushed */
+    ASSERT_EQ(client.setCork(true, 64, 100), true);
+    ASSERT_EQ(client.sendData(TEST_STR_1), 0);
+    ASSERT_GT(client.getCorkTimeLeft(), 50);
+    ASSERT_LE(client.getCorkTimeLeft(), 100);
+    ASSERT_EQ(client.setCork(false), true);
+    ASSERT_EQ(client.getCork(), false);
+    ASSERT_EQ(client.getCorkTimeLeft(), -1);
+    ASSERT_EQ(client.receiveNBytes(strlen(TEST_STR_1)), 0);
+}
+
+void sendFileProgress(Socket &, size_t sent, size_t total, void *param){
+    size_t *progress = (size_t *) param;
+    if (sent > progress[0] && sent <= total){
+        progress[0] = sent;
+        progress[1]++;
+    }
+}
+
+TEST_F(TCPSimpleTest, communicationTest_sendFile) {
+    char path[] = "/tmp/synaptcp-send-file-XXXXXX";
+    std::vector <unsigned char> content(2621440);
+    std::vector <unsigned char> received;
+    size_t progress[2] = {0, 0};
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    for (size_t i = 0; i < content.size(); i++){
+        content[i] = (unsigned char) TEST_STR_3[i % strlen(TEST_STR_3)];
+    }
+    ASSERT_EQ(write(fd, content.data(), content.size()), (ssize_t) content.size());
+    ASSERT_EQ(client.setPort(4431), true);
+    ASSERT_EQ(client.setTimeout(250), true);
+    ASSERT_EQ(client.sendFile(fd, 0, 0), 1);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.sendFile(fd, content.size() + 1, 0), 3);
+    ASSERT_EQ(client.sendFile(fd, 16, content.size()), 3);
+    ASSERT_EQ(client.sendFile(std::string(path) + ".missing", 0, 0), 3);
+    ASSERT_EQ(client.sendFile(fd, 0, 0, &sendFileProgress, (void *) progress), 0);
+    ASSERT_EQ(progress[0], content.size());
+    ASSERT_GE(progress[1], 3);
+    ASSERT_EQ(client.receiveNBytes(content.size()), 0);
+    ASSERT_EQ(client.getBufferAsVector() == content, true);
+    ASSERT_EQ(client.sendFile(std::string(path), 77, 385), 0);
+    ASSERT_EQ(client.receiveNBytes(385), 0);
+    received = client.getBufferAsVector();
+    ASSERT_EQ(memcmp(received.data(), content.data() + 77, 385), 0);
+    close(fd);
+    unlink(path);
+}
+
+TEST_F(TCPSimpleTest, communicationTest_zeroCopySend) {
+    std::shared_ptr <std::vector <unsigned char>> payload = std::make_shared <std::vector <unsigned char>>(65536);
+    std::weak_ptr <std::vector <unsigned char>> observer = payload;
+    std::vector <unsigned char> received;
+    int tryTimes = 0;
+    for (size_t i = 0; i < payload->size(); i++){
+        (*payload)[i] = (unsigned char) TEST_STR_3[i % strlen(TEST_STR_3)];
+    }
+    ASSERT_EQ(client.setPort(4431), true);
+    ASSERT_EQ(client.setTimeout(250), true);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.setZeroCopy(true, 16384), true);
+    ASSERT_EQ(client.getZeroCopy(), true);
+    /* small buffers keep the copy path */
+    ASSERT_EQ(client.sendData(std::make_shared <const std::vector <unsigned char>>(TEST_STR_1, TEST_STR_1 + strlen(TEST_STR_1))), 0);
+    ASSERT_EQ(client.getZeroCopyPendingSize(), 0);
+    ASSERT_EQ(client.receiveNBytes(strlen(TEST_STR_1)), 0);
+    ASSERT_EQ(client.sendData(std::shared_ptr <const std::vector <unsigned char>>(payload)), 0);
+    received = *payload;
+    payload.reset();
+    ASSERT_EQ(client.receiveNBytes(received.size()), 0);
+    ASSERT_EQ(client.getBufferAsVector() == received, true);
+    while (client.getZeroCopyPendingSize() > 0 && tryTimes < 100){
+        client.processZeroCopyCompletions();
+        usleep(10000);
+        tryTimes++;
+    }
+    ASSERT_EQ(client.getZeroCopyPendingSize(), 0);
+    ASSERT_EQ(observer.expired(), true);
+}
+
+void writeWatermarkCounter(Socket &, void *param){
+    (*((int *) param))++;
+}
+
+TEST_F(TCPSimpleTest, communicationTest_writeWatermarks) {
+    std::vector <unsigned char> payload(32 * 1024 * 1024, 0x5a);
+    int blockedCount = 0;
+    int drainedCount = 0;
+    int queuedCount = 0;
+    size_t received = 0;
+    int tryTimes = 0;
+    ASSERT_EQ(client.setPort(4431), true);
+    ASSERT_EQ(client.setTimeout(250), true);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.setNonBlockingSend(true), true);
+    ASSERT_EQ(client.setWriteWatermarks(1024 * 1024, 1024), false);
+    ASSERT_EQ(client.setWriteWatermarks(64 * 1024, 1024 * 1024), true);
+    ASSERT_EQ(client.getWriteLowWatermark(), 64 * 1024);
+    ASSERT_EQ(client.getWriteHighWatermark(), 1024 * 1024);
+    client.setWriteBlockedHandler(&writeWatermarkCounter, &blockedCount);
+    client.setWriteDrainedHandler(&writeWatermarkCounter, &drainedCount);
+    client.setOutputQueuedHandler(&writeWatermarkCounter, &queuedCount);
+    ASSERT_EQ(client.sendData(payload.data(), payload.size()), 0);
+    ASSERT_GE(client.getOutputQueueSize(), 1024 * 1024);
+    ASSERT_EQ(client.getIsWriteBlocked(), true);
+    ASSERT_EQ(blockedCount, 1);
+    ASSERT_EQ(drainedCount, 0);
+    /* only queuing data in the empty output queue calls the output queued handler */
+    ASSERT_EQ(queuedCount, 1);
+    ASSERT_EQ(client.sendData(payload.data(), 16), 0);
+    ASSERT_EQ(queuedCount, 1);
+    while (received < payload.size() + 16 && tryTimes < 1000){
+        client.flushOutputQueue();
+        if (client.receiveData() == 0){
+            received += client.getDataSize();
+            tryTimes = 0;
+        }
+        else {
+            tryTimes++;
+        }
+    }
+    ASSERT_EQ(received, payload.size() + 16);
+    ASSERT_EQ(client.getIsWriteBlocked(), false);
+    ASSERT_EQ(blockedCount, 1);
+    ASSERT_EQ(drainedCount, 1);
+}
+
+TEST_F(TCPSimpleTest, communicationTest_sendData_moveAndStringView) {
+    std::vector <unsigned char> payload(8 * 1024 * 1024, 0x5a);
+    std::string stopBytes = "1234\n";
+    size_t received = 0;
+    int tryTimes = 0;
+    ASSERT_EQ(client.setPort(4431), true);
+    ASSERT_EQ(client.setTimeout(250), true);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.sendData(std::string_view(TEST_STR_3)), 0);
+    ASSERT_EQ(client.receiveUntillStopBytes(stopBytes), 0);
+    ASSERT_EQ(client.getBufferAsVector(), std::vector <unsigned char>(TEST_STR_3, TEST_STR_3 + strlen(TEST_STR_3)));
+    ASSERT_EQ(client.setNonBlockingSend(true), true);
+    ASSERT_EQ(client.sendData(std::move(payload)), 0);
+    /* the unsent part has been moved into the output queue */
+    ASSERT_GT(client.getOutputQueueSize(), 0);
+    ASSERT_EQ(payload.size(), 0);
+    while (received < 8 * 1024 * 1024 && tryTimes < 1000){
+        client.flushOutputQueue();
+        if (client.receiveData() == 0){
+            received += client.getDataSize();
+            tryTimes = 0;
+        }
+        else {
+            tryTimes++;
+        }
+    }
+    ASSERT_EQ(client.getOutputQueueSize(), 0);
+    ASSERT_EQ(received, 8 * 1024 * 1024);
+}
@@ -805,4 +805,23 @@ TEST_F(SSLSimpleTest, negativeCommunicationTest_rcvStopBytes) {
     tmp.clear();
     tmp = client.getRemainingBufferAsVector();
     ASSERT_EQ(tmp.size(), 0);
-}
\ No newline at end of file
+}
+
+TEST_F(SSLSimpleTest, communicationTest_sendFile) {
+    char path[] = "/tmp/synaptcp-send-file-XXXXXX";
+    std::vector <unsigned char> content(1800);
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    for (size_t i = 0; i < content.size(); i++){
+        content[i] = (unsigned char) TEST_STR_3[i % strlen(TEST_STR_3)];
+    }
+    ASSERT_EQ(write(fd, content.data(), content.size()), (ssize_t) content.size());
+    ASSERT_EQ(client.setPort(4431), true);
+    ASSERT_EQ(client.setTimeout(250), true);
+    ASSERT_EQ(client.init(), 0);
+    ASSERT_EQ(client.sendFile(std::string(path), 0, 0), 0);
+    ASSERT_EQ(client.receiveNBytes(content.size()), 0);
+    ASSERT_EQ(client.getBufferAsVector() == content, true);
+    close(fd);
+    unlink(path);
+}